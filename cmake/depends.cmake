@@ -27,6 +27,9 @@ if(NOT PUGIXML_VERSION)
 	message(FATAL_ERROR "Please install pugixml")
 endif()
 
+# threads (movie frame decoding)
+find_package(Threads REQUIRED)
+
 
 # --- Bundled Dependencies --- #
 
@@ -93,6 +96,7 @@ if(NOT STATIC)
 		${SDL2IMAGE_LIBRARIES}
 		${SDL2TTF_LIBRARIES}
 		${PUGIXML_LIBRARIES}
+		Threads::Threads
 	)
 	if(SYSTEM_TMXLITE)
 		list(APPEND LINK_LIBRARIES ${TMXLITE_LIBRARIES})
@@ -104,6 +108,7 @@ else()
 		${SDL2IMAGE_STATIC_LIBRARIES}
 		${SDL2TTF_STATIC_LIBRARIES}
 		${PUGIXML_STATIC_LIBRARIES}
+		Threads::Threads
 	)
 	if(SYSTEM_TMXLITE)
 		list(APPEND LINK_LIBRARIES ${TMXLITE_STATIC_LIBRARIES})
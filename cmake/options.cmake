@@ -10,8 +10,46 @@ else()
 	set(RRE_DEBUGGING false)
 endif()
 
+# most verbose log level compiled in, more verbose messages are removed at build time
+set(LOG_LEVEL "" CACHE STRING "Most verbose log level compiled in: silent, error, warn, info or debug (default: debug for Debug builds, info otherwise).")
+if(NOT LOG_LEVEL)
+	if(RRE_DEBUGGING)
+		set(LOG_LEVEL "debug")
+	else()
+		set(LOG_LEVEL "info")
+	endif()
+endif()
+# index matches `LogLevel` enumeration
+set(LOG_LEVELS silent error warn info debug)
+string(TOLOWER "${LOG_LEVEL}" LOG_LEVEL)
+list(FIND LOG_LEVELS "${LOG_LEVEL}" RRE_LOG_LEVEL_MAX)
+if(RRE_LOG_LEVEL_MAX LESS 0)
+	message(FATAL_ERROR "Invalid LOG_LEVEL: ${LOG_LEVEL}")
+endif()
+
 option(EXAMPLE "Include example game data." OFF)
 option(STATIC "Link executable statically." OFF)
+option(SCENEC "Build scene compiler (rre-scenec)." ON)
+option(PACK "Build data archive packer (rre-pack)." ON)
+option(HOT_RELOAD "Support reloading changed game data while running (Linux only)." ON)
+option(ALLOC_TRACKING "Count heap allocations per frame & trace zone (replaces global operator new)." OFF)
+
+# file watching uses inotify
+if(HOT_RELOAD AND CMAKE_SYSTEM_NAME STREQUAL "Linux")
+	set(HAVE_HOT_RELOAD true)
+else()
+	set(HAVE_HOT_RELOAD false)
+endif()
+
+if(ALLOC_TRACKING)
+	set(HAVE_ALLOC_TRACKING true)
+else()
+	set(HAVE_ALLOC_TRACKING false)
+endif()
+
+# audio thread CPU time used to measure mixer cost
+include(CheckSymbolExists)
+check_symbol_exists(CLOCK_THREAD_CPUTIME_ID "time.h" HAVE_THREAD_CPUTIME)
 
 # bin2header executable
 find_program(BIN2HEADER bin2header)
@@ -0,0 +1,125 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_ALLOC_STATS
+#define RRE_ALLOC_STATS
+
+#include "config.h"
+
+#include <cstdint> // *int*_t
+
+
+/**
+ * Heap allocations made by a thread.
+ */
+struct AllocCount {
+	/** Number of allocations. */
+	uint64_t count = 0;
+	/** Bytes requested. */
+	uint64_t bytes = 0;
+};
+
+/**
+ * Counts heap allocations when built with `ALLOC_TRACKING`.
+ *
+ * Global `operator new` is replaced to count allocations of each thread. Counts of main thread are
+ * taken per frame & per trace zone, & sections marked with `NoAllocScope` report allocations once
+ * the game has been running steadily for `WARMUP` frames. Without `ALLOC_TRACKING` all counts are
+ * zero & checks are compiled out.
+ */
+namespace AllocStats {
+	/** Frames after loading or mode change before sections are checked. */
+	static const uint32_t WARMUP = 120;
+
+#if HAVE_ALLOC_TRACKING
+	/**
+	 * Retrieves allocations made by calling thread since it started.
+	 */
+	AllocCount get();
+#else
+	inline AllocCount get() { return {}; }
+#endif
+
+	/**
+	 * Retrieves allocations made by calling thread since an earlier count.
+	 *
+	 * @param start
+	 *   Count from `AllocStats::get`.
+	 */
+	inline AllocCount since(const AllocCount& start) {
+		AllocCount now = AllocStats::get();
+		return {now.count - start.count, now.bytes - start.bytes};
+	}
+
+	/** Marks end of a frame on main thread. */
+	void endFrame();
+
+	/**
+	 * Retrieves allocations made by main thread in most recent frame.
+	 */
+	AllocCount getFrame();
+
+	/** Restarts warmup, e.g. while data is loading or mode changes. */
+	void resetWarmup();
+
+	/**
+	 * Checks if warmup has passed so that allocating sections are reported.
+	 */
+	bool steady();
+
+	/**
+	 * Sets whether allocating sections abort instead of logging an error.
+	 *
+	 * @param strict
+	 *   `true` to abort.
+	 */
+	void setStrict(bool strict);
+
+	/**
+	 * Reports a section that allocated after warmup.
+	 *
+	 * Each section is logged once unless strict, in which case process is aborted.
+	 *
+	 * @param name
+	 *   Section name.
+	 * @param count
+	 *   Allocations made in section.
+	 */
+	void onViolation(const char* name, const AllocCount& count);
+};
+
+
+/**
+ * Marks a scope that must not allocate once game is running steadily.
+ */
+class NoAllocScope {
+private:
+	const char* name;
+	AllocCount start;
+
+public:
+	/**
+	 * Starts a checked section.
+	 *
+	 * @param name
+	 *   Section name (must remain valid, normally a literal).
+	 */
+	NoAllocScope(const char* name): name(name), start(AllocStats::get()) {}
+
+	~NoAllocScope() {
+#if HAVE_ALLOC_TRACKING
+		AllocCount count = AllocStats::since(start);
+		if (count.count > 0 && AllocStats::steady()) {
+			AllocStats::onViolation(name, count);
+		}
+#endif
+	}
+
+	NoAllocScope(const NoAllocScope&) = delete;
+	NoAllocScope& operator=(const NoAllocScope&) = delete;
+};
+
+#endif /* RRE_ALLOC_STATS */
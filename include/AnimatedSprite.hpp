@@ -24,7 +24,7 @@
  */
 class AnimatedSprite: public Sprite {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	/** Available animation modes of this sprite. */
 	std::unordered_map<std::string, Animation> modes;
@@ -88,7 +88,7 @@ public:
 	 * @param id
 	 *   Mode identifier. If `id` isn't configured, an uninitialized animation definition is used.
 	 */
-	void setMode(std::string id) override;
+	void setMode(const std::string& id) override;
 
 	/**
 	 * Retrieves ID of current mode.
@@ -96,13 +96,23 @@ public:
 	 * @return
 	 *   Mode identifier.
 	 */
-	std::string getModeId() override {
+	const std::string& getModeId() override {
 		if (current_mode) {
 			return current_mode->getId();
 		}
 		return Sprite::getModeId();
 	}
 
+	/**
+	 * Exchanges texture, tile data & animation modes with another sprite.
+	 *
+	 * Current animation mode is kept if still defined.
+	 *
+	 * @param other
+	 *   Animated sprite.
+	 */
+	void swap(Sprite& other) override;
+
 	/**
 	 * Sets ID of default animation mode.
 	 *
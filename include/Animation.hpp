@@ -88,7 +88,7 @@ public:
 	 * @return
 	 *   Animation identifier.
 	 */
-	std::string getId() { return id; }
+	const std::string& getId() const { return id; }
 
 	/**
 	 * Checks if animation is ready.
@@ -0,0 +1,91 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_ARCHIVE
+#define RRE_ARCHIVE
+
+#include <cstdint> // *int*_t
+#include <string>
+
+
+/**
+ * Packed game data archive format.
+ *
+ * Archives are generated from the data directory by `rre-pack` & mounted in place of it by the
+ * virtual filesystem (see `Vfs`). All offsets are relative to start of archive.
+ *
+ * Layout:
+ * - header
+ * - entry data (8 byte aligned)
+ * - entry index (sorted by name)
+ * - name table (not null-terminated)
+ *
+ * Entry names are paths relative to data directory using `/` as node delimiter.
+ *
+ * NOTE: archives use native byte order & are not portable between architectures
+ */
+namespace Archive {
+	/** Archive file identifier. */
+	const char MAGIC[4] = {'R', 'R', 'P', 'K'};
+	/** Format version. */
+	const uint32_t VERSION = 1;
+	/** Marker used to detect byte order mismatch. */
+	const uint32_t ENDIAN_MARKER = 0x01020304;
+
+	/** Entry flags. */
+	enum EntryFlag: uint32_t {
+		/** Entry data is LZ4 block compressed. */
+		LZ4 = 1 << 0
+	};
+
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t byte_order;
+		uint32_t entry_count;
+		uint64_t entries_offset;
+		uint64_t names_offset;
+		uint64_t names_size;
+	};
+
+	struct Entry {
+		/** Offset into name table. */
+		uint32_t name;
+		uint32_t name_length;
+		uint32_t flags;
+		uint32_t reserved;
+		/** Offset of stored data. */
+		uint64_t offset;
+		/** Stored byte count. */
+		uint64_t size;
+		/** Uncompressed byte count. */
+		uint64_t raw_size;
+		/** Modification time of source file when packed. */
+		int64_t mtime;
+	};
+
+	/**
+	 * Packs a directory into an archive.
+	 *
+	 * Files are only compressed when it reduces their size noticeably. Precompiled scene blobs are
+	 * always stored uncompressed so they can be referenced in place.
+	 *
+	 * @param dir
+	 *   Path to directory to pack.
+	 * @param archive_path
+	 *   Path to output archive.
+	 * @param compress
+	 *   If `false`, no entries are compressed.
+	 * @param error
+	 *   Set to error message on failure.
+	 * @return
+	 *   `true` if archive was written.
+	 */
+	bool pack(const std::string& dir, const std::string& archive_path, bool compress,
+			std::string& error);
+};
+
+#endif /* RRE_ARCHIVE */
@@ -0,0 +1,77 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_AUDIO_STATS
+#define RRE_AUDIO_STATS
+
+#include <cstdint> // *int*_t
+#include <ostream>
+#include <string>
+
+
+/**
+ * Mixer measurements.
+ */
+struct AudioStatsSnapshot {
+	/** Output sample rate. */
+	uint32_t rate;
+	/** Sample frames mixed per callback. */
+	uint32_t frames;
+	/** Number of mixer callbacks. */
+	uint64_t callbacks;
+	/** Mean CPU time of mixer callback in microseconds (0 if not supported). */
+	uint32_t mix_mean;
+	/** Longest CPU time of mixer callback in microseconds since measuring started. */
+	uint32_t mix_max;
+	/** Percentage of buffer duration spent mixing. */
+	float load;
+	/** Number of callbacks that arrived too late to refill device buffer in time. */
+	uint64_t underruns;
+	/** Duration of audio buffered by mixer in milliseconds. */
+	float latency;
+};
+
+/**
+ * Measures mixer performance from audio thread.
+ *
+ * A post-mix hook runs at the end of each mixer callback:
+ * - CPU time of audio thread between callbacks measures mixing cost (platforms supporting thread
+ *   CPU clocks)
+ * - callbacks arriving more than half a buffer late are counted as underruns
+ * - effective latency is derived from size of buffers actually requested by audio device
+ */
+namespace AudioStats {
+
+	/**
+	 * Starts measuring.
+	 *
+	 * Must be called after audio device is opened.
+	 */
+	void start();
+
+	/** Stops measuring. */
+	void stop();
+
+	/**
+	 * Retrieves current measurements.
+	 */
+	AudioStatsSnapshot getSnapshot();
+
+	/**
+	 * Formats current measurements for debug overlay.
+	 */
+	std::string getSummary();
+
+	/**
+	 * Writes current measurements as JSON.
+	 *
+	 * @param out
+	 *   Output stream.
+	 */
+	void writeJson(std::ostream& out);
+};
+
+#endif /* RRE_AUDIO_STATS */
@@ -21,7 +21,7 @@
  */
 class Character: public Entity {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 protected:
 	/** Visual representation of entity's current energy level. */
@@ -0,0 +1,296 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_CONFIG_DOCUMENT
+#define RRE_CONFIG_DOCUMENT
+
+#include <cstddef> // size_t
+#include <cstdint> // *int*_t
+#include <memory> // std::shared_ptr
+#include <span>
+#include <string>
+
+
+class ConfigDocument;
+
+
+/**
+ * Attribute of a configuration element.
+ */
+class ConfigAttribute {
+private:
+	const char* val;
+
+public:
+	/** Default constructor for missing attribute. */
+	ConfigAttribute(): val(nullptr) {}
+
+	/**
+	 * Creates an attribute.
+	 *
+	 * @param value
+	 *   Null-terminated attribute value.
+	 */
+	ConfigAttribute(const char* value): val(value) {}
+
+	/**
+	 * Checks if attribute is missing.
+	 */
+	bool empty() const { return val == nullptr; }
+
+	/**
+	 * Retrieves attribute value.
+	 *
+	 * @return
+	 *   Value or empty string if attribute is missing.
+	 */
+	const char* value() const { return val != nullptr ? val : ""; }
+
+	/**
+	 * Retrieves attribute value as unsigned integer.
+	 *
+	 * @param def
+	 *   Value returned if attribute is missing or cannot be parsed.
+	 */
+	uint32_t asUInt(uint32_t def=0) const;
+};
+
+
+/**
+ * Element of a configuration document.
+ *
+ * Nodes are lightweight views & only valid while document is alive.
+ */
+class ConfigNode {
+private:
+	const ConfigDocument* doc;
+	uint32_t index;
+
+public:
+	/** Default constructor for missing element. */
+	ConfigNode();
+
+	/**
+	 * Creates a view of an element.
+	 *
+	 * @param doc
+	 *   Document containing element.
+	 * @param index
+	 *   Element record index.
+	 */
+	ConfigNode(const ConfigDocument* doc, uint32_t index): doc(doc), index(index) {}
+
+	/**
+	 * Checks if element is missing.
+	 */
+	bool empty() const;
+
+	/**
+	 * Retrieves element tag name.
+	 */
+	const char* name() const;
+
+	/**
+	 * Retrieves first text contained by element.
+	 *
+	 * @return
+	 *   Text or empty string.
+	 */
+	const char* text() const;
+
+	/**
+	 * Finds first child element with tag name.
+	 *
+	 * @param name
+	 *   Tag name.
+	 * @return
+	 *   Child element or empty node if not found.
+	 */
+	ConfigNode child(const char* name) const;
+
+	/**
+	 * Finds next sibling element with tag name.
+	 *
+	 * @param name
+	 *   Tag name.
+	 * @return
+	 *   Sibling element or empty node if not found.
+	 */
+	ConfigNode nextSibling(const char* name) const;
+
+	/**
+	 * Finds attribute of element.
+	 *
+	 * @param name
+	 *   Attribute name.
+	 * @return
+	 *   Attribute (empty if not found).
+	 */
+	ConfigAttribute attribute(const char* name) const;
+
+	/**
+	 * Calculates hash of element contents.
+	 *
+	 * Includes tag name, text, attributes & descendants. Used to detect changed definitions.
+	 *
+	 * @return
+	 *   FNV-1a hash.
+	 */
+	uint64_t hash() const;
+};
+
+
+/**
+ * Compact read-only representation of an XML configuration file.
+ *
+ * Configurations are parsed in a single streaming pass directly into flat element, attribute &
+ * string tables without building a DOM. The tables are cached in `cache/<path>.bin` in executable
+ * directory & mapped in place on subsequent loads while source file modification time & size are
+ * unchanged. If only modification time changed, cache is reused when contents hash matches.
+ *
+ * Supported XML: elements, attributes, text, CDATA, comments & predefined/numeric entities.
+ * Declarations & processing instructions are skipped. Only first text of an element is kept.
+ *
+ * Cache layout:
+ * - header
+ * - element records (index 0 is document root)
+ * - attribute records
+ * - string table (null-terminated strings, offset 0 is empty string)
+ *
+ * NOTE: cache files use native byte order & are not portable between architectures
+ */
+class ConfigDocument {
+public:
+	/** Cache file identifier. */
+	static constexpr char MAGIC[4] = {'R', 'R', 'C', 'C'};
+	/** Cache format version. Caches of other versions are rebuilt. */
+	static constexpr uint32_t VERSION = 1;
+	/** Marker used to detect byte order mismatch. */
+	static constexpr uint32_t ENDIAN_MARKER = 0x01020304;
+	/** Record index representing no element. */
+	static constexpr uint32_t NONE = UINT32_MAX;
+
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t byte_order;
+		uint32_t element_count;
+		/** Modification time of source file when parsed. */
+		int64_t source_mtime;
+		/** Size of source file when parsed. */
+		uint64_t source_size;
+		/** FNV-1a hash of source file contents. */
+		uint64_t source_hash;
+		uint32_t attribute_count;
+		uint32_t strings_size;
+	};
+
+	struct ElementRecord {
+		uint32_t name;
+		uint32_t text;
+		uint32_t first_child;
+		uint32_t next_sibling;
+		uint32_t first_attribute;
+		uint32_t attribute_count;
+	};
+
+	struct AttributeRecord {
+		uint32_t name;
+		uint32_t value;
+	};
+
+private:
+	friend class ConfigNode;
+
+	/** Keeps tables alive (cache mapping or parsed buffer). */
+	std::shared_ptr<const void> owner;
+	const Header* header;
+	std::span<const ElementRecord> elements;
+	std::span<const AttributeRecord> attributes;
+	const char* strings;
+
+	/**
+	 * Uses tables from memory.
+	 *
+	 * @param owner
+	 *   Object keeping `data` alive.
+	 * @param data
+	 *   Start of tables (must be 8 byte aligned).
+	 * @param size
+	 *   Byte count of tables.
+	 * @param error
+	 *   Set to reason tables cannot be used on failure.
+	 * @return
+	 *   `true` if tables are valid.
+	 */
+	bool open(std::shared_ptr<const void> owner, const uint8_t* data, size_t size,
+			std::string& error);
+
+	/**
+	 * Parses XML into tables.
+	 *
+	 * @param data
+	 *   XML text.
+	 * @param size
+	 *   Byte count of `data`.
+	 * @param mtime
+	 *   Source modification time stored in header.
+	 * @param hash
+	 *   Source hash stored in header.
+	 * @param error
+	 *   Set to error message on failure.
+	 * @return
+	 *   `true` if parsing succeeded.
+	 */
+	bool build(const char* data, size_t size, int64_t mtime, uint64_t hash, std::string& error);
+
+public:
+	/** Default constructor. */
+	ConfigDocument(): header(nullptr), strings(nullptr) {}
+
+	/**
+	 * Parses XML from memory without caching.
+	 *
+	 * @param data
+	 *   XML text.
+	 * @param size
+	 *   Byte count of `data`.
+	 * @param error
+	 *   Set to error message on failure.
+	 * @return
+	 *   `true` if parsing succeeded.
+	 */
+	bool parse(const char* data, size_t size, std::string& error);
+
+	/**
+	 * Loads a configuration file using cache when up to date.
+	 *
+	 * @param vpath
+	 *   Path to configuration relative to data directory.
+	 * @param error
+	 *   Set to error message on failure.
+	 * @return
+	 *   `true` if configuration was loaded.
+	 */
+	bool load(const std::string& vpath, std::string& error);
+
+	/**
+	 * Retrieves document root containing top-level element.
+	 */
+	ConfigNode root() const { return header != nullptr ? ConfigNode(this, 0) : ConfigNode(); }
+
+	/**
+	 * Finds top-level element.
+	 *
+	 * @param name
+	 *   Tag name.
+	 * @return
+	 *   Element or empty node if not found.
+	 */
+	ConfigNode child(const char* name) const { return root().child(name); }
+};
+
+#endif /* RRE_CONFIG_DOCUMENT */
@@ -7,19 +7,88 @@
 #ifndef RRE_DATA_LOADER
 #define RRE_DATA_LOADER
 
+#include <cstdint> // *int*_t
+#include <functional>
+#include <string>
+
 
 /**
  * Wrapper for loading game data.
+ *
+ * Data required to draw first frame is loaded immediately. Remaining data is queued by priority
+ * & loaded one task at a time from game loop while intro plays. Tasks not using renderer, e.g.
+ * decoding sounds & parsing configuration, run on a worker thread so that game loop is not
+ * stalled. Tasks creating textures run on main thread within a time budget.
  */
 namespace DataLoader {
 
+	/** Load priorities. Lower values are loaded first. */
+	enum Priority: uint8_t {
+		/** Data required by title screen. */
+		TITLE = 0,
+		/** Data required by scenes. */
+		SCENE,
+		/** Number of priorities. */
+		COUNT
+	};
+
+	/** Maximum time in milliseconds spent loading queued data per game loop iteration. */
+	const uint32_t STEP_BUDGET = 8;
+
 	/**
-	 * Loads all game data.
+	 * Loads data required for first frame & queues remaining game data.
 	 *
 	 * @return
-	 *   `true` if data loaded successfuly.
+	 *   `true` if critical data loaded successfuly.
 	 */
 	bool load();
+
+	/**
+	 * Adds a task to load queue.
+	 *
+	 * Tasks of same priority are loaded in order added.
+	 *
+	 * @param priority
+	 *   Load priority.
+	 * @param name
+	 *   Name used in log messages.
+	 * @param task
+	 *   Function loading data & returning `false` on failure.
+	 * @param background
+	 *   If `true`, task runs on a worker thread & must not use renderer. Data it loads must not be
+	 *   accessed until queued data is ready.
+	 */
+	void queue(Priority priority, std::string name, std::function<bool()> task,
+			bool background=false);
+
+	/**
+	 * Loads queued data until time budget is used.
+	 *
+	 * At least one main thread task is loaded per call unless a background task is running, in
+	 * which case call returns without waiting.
+	 *
+	 * @param budget
+	 *   Time in milliseconds.
+	 * @return
+	 *   `true` if all data is loaded.
+	 */
+	bool step(uint32_t budget=STEP_BUDGET);
+
+	/**
+	 * Loads all queued data up to a priority immediately, waiting for background tasks.
+	 *
+	 * @param priority
+	 *   Highest priority value to load.
+	 */
+	void finish(Priority priority=SCENE);
+
+	/**
+	 * Checks if queued data up to a priority has been loaded.
+	 *
+	 * @param priority
+	 *   Highest priority value to check.
+	 */
+	bool ready(Priority priority=SCENE);
 };
 
 #endif /* RRE_DATA_LOADER */
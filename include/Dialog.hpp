@@ -12,6 +12,8 @@
 
 /**
  * Wrapper for displaying notification dialogs.
+ *
+ * Dialogs requested by threads other than main thread are held until `showPending` is called.
  */
 namespace Dialog {
 
@@ -60,6 +62,13 @@ namespace Dialog {
 	 *   Window contents text.
 	 */
 	void error(std::string msg);
+
+	/**
+	 * Displays dialogs requested by other threads.
+	 *
+	 * Must be called from main thread.
+	 */
+	void showPending();
 }
 
 #endif /* RRE_DIALOG */
@@ -20,7 +20,7 @@
  */
 class EnergyBar {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	/**
 	 * Maximum number of energy lines that can be drawn.
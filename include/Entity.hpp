@@ -26,7 +26,7 @@
  */
 class Entity: public Object {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 protected:
 	/** Image drawn on viewport. */
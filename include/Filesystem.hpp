@@ -7,8 +7,10 @@
 #ifndef RRE_FILESYSTEM
 #define RRE_FILESYSTEM
 
+#include <cstdint> // int64_t
 #include <filesystem>
 #include <string>
+#include <system_error> // std::error_code
 #include <vector>
 
 #ifdef __WIN32__
@@ -26,7 +28,7 @@ namespace Filesystem {
 
 	/** Checks for existing file.
 	 *
-	 * TODO: _maybe_ replace with calls to `std::filesystem::is_regular_file`
+	 * Only queries file status, file is not opened.
 	 *
 	 * @param path
 	 *   String path to file.
@@ -37,6 +39,20 @@ namespace Filesystem {
 	 */
 	bool fexist(const std::string path);
 
+	/**
+	 * Retrieves modification time of a file.
+	 *
+	 * @param path
+	 *   String path to file.
+	 * @param ec
+	 *   Set on failure.
+	 * @return
+	 *   Time in file clock ticks (only useful for comparison).
+	 */
+	static inline int64_t getMTime(const std::string& path, std::error_code& ec) {
+		return static_cast<int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+	}
+
 	/**
 	 * Creates a new directory tree in the filesystem.
 	 *
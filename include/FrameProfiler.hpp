@@ -0,0 +1,183 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_FRAME_PROFILER
+#define RRE_FRAME_PROFILER
+
+#include <cstdint> // *int*_t
+#include <string>
+
+#include "Trace.hpp"
+
+
+/**
+ * Measures time spent in stages of each presented frame.
+ *
+ * A frame covers all game loop iterations since previous present. Stage times are accumulated
+ * by `FrameScope` & stored for most recent `HISTORY` frames when frame is ended. Some stages are
+ * nested (e.g. `STEP` includes `INPUT` & `LOGIC`).
+ */
+namespace FrameProfiler {
+	/** Measured stages. */
+	enum Stage: uint8_t {
+		/** Polling & dispatching SDL events. */
+		EVENTS,
+		/** Applying queued input at start of logic step. */
+		INPUT,
+		/** Game logic step. */
+		STEP,
+		/** Scene logic (within step). */
+		LOGIC,
+		/** Scene parallax backgrounds. */
+		PARALLAX,
+		/** Scene background tile layer. */
+		BACKGROUND,
+		/** Scene terrain tile layer. */
+		TERRAIN,
+		/** Scene collision tile layer. */
+		COLLISION,
+		/** Scene objects & player. */
+		OBJECTS,
+		/** Scene foreground tile layer. */
+		FOREGROUND,
+		/** Scene weather effect. */
+		WEATHER,
+		/** Viewport text & overlays. */
+		HUD,
+		/** Viewport fade effect. */
+		FADE,
+		/** Presenting rendered frame. */
+		PRESENT,
+		/** Number of stages. */
+		COUNT
+	};
+
+	/** Number of frames kept for averages, percentiles & graph. */
+	const uint32_t HISTORY = 120;
+
+	/** Rolling statistics of a stage in microseconds. */
+	struct StageStats {
+		uint32_t avg;
+		uint32_t p50;
+		uint32_t p95;
+		uint32_t max;
+	};
+
+	/**
+	 * Retrieves stage name as used in CSV header.
+	 */
+	const char* getName(Stage stage);
+
+	/**
+	 * Adds time to a stage of current frame.
+	 *
+	 * @param stage
+	 *   Measured stage.
+	 * @param time
+	 *   Time in nanoseconds.
+	 */
+	void add(Stage stage, uint64_t time);
+
+	/**
+	 * Ends current frame.
+	 *
+	 * Called after frame is presented.
+	 */
+	void endFrame();
+
+	/**
+	 * Retrieves number of frames ended.
+	 */
+	uint64_t getFrameCount();
+
+	/**
+	 * Retrieves time of a stage in a recent frame.
+	 *
+	 * @param stage
+	 *   Measured stage.
+	 * @param age
+	 *   Number of frames before most recent (0 for most recent).
+	 * @return
+	 *   Time in microseconds.
+	 */
+	uint32_t getTime(Stage stage, uint32_t age);
+
+	/**
+	 * Retrieves time between two recent presents.
+	 *
+	 * @param age
+	 *   Number of frames before most recent (0 for most recent).
+	 * @return
+	 *   Time in microseconds.
+	 */
+	uint32_t getFrameTime(uint32_t age);
+
+	/**
+	 * Retrieves rolling statistics of a stage.
+	 *
+	 * @param stage
+	 *   Measured stage.
+	 */
+	StageStats getStats(Stage stage);
+
+	/**
+	 * Retrieves rolling statistics of time between presents.
+	 */
+	StageStats getFrameStats();
+
+	/** Shows or hides on-screen graph. */
+	void toggleGraph();
+
+	/**
+	 * Checks if on-screen graph is shown.
+	 */
+	bool graphVisible();
+
+	/**
+	 * Starts writing a row for each frame to a CSV file.
+	 *
+	 * @param path
+	 *   Output file path.
+	 * @return
+	 *   `true` if file was opened.
+	 */
+	bool startCsv(const std::string& path);
+
+	/** Finishes writing CSV file. */
+	void stopCsv();
+};
+
+
+/**
+ * Adds time spent in a scope to a frame stage & records it as a trace zone.
+ */
+class FrameScope {
+private:
+	FrameProfiler::Stage stage;
+	uint64_t start;
+	AllocCount allocs;
+
+public:
+	/**
+	 * Starts measuring a stage.
+	 *
+	 * @param stage
+	 *   Measured stage.
+	 */
+	FrameScope(FrameProfiler::Stage stage): stage(stage), start(Trace::now()),
+			allocs(AllocStats::get()) {}
+
+	~FrameScope() {
+		uint64_t end = Trace::now();
+		FrameProfiler::add(stage, end - start);
+		Trace::record(FrameProfiler::getName(stage), start, end, AllocStats::since(allocs));
+	}
+
+	FrameScope(const FrameScope&) = delete;
+	FrameScope& operator=(const FrameScope&) = delete;
+};
+
+#endif /* RRE_FRAME_PROFILER */
@@ -8,12 +8,25 @@
 #ifndef RRE_GAME_CONFIG
 #define RRE_GAME_CONFIG
 
+#include <cstddef> // size_t
 #include <cstdint> // *int*_t
 #include <string>
 
 #include "Movie.hpp"
 
 
+/**
+ * Audio device parameters.
+ */
+struct AudioSpec {
+	/** Output sample rate in Hz. */
+	uint32_t rate;
+	/** Sample frames mixed per callback (lower reduces latency, raises CPU use). */
+	uint16_t chunk;
+	/** Number of output channels (1 to 8). */
+	uint16_t channels;
+};
+
 /**
  * Namespace for loading & accessing game configuration from `data/conf/game.xml`.
  */
@@ -80,6 +93,54 @@ namespace GameConfig {
 	 *   Step delay in milliseconds.
 	 */
 	uint32_t getStepDelay();
+
+	/**
+	 * Retrieves configured memory budget for cached scenes.
+	 *
+	 * @return
+	 *   Budget in bytes.
+	 */
+	size_t getSceneCacheBudget();
+
+	/**
+	 * Retrieves number of chunks kept loaded beyond view in streamed scenes.
+	 *
+	 * @return
+	 *   Chunk count.
+	 */
+	uint32_t getStreamRadius();
+
+	/**
+	 * Retrieves how far ahead of player movement streamed chunks are loaded.
+	 *
+	 * @return
+	 *   Number of game logic steps.
+	 */
+	uint32_t getStreamPrefetch();
+
+	/**
+	 * Retrieves time to transition between music tracks.
+	 *
+	 * @return
+	 *   Time in milliseconds.
+	 */
+	uint32_t getMusicCrossfade();
+
+	/**
+	 * Retrieves audio device parameters.
+	 */
+	AudioSpec getAudioSpec();
+
+	/**
+	 * Overrides audio device parameters.
+	 *
+	 * Invalid values (zero rate or chunk size, channels outside 1 to 8) are logged & current value
+	 * is kept.
+	 *
+	 * @param spec
+	 *   Audio device parameters.
+	 */
+	void setAudioSpec(AudioSpec spec);
 };
 
 #endif /* RRE_GAME_CONFIG */
@@ -22,7 +22,7 @@
  */
 class GameLogic {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	/**
 	 * Delay (in milliseconds) for each step.
@@ -7,7 +7,7 @@
 #ifndef RRE_GAME_VISUALS
 #define RRE_GAME_VISUALS
 
-#include <memory> // std::unique_ptr, std::make_unique
+#include <memory> // std::unique_ptr, std::make_unique, std::shared_ptr
 #include <mutex>
 #include <string>
 
@@ -18,7 +18,7 @@
 class GameVisuals {
 private:
 	/** Logger instance for this class. */
-	static Logger logger;
+	static Logger& logger;
 
 	/** Static singleton instance. */
 	static std::unique_ptr<GameVisuals> instance;
@@ -29,20 +29,19 @@ private:
 	GameVisuals(const GameVisuals&) = delete;
 	GameVisuals& operator=(const GameVisuals&) = delete;
 
-	/** Scene rendered during `GameMode::SCENE`. */
-	SceneImpl* scene;
+	/** Scene rendered during `GameMode::SCENE` (shared with scene cache). */
+	std::shared_ptr<SceneImpl> scene;
 
 public:
 	/** Default constructor. */
-	GameVisuals() {
-		scene = nullptr;
-	}
+	GameVisuals() {}
 
 	/**
 	 * Default destructor.
 	 */
 	~GameVisuals() {
-		unsetScene();
+		// scene cache may already be destroyed at exit
+		scene.reset();
 	}
 
 	/**
@@ -78,7 +77,7 @@ public:
 	 * @return
 	 *   Active scene instance.
 	 */
-	SceneImpl* getScene() { return scene; }
+	SceneImpl* getScene() { return scene.get(); }
 
 	/** Renders current scene on viewport. */
 	void renderScene();
@@ -11,7 +11,6 @@
 #include <mutex>
 #include <string>
 
-#include <SDL2/SDL_mixer.h>
 #include <SDL2/SDL_video.h>
 
 #include "Logger.hpp"
@@ -31,7 +30,7 @@ struct WindowState {
 class GameWindow {
 private:
 	/** Logger instance. */
-	static Logger logger;
+	static Logger& logger;
 
 	/** Static singleton instance. */
 	static std::unique_ptr<GameWindow> instance;
@@ -54,9 +53,6 @@ private:
 	/** Renderer where images are drawn. */
 	ViewportImpl* viewport;
 
-	/** Active music. */
-	Mix_Music* music;
-
 	/** Game loop iterator flag. */
 	bool quit;
 
@@ -146,12 +142,14 @@ public:
 	/**
 	 * Sets music to play.
 	 *
+	 * Returns immediately, music is loaded in background & crossfaded with music currently playing.
+	 *
 	 * @param id
 	 *   Music identifier.
 	 */
 	void playMusic(std::string id);
 
-	/** Stops music currently playing. */
+	/** Fades out music currently playing. */
 	void stopMusic();
 
 	/**
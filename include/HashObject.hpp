@@ -20,7 +20,10 @@
  */
 class HashObject {
 private:
-	static Logger logger;
+	static Logger& logger;
+
+	/** Value of unset properties. */
+	static const std::string empty;
 
 	/** Hashed data. */
 	std::unordered_map<std::string, std::string> data;
@@ -97,7 +100,7 @@ public:
 	 * @return
 	 *   `true` if `key` index is found in properties table.
 	 */
-	bool has(std::string key) const {
+	bool has(const std::string& key) const {
 		return data.find(key) != data.end();
 	}
 
@@ -109,13 +112,13 @@ public:
 	 * @return
 	 *   String value or empty string if property not set.
 	 */
-	std::string get(std::string key) const {
+	const std::string& get(const std::string& key) const {
 		// use an iterator so data not modified using [] operator
 		auto iter = data.find(key);
 		if (iter != data.end()) {
 			return iter->second;
 		}
-		return "";
+		return HashObject::empty;
 	}
 
 	/**
@@ -126,7 +129,7 @@ public:
 	 * @return
 	 *   Integer value or 0 if property not set.
 	 */
-	int32_t getInt(std::string key) const;
+	int32_t getInt(const std::string& key) const;
 
 	/**
 	 * Retreivies a property unsigned integer value.
@@ -136,7 +139,7 @@ public:
 	 * @return
 	 *   Unsigned integer value or 0 if property not set.
 	 */
-	uint32_t getUInt(std::string key) const;
+	uint32_t getUInt(const std::string& key) const;
 
 	/**
 	 * Retreivies a property long value.
@@ -146,7 +149,7 @@ public:
 	 * @return
 	 *   Long value or 0 if property not set.
 	 */
-	int64_t getLong(std::string key) const;
+	int64_t getLong(const std::string& key) const;
 
 	/**
 	 * Retreivies a property unsigned long value.
@@ -156,7 +159,7 @@ public:
 	 * @return
 	 *   Unsigned long value or 0 if property not set.
 	 */
-	uint64_t getULong(std::string key) const;
+	uint64_t getULong(const std::string& key) const;
 
 	/**
 	 * Retreivies a property float value.
@@ -168,7 +171,7 @@ public:
 	 * @return
 	 *   Float value or 0 if property not set.
 	 */
-	float getFloat(std::string key, float def=0.0f) const;
+	float getFloat(const std::string& key, float def=0.0f) const;
 
 	/**
 	 * Retreivies a property double value.
@@ -178,7 +181,15 @@ public:
 	 * @return
 	 *   Double value or 0 if property not set.
 	 */
-	double getDouble(std::string key) const;
+	double getDouble(const std::string& key) const;
+
+	/**
+	 * Estimates memory held by properties.
+	 *
+	 * @return
+	 *   Byte count of table buckets, nodes & key/value strings stored outside of nodes.
+	 */
+	size_t getByteSize() const;
 };
 
 #endif /* RRE_HASH_OBJECT */
@@ -0,0 +1,69 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_HOT_RELOAD
+#define RRE_HOT_RELOAD
+
+#include <cstdint> // *int*_t
+#include <string>
+
+
+/**
+ * Development mode reloading game data while running.
+ *
+ * Mounted data directory is watched for changes. Changed files are reloaded once they have not
+ * been modified for `DEBOUNCE` milliseconds, rebuilding only affected store entries:
+ * - `conf/sprites.xml`: sprites with changed definitions
+ * - `conf/entities.xml`: entity templates with changed definitions
+ * - sprite images: textures of sprites using them
+ * - scene maps, blobs & images: map data of cached scenes built from them
+ *
+ * Cached sprites & scenes are updated in place so that live objects use new data.
+ *
+ * NOTE: only supported on Linux (inotify) when data is not mounted from an archive
+ */
+namespace HotReload {
+	/** Time in milliseconds a file must be unchanged before it is reloaded. */
+	const uint32_t DEBOUNCE = 250;
+	/** Minimum time in milliseconds between checks for changes. */
+	const uint32_t POLL_INTERVAL = 50;
+
+	/**
+	 * Starts watching mounted data directory.
+	 *
+	 * @return
+	 *   `true` if watching started.
+	 */
+	bool start();
+
+	/** Stops watching data directory. */
+	void stop();
+
+	/**
+	 * Checks if data directory is watched.
+	 */
+	bool active();
+
+	/**
+	 * Collects file changes & reloads files that have settled.
+	 *
+	 * Called from game loop.
+	 *
+	 * @param time_now
+	 *   Current time in milliseconds.
+	 */
+	void poll(uint64_t time_now);
+
+	/**
+	 * Reloads data affected by a changed file.
+	 *
+	 * @param path
+	 *   Path relative to data directory.
+	 */
+	void reload(std::string path);
+};
+
+#endif /* RRE_HOT_RELOAD */
@@ -7,11 +7,13 @@
 #ifndef RRE_IMAGE
 #define RRE_IMAGE
 
+#include <cstddef> // size_t
 #include <cstdint> // *int*_t
 
 #include <SDL2/SDL_render.h>
 
 #include "Logger.hpp"
+#include "TextureLoader.hpp"
 
 
 /**
@@ -19,7 +21,7 @@
  */
 class Image {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 protected:
 	/** Texture to draw with renderer. */
@@ -59,7 +61,7 @@ public:
 	 */
 	virtual ~Image() {
 		if (texture != nullptr) {
-			SDL_DestroyTexture(texture);
+			TextureLoader::destroy(texture);
 			texture = nullptr;
 		}
 	}
@@ -97,6 +99,24 @@ public:
 	bool ready() {
 		return this->texture != nullptr && width > 0 && height > 0;
 	}
+
+	/**
+	 * Replaces texture in place.
+	 *
+	 * Previous texture is destroyed. Holders of this image draw new texture from next frame.
+	 *
+	 * @param texture
+	 *   New texture.
+	 */
+	void replaceTexture(SDL_Texture* texture);
+
+	/**
+	 * Estimates memory held by texture.
+	 *
+	 * @return
+	 *   Byte count derived from texture dimensions & pixel format or 0 if texture not loaded.
+	 */
+	size_t getByteSize();
 };
 
 #endif /* RRE_IMAGE */
@@ -7,41 +7,72 @@
 #ifndef RRE_INPUT
 #define RRE_INPUT
 
+#include <array>
 #include <cstdint> // *int*_t
 #include <memory> // std::unique_ptr, std::make_unique
 #include <mutex>
 #include <string>
-#include <utility> // std::pair
+#include <unordered_map>
 #include <vector>
 
 #include <SDL2/SDL_events.h>
 #include <SDL2/SDL_gamecontroller.h>
 #include <SDL2/SDL_joystick.h>
 #include <SDL2/SDL_keycode.h>
+#include <SDL2/SDL_scancode.h>
 
+#include "InputEvent.hpp"
+#include "InputSnapshot.hpp"
 #include "Logger.hpp"
 
+class Player;
+
 
 /**
  * Manages user input.
  *
+ * Gamepads are opened once when connected & cached until disconnected.
+ *
  * TODO:
  * - _maybe_ convert to namespace
- * - listen for game controller connect/disconnect
  * - map game controller input
  */
 class Input {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	/** Active gamepad/joystick. */
 	SDL_GameController* gamepad;
 
-	/** Detected gamepads/joysticks listed by <index, GUID>. */
-	std::vector<std::pair<int32_t, SDL_JoystickGUID>> gamepad_guids;
+	/** Opened gamepads/joysticks indexed by instance ID. */
+	std::unordered_map<SDL_JoystickID, SDL_GameController*> gamepads;
+	/** Instance IDs of opened gamepads/joysticks indexed by GUID string. */
+	std::unordered_map<std::string, SDL_JoystickID> gamepad_ids;
+
+	/** Keyboard keys currently depressed. */
+	KeyState keys;
+	/** Keys pressed since previous logic step. */
+	KeyState step_pressed;
+	/** Keys released since previous logic step. */
+	KeyState step_released;
+	/** State captured at start of current logic step. */
+	InputSnapshot snapshot;
+
+	/** Number of gamepad axes tracked. */
+	static const uint8_t AXIS_COUNT = 8;
+	/** Minimum axis offset from center interpreted as a direction. */
+	static const int16_t AXIS_DEADZONE = 8000;
 
-	/** List of keyboard keys currently depressed. */
-	std::vector<SDL_Keycode> pressed_keys;
+	/** Events waiting to be applied at next logic step. */
+	std::vector<InputEvent> events;
+	/** Latest position of each axis received during current frame. */
+	std::array<int16_t, AXIS_COUNT> axis_values;
+	/** Axes with position received during current frame (bitmask). */
+	uint8_t axis_changed;
+	/** Time most recent axis position was received. */
+	uint64_t axis_time;
+	/** Directions currently held by axes. */
+	uint8_t axis_dir;
 
 	/** Static singleton instance. */
 	static std::unique_ptr<Input> instance;
@@ -52,36 +83,32 @@ private:
 	Input(const Input&) = delete;
 	Input& operator=(const Input&) = delete;
 
-	// default configuration (keyboard)
-	SDL_KeyCode up = SDLK_UP;
-	SDL_KeyCode down = SDLK_DOWN;
-	SDL_KeyCode left = SDLK_LEFT;
-	SDL_KeyCode right = SDLK_RIGHT;
-	SDL_KeyCode fire = SDLK_a;
-	SDL_KeyCode jump = SDLK_s;
-	SDL_KeyCode cycle_w_next = SDLK_GREATER;
-	SDL_KeyCode cycle_w_prev = SDLK_LESS;
-	SDL_KeyCode menu = SDLK_ESCAPE;
-
-	/**
-	 * Checks if a key is depressed.
-	 *
-	 * @param key
-	 *   Keycode to check.
-	 * @return
-	 *   `true` if found in pressed keys vector.
-	 */
-	bool keyIsPressed(SDL_Keycode key);
+	// default configuration (keyboard positions)
+	SDL_Scancode up = SDL_SCANCODE_UP;
+	SDL_Scancode down = SDL_SCANCODE_DOWN;
+	SDL_Scancode left = SDL_SCANCODE_LEFT;
+	SDL_Scancode right = SDL_SCANCODE_RIGHT;
+	SDL_Scancode fire = SDL_SCANCODE_A;
+	SDL_Scancode jump = SDL_SCANCODE_S;
+	SDL_Scancode cycle_w_next = SDL_SCANCODE_PERIOD;
+	SDL_Scancode cycle_w_prev = SDL_SCANCODE_COMMA;
+	SDL_Scancode menu = SDL_SCANCODE_ESCAPE;
+	/** Toggles frame profiler graph. */
+	SDL_Scancode profiler = SDL_SCANCODE_F3;
+	/** Writes recent trace zones to a file. */
+	SDL_Scancode trace_dump = SDL_SCANCODE_F4;
+	/** Toggles memory page. */
+	SDL_Scancode memory_page = SDL_SCANCODE_F5;
 
 	/**
 	 * Checks if a key is considered a direction press.
 	 *
 	 * @param key
-	 *   Keycode to check.
+	 *   Scancode to check.
 	 * @return
 	 *   `true` if key is "left", "right", "up", or "down".
 	 */
-	bool keyIsDirection(SDL_Keycode key);
+	bool keyIsDirection(SDL_Scancode key);
 
 	/**
 	 * Simulates releasing a keyboard key.
@@ -95,16 +122,38 @@ private:
 	 */
 	void releaseKey(SDL_Keycode key, uint16_t mod=KMOD_NONE);
 
+	/**
+	 * Converts a direction key to momentum direction.
+	 *
+	 * @param key
+	 *   Scancode to convert.
+	 * @return
+	 *   Direction or `MomentumDir::NONE`.
+	 */
+	uint8_t keyToDirection(SDL_Scancode key);
+
+	/**
+	 * Applies a queued event to player.
+	 *
+	 * @param evt
+	 *   Event to apply.
+	 * @param player
+	 *   Player instance (retrieved on first use).
+	 */
+	void applyEvent(const InputEvent& evt, Player*& player);
+
 public:
 	/** Default constructor. */
 	Input();
 
 	/** Default destructor. */
 	~Input() {
-		if (gamepad != nullptr) {
-			SDL_GameControllerClose(gamepad);
-			gamepad = nullptr;
+		gamepad = nullptr;
+		for (auto& dev_info: gamepads) {
+			SDL_GameControllerClose(dev_info.second);
 		}
+		gamepads.clear();
+		gamepad_ids.clear();
 	}
 
 	/**
@@ -140,7 +189,7 @@ public:
 	/**
 	 * Retrieves an attached gamepad/joystick.
 	 *
-	 * NOTE: Receiving function must call `SDL_GameControllerClose` on returned device.
+	 * NOTE: Returned device is owned by `Input` & must not be closed.
 	 *
 	 * @param guid
 	 *   Device's global ID.
@@ -159,9 +208,33 @@ public:
 	 */
 	std::string getGamepadName(SDL_GameController* dev);
 
-	/** Refreshes list of detected gamepads/joysticks. */
+	/**
+	 * Opens detected gamepads/joysticks not yet registered.
+	 *
+	 * Devices already opened are not opened again.
+	 */
 	void updateGamepads();
 
+	/**
+	 * Registers a connected gamepad/joystick.
+	 *
+	 * Called for `SDL_CONTROLLERDEVICEADDED` events.
+	 *
+	 * @param idx
+	 *   Device's system index.
+	 */
+	void onGamepadAdded(int32_t idx);
+
+	/**
+	 * Unregisters a disconnected gamepad/joystick.
+	 *
+	 * Called for `SDL_CONTROLLERDEVICEREMOVED` events.
+	 *
+	 * @param id
+	 *   Device's instance ID.
+	 */
+	void onGamepadRemoved(SDL_JoystickID id);
+
 	/**
 	 * Translates gamepad/joystick event to matching input event.
 	 *
@@ -173,11 +246,20 @@ public:
 	/**
 	 * Translates gamepad/joystick event to matching input event.
 	 *
+	 * Axis motion is coalesced to latest position of each axis per frame.
+	 *
 	 * @param evt
 	 *   Gamepad axis event.
 	 */
 	void translateGamepadAxisEvent(SDL_JoyAxisEvent evt);
 
+	/**
+	 * Queues latest axis positions received during current frame.
+	 *
+	 * Called from game loop after all pending events are polled.
+	 */
+	void endFrame();
+
 	/**
 	 * Translates gamepad/joystick event to matching input event.
 	 *
@@ -191,18 +273,46 @@ public:
 	/**
 	 * Interprets keyboard key down events.
 	 *
-	 * @param keycode
-	 *   Depressed key.
+	 * @param key
+	 *   Scancode of depressed key.
+	 * @param time
+	 *   Time in milliseconds key was pressed.
 	 */
-	void onKeyDown(SDL_Keycode keycode);
+	void onKeyDown(SDL_Scancode key, uint64_t time);
 
 	/**
 	 * Interprets keyboard key up events.
 	 *
-	 * @param keycode
-	 *   Released key.
+	 * @param key
+	 *   Scancode of released key.
+	 * @param time
+	 *   Time in milliseconds key was released.
+	 */
+	void onKeyUp(SDL_Scancode key, uint64_t time);
+
+	/**
+	 * Checks if a key is currently depressed.
+	 *
+	 * @param key
+	 *   Scancode to check.
+	 */
+	bool keyIsPressed(SDL_Scancode key) const { return keys.test(key); }
+
+	/**
+	 * Captures keyboard state for a new logic step.
+	 *
+	 * Queued events are applied in order received & presses & releases since previous call are
+	 * moved into snapshot.
+	 *
+	 * @return
+	 *   Snapshot of new step.
+	 */
+	const InputSnapshot& beginStep();
+
+	/**
+	 * Retrieves keyboard state of current logic step.
 	 */
-	void onKeyUp(SDL_Keycode keycode);
+	const InputSnapshot& getSnapshot() const { return snapshot; }
 };
 
 #endif /* RRE_INPUT */
@@ -0,0 +1,32 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_INPUT_EVENT
+#define RRE_INPUT_EVENT
+
+#include <cstdint> // *int*_t
+
+
+/** Input received between game logic steps. */
+struct InputEvent {
+	enum Type: uint8_t {
+		KEY_DOWN,
+		KEY_UP,
+		AXIS
+	};
+
+	/** Time in milliseconds event was received. */
+	uint64_t time;
+	Type type;
+	/** Scancode of key or index of gamepad axis. */
+	uint16_t code;
+	/** Axis position (unused for keys). */
+	int16_t value;
+	/** Latency measurement sequence number. */
+	uint32_t seq;
+};
+
+#endif /* RRE_INPUT_EVENT */
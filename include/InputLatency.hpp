@@ -0,0 +1,117 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_INPUT_LATENCY
+#define RRE_INPUT_LATENCY
+
+#include <cstdint> // *int*_t
+#include <ostream>
+#include <string>
+
+
+/**
+ * Input-to-present latency measurements.
+ */
+struct InputLatencySnapshot {
+	/** Number of measured input events. */
+	uint64_t samples;
+	/** Shortest latency in milliseconds. */
+	uint32_t min;
+	/** Mean latency in milliseconds. */
+	float avg;
+	/** 99th percentile of recent latencies in milliseconds. */
+	uint32_t p99;
+};
+
+/**
+ * Measures time from input event to presenting first frame reflecting it.
+ *
+ * Each queued input event is tagged with a sequence number that is carried through pipeline:
+ * - `Input` tags event when received
+ * - `GameLogic` step marks sequence applied
+ * - `Viewport` render captures latest applied sequence & marks it presented after
+ *   `Renderer::present`
+ *
+ * Synthetic key presses can be injected to measure without user input.
+ */
+namespace InputLatency {
+	/** Sequence number of untagged events. */
+	const uint32_t NO_SEQ = 0;
+	/** Default number of measurements collected by `--bench-input`. */
+	const uint32_t DEFAULT_SAMPLES = 200;
+
+	/**
+	 * Tags a received input event.
+	 *
+	 * @param time
+	 *   Event timestamp in milliseconds.
+	 * @return
+	 *   Sequence number.
+	 */
+	uint32_t tag(uint64_t time);
+
+	/**
+	 * Marks an event applied by game logic.
+	 *
+	 * @param seq
+	 *   Sequence number.
+	 */
+	void markApplied(uint32_t seq);
+
+	/** Marks start of rendering frame reflecting events applied so far. */
+	void markRendered();
+
+	/**
+	 * Marks rendered frame presented & records latency of events it reflects.
+	 *
+	 * @param time
+	 *   Present time in milliseconds.
+	 */
+	void markPresented(uint64_t time);
+
+	/**
+	 * Retrieves current measurements.
+	 */
+	InputLatencySnapshot getSnapshot();
+
+	/**
+	 * Formats current measurements for debug overlay.
+	 */
+	std::string getSummary();
+
+	/**
+	 * Writes current measurements as JSON.
+	 *
+	 * @param out
+	 *   Output stream.
+	 */
+	void writeJson(std::ostream& out);
+
+	/**
+	 * Starts injecting synthetic key presses from game loop.
+	 *
+	 * Title screen is confirmed with enter key, then direction key is pressed & released at
+	 * varying intervals so that events land at different points between logic steps.
+	 *
+	 * @param count
+	 *   Number of measurements to collect.
+	 */
+	void startInjection(uint32_t count);
+
+	/**
+	 * Pushes next synthetic key event when due.
+	 *
+	 * Called from game loop before polling events.
+	 *
+	 * @param time_now
+	 *   Current time in milliseconds.
+	 * @return
+	 *   `true` if requested measurements were collected or injection timed out.
+	 */
+	bool inject(uint64_t time_now);
+};
+
+#endif /* RRE_INPUT_LATENCY */
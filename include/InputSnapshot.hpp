@@ -0,0 +1,53 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_INPUT_SNAPSHOT
+#define RRE_INPUT_SNAPSHOT
+
+#include <bitset>
+
+#include <SDL2/SDL_scancode.h>
+
+
+/** Keyboard state indexed by scancode. */
+typedef std::bitset<SDL_NUM_SCANCODES> KeyState;
+
+/**
+ * Keyboard state for a single game logic step.
+ *
+ * Keys pressed & released between two steps are reported by both `wasPressed` & `wasReleased`
+ * so that short taps are not lost.
+ */
+struct InputSnapshot {
+	/** Keys held at start of step. */
+	KeyState down;
+	/** Keys pressed since previous step. */
+	KeyState pressed;
+	/** Keys released since previous step. */
+	KeyState released;
+
+	/**
+	 * Checks if a key is held.
+	 */
+	bool isDown(SDL_Scancode key) const { return down.test(key); }
+
+	/**
+	 * Checks if a key was pressed since previous step.
+	 */
+	bool wasPressed(SDL_Scancode key) const { return pressed.test(key); }
+
+	/**
+	 * Checks if a key was released since previous step.
+	 */
+	bool wasReleased(SDL_Scancode key) const { return released.test(key); }
+
+	/**
+	 * Checks if a key is held or was tapped since previous step.
+	 */
+	bool isActive(SDL_Scancode key) const { return down.test(key) || pressed.test(key); }
+};
+
+#endif /* RRE_INPUT_SNAPSHOT */
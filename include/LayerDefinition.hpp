@@ -4,10 +4,75 @@
  * See: LICENSE.txt
  */
 
-#include <utility> // std::pair
+#ifndef RRE_LAYER_DEFINITION
+#define RRE_LAYER_DEFINITION
+
+#include <cstddef> // size_t
+#include <cstdint> // *int*_t
+#include <span>
+#include <utility> // std::move, std::pair
 #include <vector>
 
 
 typedef std::pair<uint32_t, uint8_t> TileDefinition;
 
 typedef std::vector<TileDefinition> LayerDefinition;
+
+
+/**
+ * Tile layer data either owned by layer or referencing memory held elsewhere (e.g. a mapped
+ * scene blob).
+ */
+class TileLayer {
+private:
+	/** Tile storage when data is owned by layer. */
+	LayerDefinition owned;
+	/** Tiles used for drawing. */
+	std::span<const TileDefinition> tiles;
+
+public:
+	/** Default constructor. */
+	TileLayer() {}
+
+	/**
+	 * Creates a layer that owns its tile data.
+	 *
+	 * @param ldef
+	 *   Tile layer definition.
+	 */
+	TileLayer(LayerDefinition ldef): owned(std::move(ldef)) { tiles = owned; }
+
+	/**
+	 * Creates a layer referencing external tile data.
+	 *
+	 * Referenced memory must outlive layer.
+	 *
+	 * @param view
+	 *   Tile data.
+	 */
+	TileLayer(std::span<const TileDefinition> view): tiles(view) {}
+
+	// NOTE: moving owned vector keeps its buffer so view remains valid
+	TileLayer(TileLayer&&) = default;
+	TileLayer& operator=(TileLayer&&) = default;
+	TileLayer(const TileLayer&) = delete;
+	TileLayer& operator=(const TileLayer&) = delete;
+
+	/**
+	 * Retrieves tiles in layer.
+	 *
+	 * @return
+	 *   Tile definitions ordered left-to-right, top-to-bottom.
+	 */
+	std::span<const TileDefinition> getTiles() const { return tiles; }
+
+	/**
+	 * Retrieves heap memory held by layer.
+	 *
+	 * @return
+	 *   Byte count (0 if tile data is not owned).
+	 */
+	size_t getByteSize() const { return owned.capacity() * sizeof(TileDefinition); }
+};
+
+#endif /* RRE_LAYER_DEFINITION */
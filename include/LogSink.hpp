@@ -0,0 +1,134 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_LOG_SINK
+#define RRE_LOG_SINK
+
+#include <cstdint> // *int*_t
+#include <string>
+
+#include "enum/LogLevel.hpp"
+
+
+/**
+ * Asynchronous output of formatted log messages.
+ *
+ * Messages are copied into a fixed size lock-free ring buffer shared by all threads. A background
+ * writer thread drains buffer in batches to console & logger files so that logging thread never
+ * waits for output.
+ *
+ * Before writer is started messages are written by logging thread.
+ */
+namespace LogSink {
+	/** Behavior when ring buffer is full. */
+	enum Overflow: uint8_t {
+		/** Message is discarded & counted (default). */
+		DROP,
+		/** Message is written by logging thread (may block). */
+		SYNC
+	};
+
+	/** Number of messages buffer can hold. */
+	const uint32_t CAPACITY = 1024;
+	/** Max length of a buffered message, longer messages are truncated. */
+	const uint32_t MESSAGE_SIZE = 500;
+	/** Time in milliseconds writer waits when buffer is empty. */
+	const uint32_t FLUSH_INTERVAL = 10;
+	/** File index of messages not exported to file. */
+	const uint8_t NO_FILE = UINT8_MAX;
+	/** File index of `debug.log` in executable directory. */
+	const uint8_t DEFAULT_FILE = 0;
+
+	/**
+	 * Starts writer thread.
+	 *
+	 * Default file path is resolved here if no message has been written yet. Writer is stopped &
+	 * remaining messages written at exit.
+	 */
+	void start();
+
+	/** Writes remaining messages & stops writer thread. */
+	void stop();
+
+	/**
+	 * Sets behavior when buffer is full.
+	 *
+	 * @param policy
+	 *   Overflow policy.
+	 */
+	void setOverflow(Overflow policy);
+
+	/**
+	 * Limits messages logged per second from a single call site.
+	 *
+	 * @param count
+	 *   Max messages per second (0 for unlimited).
+	 */
+	void setRateLimit(uint32_t count);
+
+	/**
+	 * Checks rate limit of a call site.
+	 *
+	 * @param file
+	 *   Source file of call site.
+	 * @param line
+	 *   Source line of call site.
+	 * @param suppressed
+	 *   Set to number of messages suppressed at call site since it was last allowed.
+	 * @return
+	 *   `true` if message may be logged.
+	 */
+	bool allow(const char* file, uint32_t line, uint32_t& suppressed);
+
+	/**
+	 * Enables or disables export of messages to files.
+	 *
+	 * @param enabled
+	 *   `false` to only write messages to console.
+	 */
+	void setFileOutput(bool enabled);
+
+	/**
+	 * Registers a file for exporting messages.
+	 *
+	 * Paths are made absolute so that a file registered by different paths is opened once.
+	 *
+	 * @param path
+	 *   File path or empty string for default file.
+	 * @return
+	 *   File index or `NO_FILE` if too many files are registered.
+	 */
+	uint8_t addFile(const std::string& path);
+
+	/**
+	 * Retrieves path of a registered file.
+	 *
+	 * @param idx
+	 *   File index.
+	 * @return
+	 *   Absolute file path or empty string if index is not registered.
+	 */
+	std::string getPath(uint8_t idx);
+
+	/**
+	 * Queues a formatted message.
+	 *
+	 * @param level
+	 *   Message urgency level.
+	 * @param file
+	 *   Index of file where message is exported.
+	 * @param text
+	 *   Formatted message.
+	 */
+	void push(LogLevel level, uint8_t file, const std::string& text);
+
+	/**
+	 * Retrieves number of messages dropped because buffer was full.
+	 */
+	uint64_t getDropped();
+};
+
+#endif /* RRE_LOG_SINK */
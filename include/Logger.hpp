@@ -7,30 +7,63 @@
 #ifndef RRE_LOGGER
 #define RRE_LOGGER
 
-#include <iostream>
+#include "config.h"
+
+#include <cstdint> // *int*_t
+#include <source_location>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 
-#include "StrUtil.hpp"
-
-
-/** Defined logging levels. */
-enum LogLevel {
-	/** Don't output any messages (least verbose). */
-	SILENT,
-	/** Output messages up to "error" urgency level. */
-	ERROR,
-	/** Output messages up to "warning" urgency level. */
-	WARN,
-	/** Output messages up to "info" urgency level. */
-	INFO,
-	/** Output messages up to "debug" urgency level (most verbose). */
-	DEBUG
+#include "LogSink.hpp"
+#include "enum/LogLevel.hpp"
+
+
+/**
+ * Logs a message if its level is compiled in & enabled for logger.
+ *
+ * Unlike calling logging methods directly, message arguments are not evaluated when level is
+ * disabled & no code is generated for levels above `RRE_LOG_LEVEL_MAX`.
+ */
+#define RRE_LOG(logger, level, ...) \
+	do { \
+		if constexpr (Logger::compiled(level)) { \
+			if ((logger).enabled(level)) (logger).log(level, __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define LOG_ERROR(logger, ...) RRE_LOG(logger, ERROR, __VA_ARGS__)
+#define LOG_WARN(logger, ...) RRE_LOG(logger, WARN, __VA_ARGS__)
+#define LOG_INFO(logger, ...) RRE_LOG(logger, INFO, __VA_ARGS__)
+#define LOG_DEBUG(logger, ...) RRE_LOG(logger, DEBUG, __VA_ARGS__)
+
+
+/**
+ * Message text with location of logging call site.
+ *
+ * Location is captured implicitly when text is passed to a logging method. Text is referenced,
+ * not copied, & is valid for duration of logging call.
+ */
+struct LogMessage {
+	std::string_view text;
+	std::source_location site;
+
+	LogMessage(const char* text, std::source_location site=std::source_location::current())
+			: text(text), site(site) {}
+
+	LogMessage(const std::string& text, std::source_location site=std::source_location::current())
+			: text(text), site(site) {}
+
+	LogMessage(std::string_view text, std::source_location site=std::source_location::current())
+			: text(text), site(site) {}
 };
 
 /**
  * Handles logging messages.
+ *
+ * Messages are output asynchronously by `LogSink`.
  */
 class Logger {
 private:
@@ -38,8 +71,8 @@ private:
 	std::string id;
 	/** Max urgency level at which to output messages. */
 	LogLevel level;
-	/** Optional file where to export messages (not yet supported). */
-	std::string file;
+	/** Index of file registered with `LogSink`. */
+	uint8_t file_idx;
 
 	/** Default urgency level when a logger is created without specifying level. */
 	static LogLevel default_level;
@@ -54,7 +87,7 @@ private:
 	 * @param level
 	 *   Max message urgency level.
 	 * @param file
-	 *   File where to export messages (not yet supported).
+	 *   File where to export messages (empty for default file).
 	 */
 	Logger(std::string id, LogLevel level, std::string file);
 
@@ -74,7 +107,7 @@ private:
 	 * @param id
 	 *   Logger identifier.
 	 * @param file
-	 *   File where to export messages (not yet supported).
+	 *   File where to export messages.
 	 */
 	Logger(std::string id, std::string file) : Logger(id, Logger::default_level, file) {}
 
@@ -87,12 +120,18 @@ private:
 	Logger(std::string id) : Logger(id, Logger::default_level, "") {}
 
 	/**
-	 * Exports message to configured file (not yet supported).
+	 * Formats a message argument.
 	 *
-	 * @param msg
-	 *   Text to export.
+	 * Single byte integers are formatted as numbers rather than characters.
 	 */
-	void write(std::string msg);
+	template <typename T>
+	static void append(std::ostringstream& os, const T& value) {
+		if constexpr (std::is_integral_v<T> && sizeof(T) == 1 && !std::is_same_v<T, char>) {
+			os << (int) value;
+		} else {
+			os << value;
+		}
+	}
 
 public:
 	/**
@@ -102,27 +141,51 @@ public:
 	 */
 	Logger() {
 		this->level = Logger::default_level;
+		this->file_idx = LogSink::NO_FILE;
 	}
 
 	/**
 	 * Initializes a new logger or retrieves cached one from memory.
 	 *
+	 * Returned reference remains valid for lifetime of program & should be kept instead of
+	 * copying logger.
+	 *
 	 * @param id
 	 *   Logger identifier.
 	 * @return
 	 *   Logger instance associated with `id`.
 	 */
-	static Logger& getLogger(std::string id) {
+	static Logger& getLogger(const std::string& id) {
 		/** Logger instances. */
 		static std::unordered_map<std::string, Logger> loggers;
 
-		if (loggers.find(id) != loggers.end()) {
-			return loggers[id];
+		auto iter = loggers.find(id);
+		if (iter != loggers.end()) {
+			return iter->second;
 		}
+		return loggers.emplace(id, Logger(id)).first->second;
+	}
+
+	/**
+	 * Checks if messages of a level are compiled in.
+	 *
+	 * @param level
+	 *   Message urgency level.
+	 * @return
+	 *   `false` if level is more verbose than build time `RRE_LOG_LEVEL_MAX`.
+	 */
+	static constexpr bool compiled(LogLevel level) {
+		return level != SILENT && level <= RRE_LOG_LEVEL_MAX;
+	}
 
-		Logger logger(id);
-		loggers[id] = logger;
-		return loggers[id];
+	/**
+	 * Checks if messages of a level are output by this logger.
+	 *
+	 * @param level
+	 *   Message urgency level.
+	 */
+	bool enabled(LogLevel level) const {
+		return Logger::compiled(level) && level <= this->level;
 	}
 
 	/**
@@ -143,19 +206,29 @@ public:
 	 *
 	 * Defined in header to allow dynamic creation of necessary instances.
 	 *
+	 * Messages from a call site exceeding rate limit (see `LogSink::setRateLimit`) are
+	 * suppressed & counted in next message from same site.
+	 *
+	 * Arguments are only formatted if message is output, so numbers can be passed without
+	 * converting to strings first.
+	 *
 	 * @param level
 	 *   Message urgency level.
 	 * @param msg
 	 *   Text to output.
 	 * @param rem
-	 *   Any additional text to append to message.
+	 *   Any additional text or numbers to append to message.
 	 */
 	template <typename... vargs>
-	void log(LogLevel level, std::string msg, vargs... rem) {
-		if (this->level < level || this->level == SILENT || level == SILENT) {
+	void log(LogLevel level, const LogMessage& msg, const vargs&... rem) {
+		if (!this->enabled(level)) {
 			// do nothing
 			return;
 		}
+		uint32_t suppressed;
+		if (!LogSink::allow(msg.site.file_name(), msg.site.line(), suppressed)) {
+			return;
+		}
 
 		std::ostringstream os;
 		switch (level) {
@@ -172,18 +245,15 @@ public:
 				os << "INFO:  ";
 		}
 
-		os << "(" << id << ") " << msg;
+		os << "(" << id << ") " << msg.text;
 
 		// append remaining messages
-		((os << StrUtil::check(rem)), ...);
+		(Logger::append(os, rem), ...);
 
-		const std::string st = os.str();
-		if (level == ERROR) {
-			std::cerr << st << std::endl;
-		} else {
-			std::cout << st << std::endl;
+		if (suppressed > 0) {
+			os << " (" << suppressed << " similar suppressed)";
 		}
-		write(st);
+		LogSink::push(level, this->file_idx, os.str());
 	}
 
 	/**
@@ -195,8 +265,10 @@ public:
 	 *   Any additional text to append to message.
 	 */
 	template <typename... vargs>
-	void log(std::string msg, vargs... rem) {
-		this->log(INFO, msg, rem...);
+	void log(const LogMessage& msg, const vargs&... rem) {
+		if constexpr (Logger::compiled(INFO)) {
+			this->log(INFO, msg, rem...);
+		}
 	}
 
 	/**
@@ -208,8 +280,10 @@ public:
 	 *   Any additional text to append to message.
 	 */
 	template <typename... vargs>
-	void info(std::string msg, vargs... rem) {
-		this->log(INFO, msg, rem...);
+	void info(const LogMessage& msg, const vargs&... rem) {
+		if constexpr (Logger::compiled(INFO)) {
+			this->log(INFO, msg, rem...);
+		}
 	}
 
 	/**
@@ -221,8 +295,10 @@ public:
 	 *   Any additional text to append to message.
 	 */
 	template <typename... vargs>
-	void warn(std::string msg, vargs... rem) {
-		this->log(WARN, msg, rem...);
+	void warn(const LogMessage& msg, const vargs&... rem) {
+		if constexpr (Logger::compiled(WARN)) {
+			this->log(WARN, msg, rem...);
+		}
 	}
 
 	/**
@@ -234,8 +310,10 @@ public:
 	 *   Any additional text to append to message.
 	 */
 	template <typename... vargs>
-	void error(std::string msg, vargs... rem) {
-		this->log(ERROR, msg, rem...);
+	void error(const LogMessage& msg, const vargs&... rem) {
+		if constexpr (Logger::compiled(ERROR)) {
+			this->log(ERROR, msg, rem...);
+		}
 	}
 
 	/**
@@ -247,18 +325,20 @@ public:
 	 *   Any additional text to append to message.
 	 */
 	template <typename... vargs>
-	void debug(std::string msg, vargs... rem) {
-		this->log(DEBUG, msg, rem...);
+	void debug(const LogMessage& msg, const vargs&... rem) {
+		if constexpr (Logger::compiled(DEBUG)) {
+			this->log(DEBUG, msg, rem...);
+		}
 	}
 
 	/**
 	 * Retrieves path for exporting messages to file.
 	 *
 	 * @return
-	 *   Absolute file path.
+	 *   Absolute file path or empty string if messages are not exported.
 	 */
 	std::string getFile() {
-		return this->file;
+		return LogSink::getPath(this->file_idx);
 	}
 };
 
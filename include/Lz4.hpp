@@ -0,0 +1,66 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_LZ4
+#define RRE_LZ4
+
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t
+
+
+/**
+ * Minimal LZ4 block format codec.
+ *
+ * Output is compatible with the reference LZ4 block format (no frame header).
+ */
+namespace Lz4 {
+
+	/**
+	 * Retrieves maximum compressed size of input data.
+	 *
+	 * @param src_size
+	 *   Uncompressed byte count.
+	 * @return
+	 *   Required output buffer size.
+	 */
+	inline size_t compressBound(size_t src_size) {
+		return src_size + (src_size / 255) + 16;
+	}
+
+	/**
+	 * Compresses a block of data.
+	 *
+	 * @param src
+	 *   Data to be compressed.
+	 * @param src_size
+	 *   Byte count of `src`.
+	 * @param dst
+	 *   Output buffer.
+	 * @param dst_capacity
+	 *   Size of output buffer.
+	 * @return
+	 *   Compressed byte count or 0 if output buffer is too small.
+	 */
+	size_t compress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_capacity);
+
+	/**
+	 * Decompresses a block of data.
+	 *
+	 * @param src
+	 *   Compressed data.
+	 * @param src_size
+	 *   Byte count of `src`.
+	 * @param dst
+	 *   Output buffer.
+	 * @param dst_size
+	 *   Exact uncompressed byte count.
+	 * @return
+	 *   `true` if data was valid & decompressed to exactly `dst_size` bytes.
+	 */
+	bool decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size);
+};
+
+#endif /* RRE_LZ4 */
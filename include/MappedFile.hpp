@@ -0,0 +1,88 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_MAPPED_FILE
+#define RRE_MAPPED_FILE
+
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t
+#include <string>
+
+
+/**
+ * Read-only file mapped into memory.
+ *
+ * Mapping is released when instance is destroyed.
+ */
+class MappedFile {
+private:
+	const uint8_t* data;
+	size_t size;
+
+#ifdef __WIN32__
+	void* file_handle;
+	void* map_handle;
+#endif
+
+public:
+	/** Default constructor. */
+	MappedFile();
+
+	/**
+	 * Maps a file into memory.
+	 *
+	 * @param path
+	 *   Absolute path to file.
+	 */
+	MappedFile(std::string path): MappedFile() { open(path); }
+
+	/** Default destructor. */
+	~MappedFile() { close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	 * Maps a file into memory.
+	 *
+	 * Any previously mapped file is released.
+	 *
+	 * @param path
+	 *   Absolute path to file.
+	 * @return
+	 *   `true` if file was mapped.
+	 */
+	bool open(std::string path);
+
+	/** Releases mapped file. */
+	void close();
+
+	/**
+	 * Checks if a file is mapped.
+	 *
+	 * @return
+	 *   `true` if file data is available.
+	 */
+	bool ready() { return data != nullptr; }
+
+	/**
+	 * Retrieves mapped file data.
+	 *
+	 * @return
+	 *   Pointer to start of file or `null` if not mapped.
+	 */
+	const uint8_t* getData() { return data; }
+
+	/**
+	 * Retrieves size of mapped file.
+	 *
+	 * @return
+	 *   Byte count.
+	 */
+	size_t getSize() { return size; }
+};
+
+#endif /* RRE_MAPPED_FILE */
@@ -0,0 +1,59 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_MEMORY_STATS
+#define RRE_MEMORY_STATS
+
+#include <cstdint> // *int*_t
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+/**
+ * Estimated memory held by a subsystem.
+ */
+struct MemoryUsage {
+	/** Byte count. */
+	uint64_t bytes = 0;
+	/** Number of items held. */
+	uint32_t count = 0;
+};
+
+/**
+ * Collects estimated memory held by stores & cached scenes.
+ *
+ * Measurements are taken on request by asking each store for its usage. Texture memory is
+ * estimated from format & dimensions, so driver overhead & mipmaps are not included.
+ */
+namespace MemoryStats {
+
+	/**
+	 * Formats measurements for on-screen display.
+	 *
+	 * @return
+	 *   Uppercase text lines.
+	 */
+	std::vector<std::string> getSummary();
+
+	/**
+	 * Writes measurements as JSON.
+	 *
+	 * @param out
+	 *   Output stream.
+	 */
+	void writeReport(std::ostream& out);
+
+	/** Shows or hides on-screen memory page. */
+	void togglePage();
+
+	/**
+	 * Checks if on-screen memory page is shown.
+	 */
+	bool pageVisible();
+};
+
+#endif /* RRE_MEMORY_STATS */
@@ -13,20 +13,18 @@
 #include <vector>
 
 #include "FontMap.hpp"
-#include "Image.hpp"
 #include "Logger.hpp"
+#include "MovieStream.hpp"
 #include "Renderer.hpp"
 #include "Sprite.hpp"
 
 
 /**
- * Type representing <duration (ms), image>.
+ * Type representing <image path, duration (ms)>.
  *
- * TODO:
- * - don't use pointers
- * - invert order (<image, duration>) to match sprite animations
+ * Image path is relative to data directory & empty if frame has no image.
  */
-typedef std::pair<uint32_t, Image*> MovieFrame;
+typedef std::pair<std::string, uint32_t> MovieFrame;
 
 /** Type representing a series of movie frames. */
 typedef std::vector<MovieFrame> MovieFrameList;
@@ -36,11 +34,14 @@ typedef std::vector<MovieFrame> MovieFrameList;
  */
 class Movie {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	/** Frames drawn for this movie. */
 	MovieFrameList frames;
 
+	/** Decodes frame images ahead of playback. */
+	MovieStream* stream = nullptr;
+
 	/**
 	 * Text drawn for this movie.
 	 *
@@ -67,19 +68,20 @@ public:
 	Movie() {}
 
 	/**
-	 * Creates a new movie.
+	 * Creates a new movie & starts decoding frames.
+	 *
+	 * Consecutive frames using the same image are merged.
 	 *
 	 * @param frames
 	 *   Frames drawn for this movie.
 	 */
-	Movie(MovieFrameList frames) { this->frames = frames; }
+	Movie(MovieFrameList frames);
 
 	/** Default destructor. */
 	~Movie() {
 		this->clearText();
-		for (MovieFrame f: this->frames) {
-			delete f.second;
-		}
+		delete this->stream;
+		this->stream = nullptr;
 		this->frames.clear();
 	}
 
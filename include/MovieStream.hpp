@@ -0,0 +1,143 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_MOVIE_STREAM
+#define RRE_MOVIE_STREAM
+
+#include <condition_variable>
+#include <cstdint> // *int*_t
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SDL2/SDL_rect.h>
+#include <SDL2/SDL_render.h>
+#include <SDL2/SDL_surface.h>
+
+#include "Logger.hpp"
+#include "Renderer.hpp"
+
+
+/**
+ * Decodes movie frames ahead of playback.
+ *
+ * A worker thread decodes frame images into a fixed ring of slots while the render thread uploads
+ * decoded pixels into streaming textures owned by each slot. Memory use is bounded by ring size
+ * regardless of movie length. Frames with pixels identical to previous frame are marked as
+ * duplicates & not uploaded when previous frame is displayed.
+ */
+class MovieStream {
+public:
+	/** Default number of frames decoded ahead. */
+	static const uint32_t DEFAULT_RING_SIZE = 4;
+
+private:
+	static Logger& logger;
+
+	/** Slot states. */
+	enum SlotState: uint8_t {
+		/** Slot can be used by worker. */
+		FREE,
+		/** Pixels decoded & waiting to be uploaded. */
+		DECODED,
+		/** Pixels uploaded to slot texture. */
+		UPLOADED
+	};
+
+	struct Slot {
+		/** Index of frame held by slot. */
+		uint32_t frame = 0;
+		SlotState state = FREE;
+		/** Denotes frame is identical to previous frame. */
+		bool duplicate = false;
+		/** Decoded pixels (`null` if frame has no image). */
+		SDL_Surface* surface = nullptr;
+		/** Streaming texture reused for frames held by slot. */
+		SDL_Texture* texture = nullptr;
+		/** Texture dimensions. */
+		int32_t width = 0;
+		int32_t height = 0;
+		/** Denotes texture holds an image for current frame. */
+		bool has_image = false;
+	};
+
+	/** Frame image paths relative to data directory (empty if frame has no image). */
+	std::vector<std::string> paths;
+	std::vector<Slot> slots;
+
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::thread worker;
+	bool stopping;
+
+	/** Slot currently drawn (-1 if none). */
+	int32_t display_slot;
+	/** Index of frame currently drawn (pixels of displayed slot match this frame). */
+	uint32_t display_frame;
+	/** Index of last frame that wasn't decoded in time. */
+	uint32_t late_frame;
+	/** Number of frames that weren't decoded in time. */
+	uint32_t late_count;
+
+	/** Worker loop decoding frames in order. */
+	void decode();
+
+	/**
+	 * Decodes a frame image.
+	 *
+	 * @param path
+	 *   Image path relative to data directory.
+	 * @return
+	 *   Surface in ARGB8888 format or `null` if image could not be loaded.
+	 */
+	SDL_Surface* decodeImage(const std::string& path);
+
+	/**
+	 * Uploads decoded pixels to slot texture.
+	 *
+	 * @param ctx
+	 *   Renderer used to create texture.
+	 * @param slot
+	 *   Slot holding decoded pixels.
+	 */
+	void upload(Renderer* ctx, Slot& slot);
+
+public:
+	/**
+	 * Creates a stream & starts decoding.
+	 *
+	 * @param paths
+	 *   Frame image paths relative to data directory (empty if frame has no image).
+	 * @param ring_size
+	 *   Number of frames decoded ahead.
+	 */
+	MovieStream(std::vector<std::string> paths, uint32_t ring_size=DEFAULT_RING_SIZE);
+
+	/** Stops worker & frees textures. */
+	~MovieStream();
+
+	MovieStream(const MovieStream&) = delete;
+	MovieStream& operator=(const MovieStream&) = delete;
+
+	/**
+	 * Advances to a frame & retrieves texture to draw.
+	 *
+	 * If frame has not been decoded yet previous frame continues to be drawn.
+	 *
+	 * @param ctx
+	 *   Renderer used to upload textures.
+	 * @param frame
+	 *   Index of frame to draw (must not decrease).
+	 * @param rect
+	 *   Set to texture dimensions.
+	 * @return
+	 *   Texture or `null` if there is nothing to draw.
+	 */
+	SDL_Texture* getFrame(Renderer* ctx, uint32_t frame, SDL_Rect& rect);
+};
+
+#endif /* RRE_MOVIE_STREAM */
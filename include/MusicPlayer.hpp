@@ -0,0 +1,60 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_MUSIC_PLAYER
+#define RRE_MUSIC_PLAYER
+
+#include <cstdint> // *int*_t
+#include <string>
+
+
+/**
+ * Plays music without blocking game loop.
+ *
+ * Music files are read, paged into memory & opened by a worker thread. Once the next track is
+ * ready the active track fades out & the next track fades in over the configured crossfade time.
+ *
+ * NOTE: SDL_mixer plays a single music stream so tracks don't overlap, fade out of active track is
+ *       followed by fade in of next track
+ */
+namespace MusicPlayer {
+
+	/**
+	 * Starts worker thread.
+	 *
+	 * Must be called after audio device is opened.
+	 *
+	 * @param crossfade
+	 *   Time in milliseconds to transition between tracks.
+	 */
+	void init(uint32_t crossfade);
+
+	/** Stops worker thread & frees music. */
+	void shutdown();
+
+	/**
+	 * Requests a track to be played.
+	 *
+	 * Returns immediately. Track starts once it is loaded & active track has faded out. Track
+	 * already playing is not restarted.
+	 *
+	 * @param path
+	 *   Music path relative to data directory.
+	 */
+	void play(std::string path);
+
+	/** Fades out active track & cancels pending request. */
+	void stop();
+
+	/**
+	 * Starts loaded tracks & frees finished tracks.
+	 *
+	 * Called from game loop.
+	 */
+	void update();
+};
+
+#endif /* RRE_MUSIC_PLAYER */
@@ -20,7 +20,7 @@
  */
 class Object: public HashObject {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	/** Objects identifier when added to a scene. */
 	uint32_t id;
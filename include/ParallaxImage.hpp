@@ -29,7 +29,7 @@ enum ORIENT {
  */
 class ParallaxImage: public Image {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	/** Scrolling direction. */
 	ORIENT orientation;
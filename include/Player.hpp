@@ -20,7 +20,7 @@
  */
 class Player: public Character {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	/** Last horizontal position detected. */
 	uint32_t x_prev;
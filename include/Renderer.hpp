@@ -7,7 +7,9 @@
 #ifndef RRE_RENDERER
 #define RRE_RENDERER
 
+#include <array>
 #include <cstdint> // *int*_t
+#include <iostream>
 #include <string>
 
 #include <SDL2/SDL_blendmode.h>
@@ -28,18 +30,66 @@ struct RendererState {
 	SDL_BlendMode blend_mode;
 };
 
+/**
+ * Renderer work counted per frame.
+ */
+struct RenderStats {
+	/** Textures copied to target (`SDL_RenderCopyEx` calls). */
+	uint64_t copies = 0;
+	/** Copies using a different texture than previous copy. */
+	uint64_t texture_binds = 0;
+	/** Draw color changes. */
+	uint64_t color_changes = 0;
+	/** Blend mode changes. */
+	uint64_t blend_changes = 0;
+	/** Filled rectangles. */
+	uint64_t fills = 0;
+	/** Pixels covered by filled rectangles (before scaling). */
+	uint64_t fill_area = 0;
+	/** Render target switches. */
+	uint64_t target_switches = 0;
+	/** Color & blend mode changes skipped as state already matched. */
+	uint64_t redundant_changes = 0;
+};
+
 /**
  * Wrapper for `SDL_Renderer`.
  */
 class Renderer {
+public:
+	/** Maximum nesting of saved states. */
+	static const uint8_t STATE_DEPTH = 8;
+
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	/** Actual renderer interface. */
 	SDL_Renderer* internal;
 
-	/** Saved state. */
-	RendererState* state;
+	/** Draw state last set on internal renderer. */
+	RendererState current;
+	/** Saved states. */
+	std::array<RendererState, STATE_DEPTH> saved;
+	/** Number of saves not yet restored (may exceed `STATE_DEPTH` on overflow). */
+	uint8_t depth;
+
+	/** Window width in pixels. */
+	uint32_t width;
+	/** Window height in pixels. */
+	uint32_t height;
+	/** Scaling factor of rendering target. */
+	uint16_t scale;
+
+	/** Work counted since previous present. */
+	RenderStats stats;
+	/** Work of most recently presented frame. */
+	RenderStats frame_stats;
+	/** Work of all presented frames. */
+	RenderStats total_stats;
+	/** Number of presented frames. */
+	uint64_t frames;
+	/** Texture of previous copy. */
+	SDL_Texture* bound;
 
 public:
 	Renderer();
@@ -47,7 +97,6 @@ public:
 	~Renderer() {
 		SDL_DestroyRenderer(internal);
 		internal = nullptr;
-		clearState();
 	}
 
 	/** Clears current rendering target with drawing color. */
@@ -56,10 +105,18 @@ public:
 	/** Updates display with any rendering performed since previous call. */
 	void present();
 
-	/** Saves renderer state. */
+	/**
+	 * Sets texture drawing operations are performed on.
+	 *
+	 * @param texture
+	 *   Texture created with `SDL_TEXTUREACCESS_TARGET` or `nullptr` for window.
+	 */
+	void setTarget(SDL_Texture* texture);
+
+	/** Saves draw color & blend mode onto state stack. */
 	void save();
 
-	/** Restores renderer to saved state. */
+	/** Restores draw color & blend mode most recently saved. */
 	void restore();
 
 	/**
@@ -242,7 +299,12 @@ public:
 	 * @return
 	 *   Scaling factor.
 	 */
-	uint16_t getScale();
+	uint16_t getScale() { return scale; }
+
+	/**
+	 * Refreshes cached window size. Must be called when window is resized.
+	 */
+	void updateSize();
 
 	/**
 	 * Retrieves viewport renderer pixel width.
@@ -250,7 +312,7 @@ public:
 	 * @return
 	 *   Actual pixel width.
 	 */
-	uint32_t getWidth();
+	uint32_t getWidth() { return width; }
 
 	/**
 	 * Retrieves viewport renderer pixel height.
@@ -258,7 +320,7 @@ public:
 	 * @return
 	 *   Actual pixel height.
 	 */
-	uint32_t getHeight();
+	uint32_t getHeight() { return height; }
 
 	/**
 	 * Retrieves viewport renderer internal pixel width.
@@ -266,7 +328,7 @@ public:
 	 * @return
 	 *   Internal unscaled width.
 	 */
-	uint32_t getInternalWidth();
+	uint32_t getInternalWidth() { return width / scale; }
 
 	/**
 	 * Retrieves viewport renderer internal pixel height.
@@ -274,11 +336,13 @@ public:
 	 * @return
 	 *   Internal unscaled height.
 	 */
-	uint32_t getInternalHeight();
+	uint32_t getInternalHeight() { return height / scale; }
 
 	/**
 	 * Sets blend mode used for drawing operations.
 	 *
+	 * Internal renderer is not updated if mode is unchanged.
+	 *
 	 * @param blend_mode
 	 *   Blend mode to use.
 	 */
@@ -287,6 +351,8 @@ public:
 	/**
 	 * Sets color used for drawing operations.
 	 *
+	 * Internal renderer is not updated if color is unchanged.
+	 *
 	 * @param r
 	 *   Color's red value.
 	 * @param g
@@ -324,7 +390,7 @@ public:
 	 * @return
 	 *   RGBA drawing color.
 	 */
-	SDL_Color getDrawColor();
+	SDL_Color getDrawColor() { return current.color; }
 
 	/**
 	 * Creates a texture from surface.
@@ -336,6 +402,30 @@ public:
 	 */
 	SDL_Texture* textureFromSurface(SDL_Surface* surface);
 
+	/**
+	 * Creates a texture with pixels that can be updated frequently.
+	 *
+	 * @param width
+	 *   Texture pixel width.
+	 * @param height
+	 *   Texture pixel height.
+	 * @return
+	 *   New texture in ARGB8888 format.
+	 */
+	SDL_Texture* createStreamingTexture(int32_t width, int32_t height);
+
+	/**
+	 * Creates a texture that can be used as rendering target.
+	 *
+	 * @param width
+	 *   Texture pixel width.
+	 * @param height
+	 *   Texture pixel height.
+	 * @return
+	 *   New texture in RGBA32 format.
+	 */
+	SDL_Texture* createTargetTexture(int32_t width, int32_t height);
+
 	/**
 	 * Creates a texture from filesystem resource.
 	 *
@@ -346,14 +436,33 @@ public:
 	 */
 	SDL_Texture* textureFromPath(std::string path);
 
-private:
-	/** Clears saved state. */
-	void clearState() {
-		if (state) {
-			delete state;
-			state = nullptr;
-		}
-	}
+	/**
+	 * Retrieves work of most recently presented frame.
+	 */
+	const RenderStats& getFrameStats() { return frame_stats; }
+
+	/**
+	 * Retrieves work of all presented frames.
+	 */
+	const RenderStats& getTotalStats() { return total_stats; }
+
+	/**
+	 * Retrieves number of presented frames.
+	 */
+	uint64_t getFrameCount() { return frames; }
+
+	/**
+	 * Formats work of most recently presented frame for on-screen display.
+	 */
+	std::string getSummary();
+
+	/**
+	 * Writes mean work per presented frame as JSON.
+	 *
+	 * @param out
+	 *   Output stream.
+	 */
+	void writeJson(std::ostream& out);
 };
 
 #endif /* RRE_RENDERER */
@@ -7,7 +7,11 @@
 #ifndef RRE_SCENE
 #define RRE_SCENE
 
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr
 #include <string>
+#include <unordered_map>
+#include <utility> // std::move
 #include <vector>
 
 #include <SDL2/SDL_rect.h>
@@ -18,10 +22,31 @@
 #include "ParallaxImage.hpp"
 #include "Player.hpp"
 #include "Renderer.hpp"
+#include "SceneChunk.hpp"
 #include "Tileset.hpp"
+#include "enum/SceneLayer.hpp"
 #include "impl/SceneImpl.hpp"
 
 
+/**
+ * Estimated memory held by scene data.
+ */
+struct SceneMemory {
+	/** Tileset, parallax & weather textures. */
+	size_t textures = 0;
+	/** Tile layer definitions including streamed chunks. */
+	size_t tile_layers = 0;
+	/** Collision map including streamed chunks. */
+	size_t collision = 0;
+	/** Properties of objects & player. */
+	size_t properties = 0;
+	/** Number of objects including player. */
+	uint32_t objects = 0;
+
+	/** Retrieves total byte count. */
+	size_t total() const { return textures + tile_layers + collision + properties; }
+};
+
 /**
  * Class to represent a scene being drawn on the viewport.
  *
@@ -37,7 +62,7 @@
  */
 class Scene: public SceneImpl {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	uint32_t width;
 	uint32_t height;
@@ -52,7 +77,7 @@ private:
 	/** Drawing offset on vertical axis. */
 	int32_t offset_y = 0;
 
-	/** Collision mappings defined by collision layer. */
+	/** Collision mappings defined by collision layer (indexed by tile column, then row). */
 	std::vector<std::vector<uint8_t>> collision_map;
 
 	/** Scene tilesets. */
@@ -63,16 +88,34 @@ private:
 	/** Parallax scrolling background layer 2. */
 	ParallaxImage* s_background2;
 
-	/** Bottom tiled layer. */
-	LayerDefinition background;
-	/** Terrain layer drawn under entities. */
-	LayerDefinition terrain;
-	/** Entities located in scene. */
-	LayerDefinition objects_layer;
-	/** Terrain layer containing collision info. */
-	LayerDefinition collision;
-	/** Top tiled layer drawn over entities. */
-	LayerDefinition foreground;
+	/**
+	 * Tile layers indexed by `SceneLayer::Id`.
+	 *
+	 * - background: bottom tiled layer
+	 * - terrain: terrain layer drawn under entities
+	 * - objects: entities located in scene
+	 * - collision: terrain layer containing collision info
+	 * - foreground: top tiled layer drawn over entities
+	 *
+	 * Unused when scene is streamed.
+	 */
+	TileLayer layers[SceneLayer::COUNT];
+
+	/** Precompiled scene data referenced by tile layers. */
+	std::shared_ptr<const void> mapped_data;
+
+	/** Source of tile data when scene is streamed. */
+	std::unique_ptr<ChunkSource> chunk_source;
+	/** Chunks currently loaded around view when scene is streamed. */
+	std::unordered_map<uint64_t, SceneChunk> chunks;
+	/** Number of chunks kept loaded beyond view in each direction. */
+	uint32_t stream_radius;
+	/** Number of logic steps of player movement to prefetch chunks for. */
+	uint32_t prefetch_steps;
+	/** Number of loaded chunks referencing each tileset. */
+	std::vector<uint32_t> tileset_users;
+	/** Player position on previous step used to determine prefetch direction. */
+	SDL_Point player_prev;
 
 	/** Parallax scrolling foreground layer. */
 	ParallaxImage* weather;
@@ -88,6 +131,9 @@ private:
 
 	std::string music;
 
+	/** Files scene was built from (relative to data directory). */
+	std::vector<std::string> dependencies;
+
 public:
 	/**
 	 * Creates a new scene.
@@ -103,7 +149,9 @@ public:
 		this->tile_width = tile_width;
 		this->tile_height = tile_height;
 
-		collision_map = std::vector<std::vector<uint8_t>>(this->height, std::vector<uint8_t>(this->width, 0));
+		this->stream_radius = 1;
+		this->prefetch_steps = 10;
+		this->player_prev = {0, 0};
 
 		this->s_background = nullptr;
 		this->s_background2 = nullptr;
@@ -131,6 +179,15 @@ public:
 		}
 		tilesets.clear();
 
+		for (ParallaxImage* img: {s_background, s_background2, weather}) {
+			if (img != nullptr) {
+				delete img;
+			}
+		}
+		s_background = nullptr;
+		s_background2 = nullptr;
+		weather = nullptr;
+
 		// FIXME: player deletion should be handled by shutdown to prevent data loss when scene ends
 		if (player != nullptr) {
 			delete player;
@@ -146,6 +203,7 @@ public:
 	 */
 	void addTileset(Tileset* tileset) {
 		this->tilesets.push_back(tileset);
+		this->tileset_users.push_back(0);
 	}
 
 	/** Called every game logic step. */
@@ -168,10 +226,119 @@ public:
 	 *
 	 * @param ctx
 	 *   Rendering target context.
-	 * @param gids
-	 *   Layer definition.
+	 * @param layer
+	 *   Tile layer.
+	 */
+	void renderTileLayer(Renderer* ctx, const TileLayer& layer);
+
+	/**
+	 * Draws a tile layer of loaded chunks within view.
+	 *
+	 * @param ctx
+	 *   Rendering target context.
+	 * @param layer
+	 *   Layer to draw.
+	 */
+	void renderChunks(Renderer* ctx, SceneLayer::Id layer);
+
+	/**
+	 * Draws a single tile.
+	 *
+	 * @param ctx
+	 *   Rendering target context.
+	 * @param gid
+	 *   Tile global ID.
+	 * @param x
+	 *   Horizontal pixel position on viewport.
+	 * @param y
+	 *   Vertical pixel position on viewport.
+	 */
+	void drawTile(Renderer* ctx, uint32_t gid, int32_t x, int32_t y);
+
+	/**
+	 * Sets source of tile data & enables streaming.
+	 *
+	 * Tile layers are loaded in chunks around the view instead of being held for the whole scene.
+	 *
+	 * @param source
+	 *   Chunk data source.
+	 */
+	void setChunkSource(std::unique_ptr<ChunkSource> source) { chunk_source = std::move(source); }
+
+	/** Overrides `SceneImpl::isStreamed`. */
+	bool isStreamed() override { return chunk_source != nullptr; }
+
+	/**
+	 * Sets number of chunks kept loaded beyond view in each direction.
+	 *
+	 * @param radius
+	 *   Chunk count.
+	 */
+	void setStreamRadius(uint32_t radius) { stream_radius = radius; }
+
+	/**
+	 * Sets how far ahead of player movement chunks are loaded.
+	 *
+	 * @param steps
+	 *   Number of game logic steps at current player speed.
+	 */
+	void setPrefetchSteps(uint32_t steps) { prefetch_steps = steps; }
+
+	/**
+	 * Loads chunks within stream radius & prefetch distance & evicts chunks out of range.
 	 */
-	void renderTileLayer(Renderer* ctx, LayerDefinition ldef);
+	void updateChunks();
+
+	/**
+	 * Retrieves a chunk of a streamed scene.
+	 *
+	 * @param cx
+	 *   Horizontal chunk index.
+	 * @param cy
+	 *   Vertical chunk index.
+	 * @param load
+	 *   If `true`, chunk is loaded from source if not already loaded.
+	 * @return
+	 *   Chunk or `null` if not loaded.
+	 */
+	SceneChunk* getChunk(int32_t cx, int32_t cy, bool load);
+
+	/**
+	 * Releases tilesets used by a chunk that is being evicted.
+	 *
+	 * @param chunk
+	 *   Chunk to be evicted.
+	 */
+	void releaseChunk(SceneChunk& chunk);
+
+	/**
+	 * Checks if a tile is solid.
+	 *
+	 * @param x
+	 *   Tile column.
+	 * @param y
+	 *   Tile row.
+	 * @return
+	 *   `true` if collision layer has a tile at position or position is in a chunk that is not
+	 *   loaded.
+	 */
+	bool isCollision(int32_t x, int32_t y);
+
+	/**
+	 * Estimates memory held by scene data.
+	 *
+	 * Includes tileset & image layer textures, tile layer definitions, collision map & object
+	 * properties.
+	 *
+	 * @return
+	 *   Byte count.
+	 */
+	size_t getMemoryUsage() { return getMemoryBreakdown().total(); }
+
+	/**
+	 * Estimates memory held by scene data by category.
+	 */
+	SceneMemory getMemoryBreakdown();
 
 	/** Overrides `SceneImpl::getWidth`. */
 	uint32_t getWidth() override { return width; }
@@ -213,7 +380,7 @@ public:
 	 * @param layer
 	 *   Tile layer definition.
 	 */
-	void setLayerBackground(LayerDefinition ldef) { background = ldef; };
+	void setLayerBackground(TileLayer layer) { layers[SceneLayer::BACKGROUND] = std::move(layer); }
 
 	/**
 	 * Sets layer to use for terrain.
@@ -221,7 +388,7 @@ public:
 	 * @param layer
 	 *   Tile layer definition.
 	 */
-	void setLayerTerrain(LayerDefinition ldef) { terrain = ldef; }
+	void setLayerTerrain(TileLayer layer) { layers[SceneLayer::TERRAIN] = std::move(layer); }
 
 	/**
 	 * Sets layer to use for objects.
@@ -229,15 +396,18 @@ public:
 	 * @param layer
 	 *   Tile layer definition.
 	 */
-	void setLayerObjects(LayerDefinition ldef) { objects_layer = ldef; }
+	void setLayerObjects(TileLayer layer) { layers[SceneLayer::OBJECTS] = std::move(layer); }
 
 	/**
 	 * Sets layer to use for collision.
 	 *
 	 * @param layer
 	 *   Tile layer definition.
+	 * @param bits
+	 *   Optional precompiled collision bitset (1 bit per tile, row-major). If `null`, collision
+	 *   points are determined from layer tiles.
 	 */
-	void setLayerCollision(LayerDefinition ldef);
+	void setLayerCollision(TileLayer layer, const uint8_t* bits=nullptr);
 
 	/**
 	 * Sets layer to use for foreground.
@@ -245,7 +415,42 @@ public:
 	 * @param layer
 	 *   Tile layer definition.
 	 */
-	void setLayerForeground(LayerDefinition ldef) { foreground = ldef; }
+	void setLayerForeground(TileLayer layer) { layers[SceneLayer::FOREGROUND] = std::move(layer); }
+
+	/**
+	 * Keeps precompiled scene data alive while layers reference it.
+	 *
+	 * @param data
+	 *   Object owning scene blob memory.
+	 */
+	void setMappedData(std::shared_ptr<const void> data) { mapped_data = data; }
+
+	/**
+	 * Registers a file scene was built from.
+	 *
+	 * @param path
+	 *   Path relative to data directory.
+	 */
+	void addDependency(std::string path) { dependencies.push_back(path); }
+
+	/**
+	 * Checks if scene was built from a file.
+	 *
+	 * @param path
+	 *   Path relative to data directory.
+	 */
+	bool dependsOn(const std::string& path);
+
+	/**
+	 * Exchanges map data (dimensions, tilesets, layers, collision & music) with another scene.
+	 *
+	 * Objects, player & view offset are kept so that a reloaded map can replace data of a scene in
+	 * use.
+	 *
+	 * @param other
+	 *   Scene with new map data.
+	 */
+	void swapMap(Scene& other);
 
 	/**
 	 * Sets layer to use for scrolling foreground.
@@ -261,7 +466,11 @@ public:
 	 * @param x
 	 * @param y
 	 */
-	void setCollisionPoint(uint32_t x, uint32_t y) { collision_map[x][y] = 1; }
+	void setCollisionPoint(uint32_t x, uint32_t y) {
+		if (x < collision_map.size() && y < collision_map[x].size()) {
+			collision_map[x][y] = 1;
+		}
+	}
 
 	/**
 	 * Sets music to be played in this scene.
@@ -0,0 +1,323 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_SCENE_BLOB
+#define RRE_SCENE_BLOB
+
+#include <cstddef> // size_t
+#include <cstdint> // *int*_t
+#include <memory> // std::shared_ptr
+#include <span>
+#include <string>
+
+#include "LayerDefinition.hpp"
+
+
+/**
+ * Precompiled binary scene format.
+ *
+ * Blobs are generated from TMX maps by `rre-scenec` & stored alongside source map with extension
+ * `.tmxb`. All offsets are relative to start of blob. Tile arrays are stored in `TileDefinition`
+ * layout so that they can be referenced in place from mapped memory.
+ *
+ * Layout:
+ * - header
+ * - tileset records
+ * - image layer records
+ * - property records
+ * - tile arrays (8 byte aligned)
+ * - tile layer records
+ * - chunk records
+ * - collision bitset (1 bit per tile, row-major)
+ * - string table (null-terminated strings)
+ *
+ * Chunked blobs (infinite maps or maps compiled with a chunk size) store tile layers as fixed size
+ * chunks referenced by chunk records instead of a single array per layer & don't include a
+ * collision bitset. Empty chunks are omitted.
+ *
+ * NOTE: blobs use native byte order & are not portable between architectures
+ */
+namespace SceneBlob {
+	/** Blob file identifier. */
+	const char MAGIC[4] = {'R', 'R', 'S', 'B'};
+	/** Format version. Blobs of other versions are considered stale. */
+	const uint32_t VERSION = 2;
+	/** Marker used to detect byte order mismatch. */
+	const uint32_t ENDIAN_MARKER = 0x01020304;
+
+	/** Offset into string table representing no value. */
+	const uint32_t NO_STRING = UINT32_MAX;
+
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t byte_order;
+		uint32_t reserved;
+		/** Modification time of source TMX when blob was compiled. */
+		int64_t source_mtime;
+		/** Size of source TMX when blob was compiled. */
+		uint64_t source_size;
+		/** Scene pixel width. */
+		uint32_t width;
+		/** Scene pixel height. */
+		uint32_t height;
+		uint32_t tile_width;
+		uint32_t tile_height;
+		uint32_t tileset_count;
+		uint32_t image_layer_count;
+		uint32_t tile_layer_count;
+		uint32_t property_count;
+		uint64_t tilesets_offset;
+		uint64_t image_layers_offset;
+		uint64_t tile_layers_offset;
+		uint64_t properties_offset;
+		uint64_t collision_offset;
+		uint64_t collision_size;
+		uint64_t strings_offset;
+		uint64_t strings_size;
+		/** Chunk width in tiles (0 if blob is not chunked). */
+		uint32_t chunk_width;
+		/** Chunk height in tiles (0 if blob is not chunked). */
+		uint32_t chunk_height;
+		uint32_t chunk_count;
+		uint32_t reserved2;
+		uint64_t chunks_offset;
+	};
+
+	struct TilesetRecord {
+		uint32_t first_gid;
+		uint32_t last_gid;
+		/** Image path relative to source TMX directory. */
+		uint32_t image;
+		uint32_t reserved;
+	};
+
+	struct ImageLayerRecord {
+		uint32_t name;
+		/** Image path relative to source TMX directory. */
+		uint32_t image;
+		float scroll_rate;
+		uint32_t reserved;
+	};
+
+	struct TileLayerRecord {
+		uint32_t name;
+		uint32_t tile_count;
+		uint64_t tiles_offset;
+	};
+
+	struct ChunkRecord {
+		/** Horizontal chunk index. */
+		int32_t x;
+		/** Vertical chunk index. */
+		int32_t y;
+		/** Index of tile layer record. */
+		uint32_t layer;
+		uint32_t reserved;
+		/** Offset of `chunk_width * chunk_height` tiles. */
+		uint64_t tiles_offset;
+	};
+
+	/** Property types. */
+	enum PropertyType: uint32_t {
+		STRING = 0,
+		BOOLEAN,
+		INT,
+		FLOAT
+	};
+
+	struct PropertyRecord {
+		uint32_t name;
+		uint32_t type;
+		/** Value for string type properties. */
+		uint32_t str_value;
+		union {
+			int32_t i_value;
+			float f_value;
+		};
+	};
+
+	/**
+	 * Determines blob path for a TMX map.
+	 *
+	 * @param tmx_path
+	 *   Path to source map.
+	 * @return
+	 *   Path to compiled blob.
+	 */
+	std::string getBlobPath(const std::string& tmx_path);
+
+	/**
+	 * Compiles a TMX map to binary blob.
+	 *
+	 * @param tmx_path
+	 *   Path to source map.
+	 * @param blob_path
+	 *   Path to output blob.
+	 * @param chunk_size
+	 *   Width & height in tiles of chunks to split tile layers into. If 0, only infinite maps are
+	 *   chunked (using `SceneChunks::DEFAULT_SIZE`).
+	 * @param error
+	 *   Set to error message on failure.
+	 * @return
+	 *   `true` if blob was written.
+	 */
+	bool compile(const std::string& tmx_path, const std::string& blob_path, uint32_t chunk_size,
+			std::string& error);
+
+	/**
+	 * Read access to a memory mapped blob.
+	 */
+	class Reader {
+	private:
+		/** Keeps blob data alive. */
+		std::shared_ptr<const void> owner;
+		const uint8_t* data;
+		size_t size;
+		const Header* header;
+
+		/**
+		 * Retrieves a record array from blob.
+		 *
+		 * @param offset
+		 *   Position of first record.
+		 * @param count
+		 *   Number of records.
+		 */
+		template<typename T>
+		std::span<const T> getArray(uint64_t offset, uint32_t count) const {
+			return std::span<const T>(reinterpret_cast<const T*>(data + offset), count);
+		}
+
+	public:
+		/** Default constructor. */
+		Reader(): data(nullptr), size(0), header(nullptr) {}
+
+		/**
+		 * Maps & validates a blob.
+		 *
+		 * @param blob_path
+		 *   Path to compiled blob.
+		 * @param tmx_path
+		 *   Path to source map used to check if blob is stale.
+		 * @param error
+		 *   Set to reason blob cannot be used on failure.
+		 * @return
+		 *   `true` if blob is valid & up to date with source map.
+		 */
+		bool open(const std::string& blob_path, const std::string& tmx_path, std::string& error);
+
+		/**
+		 * Validates a blob already in memory.
+		 *
+		 * Does not check if blob is stale (see `isStale`).
+		 *
+		 * @param owner
+		 *   Object keeping `data` alive.
+		 * @param data
+		 *   Start of blob (must be 8 byte aligned).
+		 * @param size
+		 *   Byte count of blob.
+		 * @param error
+		 *   Set to reason blob cannot be used on failure.
+		 * @return
+		 *   `true` if blob is valid.
+		 */
+		bool open(std::shared_ptr<const void> owner, const uint8_t* data, size_t size,
+				std::string& error);
+
+		/**
+		 * Checks if source map changed since blob was compiled.
+		 *
+		 * @param source_mtime
+		 *   Current modification time of source map.
+		 * @param source_size
+		 *   Current byte count of source map.
+		 */
+		bool isStale(int64_t source_mtime, uint64_t source_size) const {
+			return source_mtime != header->source_mtime || source_size != header->source_size;
+		}
+
+		/**
+		 * Retrieves object backing blob data.
+		 *
+		 * Must be kept alive while any returned arrays are in use.
+		 */
+		std::shared_ptr<const void> getOwner() const { return owner; }
+
+		const Header& getHeader() const { return *header; }
+
+		std::span<const TilesetRecord> getTilesets() const {
+			return getArray<TilesetRecord>(header->tilesets_offset, header->tileset_count);
+		}
+
+		std::span<const ImageLayerRecord> getImageLayers() const {
+			return getArray<ImageLayerRecord>(header->image_layers_offset, header->image_layer_count);
+		}
+
+		std::span<const TileLayerRecord> getTileLayers() const {
+			return getArray<TileLayerRecord>(header->tile_layers_offset, header->tile_layer_count);
+		}
+
+		std::span<const PropertyRecord> getProperties() const {
+			return getArray<PropertyRecord>(header->properties_offset, header->property_count);
+		}
+
+		std::span<const ChunkRecord> getChunks() const {
+			return getArray<ChunkRecord>(header->chunks_offset, header->chunk_count);
+		}
+
+		/**
+		 * Checks if tile layers are split into chunks.
+		 */
+		bool isChunked() const { return header->chunk_width > 0 && header->chunk_height > 0; }
+
+		/**
+		 * Retrieves tiles of a chunk in place.
+		 *
+		 * @param chunk
+		 *   Chunk record.
+		 */
+		std::span<const TileDefinition> getTiles(const ChunkRecord& chunk) const {
+			return getArray<TileDefinition>(chunk.tiles_offset, header->chunk_width * header->chunk_height);
+		}
+
+		/**
+		 * Retrieves tiles of a layer in place.
+		 *
+		 * @param layer
+		 *   Tile layer record.
+		 */
+		std::span<const TileDefinition> getTiles(const TileLayerRecord& layer) const {
+			return getArray<TileDefinition>(layer.tiles_offset, layer.tile_count);
+		}
+
+		/**
+		 * Retrieves collision bitset.
+		 *
+		 * @return
+		 *   Bits in row-major tile order or `null` if scene has no collision layer.
+		 */
+		const uint8_t* getCollision() const {
+			if (header->collision_size == 0) {
+				return nullptr;
+			}
+			return data + header->collision_offset;
+		}
+
+		/**
+		 * Retrieves a string from string table.
+		 *
+		 * @param offset
+		 *   String table offset.
+		 * @return
+		 *   String or empty string if `offset` is `NO_STRING`.
+		 */
+		std::string getString(uint32_t offset) const;
+	};
+};
+
+#endif /* RRE_SCENE_BLOB */
@@ -0,0 +1,147 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_SCENE_CHUNK
+#define RRE_SCENE_CHUNK
+
+#include <cstdint> // *int*_t
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "LayerDefinition.hpp"
+#include "enum/SceneLayer.hpp"
+
+
+/**
+ * Block of scene tiles loaded & evicted as a unit when a scene is streamed.
+ */
+struct SceneChunk {
+	/** Tile layers indexed by `SceneLayer::Id`. Empty if layer has no tiles in chunk. */
+	TileLayer layers[SceneLayer::COUNT];
+	/** Collision flags in row-major tile order. */
+	std::vector<uint8_t> collision;
+	/** Indexes of scene tilesets referenced by chunk tiles. */
+	std::vector<uint32_t> tilesets;
+};
+
+/**
+ * Tile data of a single layer split into fixed size chunks.
+ *
+ * Each chunk is stored in row-major order. Keys are created with `SceneChunks::getKey`.
+ */
+typedef std::unordered_map<uint64_t, LayerDefinition> ChunkedLayer;
+
+
+namespace SceneChunks {
+	/** Chunk width & height in tiles used for infinite maps (matches Tiled's chunk size). */
+	const uint32_t DEFAULT_SIZE = 16;
+
+	/**
+	 * Creates map key for a chunk position.
+	 *
+	 * @param cx
+	 *   Horizontal chunk index.
+	 * @param cy
+	 *   Vertical chunk index.
+	 */
+	inline uint64_t getKey(int32_t cx, int32_t cy) {
+		return ((uint64_t) (uint32_t) cx << 32) | (uint32_t) cy;
+	}
+
+	/**
+	 * Divides rounding towards negative infinity so that negative tile positions map to correct
+	 * chunk.
+	 */
+	inline int32_t floorDiv(int32_t value, int32_t divisor) {
+		int32_t res = value / divisor;
+		return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? res - 1 : res;
+	}
+
+	/**
+	 * Splits a region of layer tiles into chunks.
+	 *
+	 * Empty tiles are skipped so chunks without any tiles are never created.
+	 *
+	 * @param layer
+	 *   Chunks to add tiles to.
+	 * @param tiles
+	 *   Region tiles in row-major order.
+	 * @param x
+	 *   Tile position of left side of region.
+	 * @param y
+	 *   Tile position of top side of region.
+	 * @param width
+	 *   Region width in tiles.
+	 * @param chunk_width
+	 *   Chunk width in tiles.
+	 * @param chunk_height
+	 *   Chunk height in tiles.
+	 */
+	void split(ChunkedLayer& layer, std::span<const TileDefinition> tiles, int32_t x, int32_t y,
+			uint32_t width, uint32_t chunk_width, uint32_t chunk_height);
+
+	/**
+	 * Determines layer ID from TMX layer name.
+	 *
+	 * @param name
+	 *   Layer name.
+	 * @return
+	 *   Layer ID or `SceneLayer::COUNT` if name is unknown.
+	 */
+	SceneLayer::Id getLayerId(const std::string& name);
+};
+
+
+/**
+ * Provides tile data for streamed scenes.
+ */
+class ChunkSource {
+public:
+	/** Virtual default destructor. */
+	virtual ~ChunkSource() {}
+
+	/**
+	 * Retrieves chunk width.
+	 *
+	 * @return
+	 *   Width in tiles.
+	 */
+	virtual uint32_t getChunkWidth() = 0;
+
+	/**
+	 * Retrieves chunk height.
+	 *
+	 * @return
+	 *   Height in tiles.
+	 */
+	virtual uint32_t getChunkHeight() = 0;
+
+	/**
+	 * Retrieves tile data of a chunk.
+	 *
+	 * @param cx
+	 *   Horizontal chunk index.
+	 * @param cy
+	 *   Vertical chunk index.
+	 * @param chunk
+	 *   Chunk to set tile layers of.
+	 * @return
+	 *   `false` if world has no tiles at chunk position.
+	 */
+	virtual bool loadChunk(int32_t cx, int32_t cy, SceneChunk& chunk) = 0;
+
+	/**
+	 * Estimates heap memory held by source.
+	 *
+	 * @return
+	 *   Byte count of tile data kept in memory (0 if data is mapped from file).
+	 */
+	virtual size_t getByteSize() { return 0; }
+};
+
+#endif /* RRE_SCENE_CHUNK */
@@ -0,0 +1,60 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_SOUND_PLAYER
+#define RRE_SOUND_PLAYER
+
+#include <cstdint> // *int*_t
+
+#include "store/AudioStore.hpp"
+
+
+/**
+ * Plays sound effects on a fixed pool of mixer channels.
+ *
+ * Playing a sound doesn't allocate memory or access files. Voices are limited so that many
+ * simultaneous triggers can't overrun the mixer:
+ * - a sound triggered more than once in the same frame is played once
+ * - a sound playing `SoundEffect::max_voices` times restarts its oldest instance
+ * - when all channels are busy the oldest sound with lowest priority is stopped, unless it has
+ *   higher priority than the new sound in which case the new sound is dropped
+ */
+namespace SoundPlayer {
+	/** Default number of mixer channels. */
+	const uint8_t DEFAULT_CHANNELS = 16;
+
+	/**
+	 * Allocates mixer channels.
+	 *
+	 * Must be called after audio device is opened.
+	 *
+	 * @param channels
+	 *   Number of sounds that can play at once.
+	 */
+	void init(uint8_t channels=DEFAULT_CHANNELS);
+
+	/** Stops all sounds. */
+	void shutdown();
+
+	/**
+	 * Plays a sound effect.
+	 *
+	 * @param id
+	 *   Interned sound identifier (see `AudioStore::getSoundId`).
+	 * @return
+	 *   Channel sound is played on or -1 if sound was not played.
+	 */
+	int32_t play(SoundId id);
+
+	/**
+	 * Starts a new frame for detecting duplicate triggers.
+	 *
+	 * Called from game loop.
+	 */
+	void update();
+};
+
+#endif /* RRE_SOUND_PLAYER */
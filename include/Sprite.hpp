@@ -23,7 +23,7 @@
  */
 class Sprite: public Image {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	/** Timestamp at which this sprite should no longer be drawn on renderer. */
 	uint32_t expires = 0;
@@ -96,6 +96,16 @@ public:
 		return this->expires != 0 && SDL_GetTicks64() >= this->expires;
 	}
 
+	/**
+	 * Exchanges texture & tile data with another sprite.
+	 *
+	 * Used to update a shared sprite in place when its definition changes.
+	 *
+	 * @param other
+	 *   Sprite of same type.
+	 */
+	virtual void swap(Sprite& other);
+
 	/**
 	 * Updates tile index to be drawn.
 	 *
@@ -109,16 +119,17 @@ public:
 	 *
 	 * @param id
 	 */
-	virtual void setMode(std::string id) {
+	virtual void setMode(const std::string& id) {
 		// does nothing in this implemention
 	}
 
 	/**
 	 * Returns empty string in this implementation. Inheriting classes can override.
 	 */
-	virtual std::string getModeId() {
+	virtual const std::string& getModeId() {
 		// returns empty string in this implementation
-		return "";
+		static const std::string none;
+		return none;
 	}
 
 	/**
@@ -0,0 +1,53 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_STARTUP_BENCH
+#define RRE_STARTUP_BENCH
+
+#include <cstdint> // *int*_t
+#include <string>
+
+
+/**
+ * Startup benchmark.
+ *
+ * Engine is launched repeatedly as a child process, each run loading game data through first frame
+ * & time to interactive before exiting. A cold run is made with engine caches cleared followed by a
+ * warm run reusing caches written by cold run. Per-phase medians are printed to stdout as JSON.
+ *
+ * NOTE: cold runs do not drop operating system file cache
+ */
+namespace StartupBench {
+	/** Default number of cold/warm run pairs. */
+	const uint32_t DEFAULT_RUNS = 5;
+
+	/**
+	 * Runs benchmark & prints results.
+	 *
+	 * @param runs
+	 *   Number of cold/warm run pairs.
+	 * @param data_path
+	 *   Absolute path to game data passed to child processes (empty for default).
+	 * @return
+	 *   Process exit code.
+	 */
+	int run(uint32_t runs, std::string data_path);
+
+	/**
+	 * Executes a single benchmark run in child process.
+	 *
+	 * Called after critical game data is loaded. Draws first frame, loads remaining data & enters
+	 * scene mode, then writes measurements.
+	 *
+	 * @param output
+	 *   File measurements are written to.
+	 * @return
+	 *   Process exit code.
+	 */
+	int runChild(std::string output);
+};
+
+#endif /* RRE_STARTUP_BENCH */
@@ -0,0 +1,140 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_STARTUP_METRICS
+#define RRE_STARTUP_METRICS
+
+#include <cstdint> // *int*_t
+#include <string>
+#include <vector>
+
+#include "Trace.hpp"
+
+
+/** Accumulated measurements of a startup phase. */
+struct StartupPhase {
+	std::string name;
+	/** Total time in microseconds. */
+	uint64_t time;
+	/** Total bytes processed. */
+	uint64_t bytes;
+	/** Number of times phase was entered. */
+	uint32_t count;
+};
+
+/**
+ * Measures startup milestones relative to process start.
+ *
+ * - time to first frame: first viewport frame presented
+ * - time to interactive: all queued game data loaded
+ *
+ * Time spent in instrumented phases (see `StartupScope`) is accumulated by phase name.
+ */
+namespace StartupMetrics {
+
+	/** Marks process start. Must be called first thing in `main`. */
+	void begin();
+
+	/**
+	 * Retrieves time elapsed since process start.
+	 *
+	 * @return
+	 *   Elapsed time in microseconds.
+	 */
+	uint64_t elapsed();
+
+	/** Records time to first frame. Only first call has an effect. */
+	void markFirstFrame();
+
+	/** Records time to interactive. Only first call has an effect. */
+	void markInteractive();
+
+	/**
+	 * Retrieves time to first frame.
+	 *
+	 * @return
+	 *   Time in microseconds or 0 if no frame has been presented.
+	 */
+	uint64_t getTimeToFirstFrame();
+
+	/**
+	 * Retrieves time to interactive.
+	 *
+	 * @return
+	 *   Time in microseconds or 0 if game data is still loading.
+	 */
+	uint64_t getTimeToInteractive();
+
+	/**
+	 * Adds a measurement to a phase.
+	 *
+	 * @param name
+	 *   Phase name (must remain valid, normally a literal).
+	 * @param time
+	 *   Time in microseconds.
+	 * @param bytes
+	 *   Bytes processed.
+	 */
+	void record(const char* name, uint64_t time, uint64_t bytes);
+
+	/**
+	 * Retrieves accumulated phases.
+	 *
+	 * @return
+	 *   Phases in order first recorded.
+	 */
+	const std::vector<StartupPhase>& getPhases();
+
+	/**
+	 * Writes milestones & phases to a file.
+	 *
+	 * Each line contains tab separated name, time (microseconds), bytes & count. Milestones are
+	 * written first with names `ttff` & `tti`.
+	 *
+	 * @param path
+	 *   Output file path.
+	 * @return
+	 *   `true` if file was written.
+	 */
+	bool writePhases(const std::string& path);
+};
+
+
+/**
+ * Records time spent in a scope as a startup phase & trace zone.
+ */
+class StartupScope {
+private:
+	const char* name;
+	uint64_t start;
+	uint64_t bytes;
+	TraceZone zone;
+
+public:
+	/**
+	 * Starts measuring a phase.
+	 *
+	 * @param name
+	 *   Phase name (must remain valid, normally a literal).
+	 */
+	StartupScope(const char* name): name(name), start(StartupMetrics::elapsed()), bytes(0),
+			zone(name) {}
+
+	~StartupScope() { StartupMetrics::record(name, StartupMetrics::elapsed() - start, bytes); }
+
+	StartupScope(const StartupScope&) = delete;
+	StartupScope& operator=(const StartupScope&) = delete;
+
+	/**
+	 * Adds to bytes processed in phase.
+	 *
+	 * @param count
+	 *   Byte count.
+	 */
+	void addBytes(uint64_t count) { bytes += count; }
+};
+
+#endif /* RRE_STARTUP_METRICS */
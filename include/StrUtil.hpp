@@ -89,7 +89,7 @@ namespace StrUtil {
 	 * @return
 	 *   Parse result with error message.
 	 */
-	ParseResult parseShort(int16_t& s, std::string st);
+	ParseResult parseShort(int16_t& s, const std::string& st);
 
 	/**
 	 * Parses unsigned short value from a string.
@@ -100,7 +100,7 @@ namespace StrUtil {
 	 * @return
 	 *   Parse result with error message.
 	 */
-	ParseResult parseUShort(uint16_t& s, std::string st);
+	ParseResult parseUShort(uint16_t& s, const std::string& st);
 
 	/**
 	 * Parses integer value from a string.
@@ -111,7 +111,7 @@ namespace StrUtil {
 	 * @return
 	 *   Parse result with error message.
 	 */
-	ParseResult parseInt(int32_t& i, std::string st);
+	ParseResult parseInt(int32_t& i, const std::string& st);
 
 	/**
 	 * Parses unsigned integer value from a string.
@@ -122,7 +122,7 @@ namespace StrUtil {
 	 * @return
 	 *   Parse result with error message.
 	 */
-	ParseResult parseUInt(uint32_t& i, std::string st);
+	ParseResult parseUInt(uint32_t& i, const std::string& st);
 
 	/**
 	 * Parses long value from a string.
@@ -133,7 +133,7 @@ namespace StrUtil {
 	 * @return
 	 *   Parse result with error message.
 	 */
-	ParseResult parseLong(int64_t& l, std::string st);
+	ParseResult parseLong(int64_t& l, const std::string& st);
 
 	/**
 	 * Parses unsigned long value from a string.
@@ -144,7 +144,7 @@ namespace StrUtil {
 	 * @return
 	 *   Parse result with error message.
 	 */
-	ParseResult parseULong(uint64_t& l, std::string st);
+	ParseResult parseULong(uint64_t& l, const std::string& st);
 
 	/**
 	 * Parses float value from a string.
@@ -155,7 +155,7 @@ namespace StrUtil {
 	 * @return
 	 *   Parse result with error message.
 	 */
-	ParseResult parseFloat(float& f, std::string st);
+	ParseResult parseFloat(float& f, const std::string& st);
 
 	/**
 	 * Parses double value from a string.
@@ -166,7 +166,7 @@ namespace StrUtil {
 	 * @return
 	 *   Parse result with error message.
 	 */
-	ParseResult parseDouble(double& d, std::string st);
+	ParseResult parseDouble(double& d, const std::string& st);
 
 	/**
 	 * Parses boolean value from a string.
@@ -177,7 +177,7 @@ namespace StrUtil {
 	 * @return
 	 *   Parse result with error message.
 	 */
-	ParseResult parseBool(bool& b, std::string st);
+	ParseResult parseBool(bool& b, const std::string& st);
 }
 
 #endif /* RRE_STR_UTIL */
@@ -13,6 +13,8 @@
 
 #include <SDL2/SDL_render.h>
 
+#include "MemoryStats.hpp"
+
 
 /**
  * Namespace for loading PNG images into SDL textures.
@@ -55,6 +57,31 @@ namespace TextureLoader {
 	 *   Texture.
 	 */
 	SDL_Texture* loadFM(const uint8_t data[], const uint32_t data_size);
+
+	/**
+	 * Destroys a texture.
+	 *
+	 * Textures loaded here are removed from loaded texture usage. Other textures are only destroyed.
+	 *
+	 * @param texture
+	 *   Texture to destroy.
+	 */
+	void destroy(SDL_Texture* texture);
+
+	/**
+	 * Estimates memory held by a texture from its format & dimensions.
+	 *
+	 * @param texture
+	 *   Texture to measure.
+	 * @return
+	 *   Byte count or 0 if `texture` is `nullptr`.
+	 */
+	size_t getByteSize(SDL_Texture* texture);
+
+	/**
+	 * Retrieves memory held by loaded textures that have not been destroyed.
+	 */
+	MemoryUsage getMemoryUsage();
 };
 
 #endif /* RRE_TEXTURE_LOADER */
@@ -8,6 +8,7 @@
 #define RRE_TILESET
 
 #include <cstdint>
+#include <string>
 
 #include "Image.hpp"
 
@@ -22,6 +23,9 @@ private:
 	/** Maximum global ID for this tileset in scene. */
 	uint32_t last_gid;
 
+	/** Image path relative to data directory for tilesets loaded on demand. */
+	std::string path;
+
 public:
 	/**
 	 * Tileset definition constructor.
@@ -35,6 +39,33 @@ public:
 	 */
 	Tileset(SDL_Texture* texture, uint16_t first_gid, uint16_t last_gid);
 
+	/**
+	 * Defines a tileset with texture loaded on demand.
+	 *
+	 * @param path
+	 *   Image path relative to data directory.
+	 * @param first_gid
+	 *   Global ID start.
+	 * @param last_gid
+	 *   Global ID end.
+	 */
+	Tileset(std::string path, uint32_t first_gid, uint32_t last_gid);
+
+	/**
+	 * Loads texture of a tileset defined with an image path.
+	 *
+	 * @return
+	 *   `true` if texture is ready.
+	 */
+	bool load();
+
+	/**
+	 * Frees texture of a tileset defined with an image path.
+	 *
+	 * Texture is reloaded by next call to `Tileset.load`.
+	 */
+	void unload();
+
 	/**
 	 * Retrieves global ID start index.
 	 *
@@ -0,0 +1,141 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_TRACE
+#define RRE_TRACE
+
+#include <cstdint> // *int*_t
+#include <iostream>
+#include <string>
+
+#include "AllocStats.hpp"
+
+
+/**
+ * Always-on recording of timed zones for diagnosing stutters after the fact.
+ *
+ * Each thread writes zones to its own ring buffer without locking. Recent zones of all threads can
+ * be written as Chrome trace event JSON (viewable in Perfetto or `chrome://tracing`) on request or
+ * automatically when a frame exceeds the hitch budget.
+ */
+namespace Trace {
+	/** Zones retained per thread. */
+	static const uint32_t CAPACITY = 16384;
+	/** Default seconds of recent zones included in a dump. */
+	static const uint32_t DEFAULT_WINDOW = 5;
+
+	/**
+	 * Retrieves current trace time.
+	 *
+	 * @return
+	 *   Monotonic time in nanoseconds.
+	 */
+	uint64_t now();
+
+	/**
+	 * Records a completed zone on calling thread.
+	 *
+	 * @param name
+	 *   Zone name (must remain valid, normally a literal).
+	 * @param start
+	 *   Start time from `Trace::now`.
+	 * @param end
+	 *   End time from `Trace::now`.
+	 * @param allocs
+	 *   Heap allocations made in zone (written as event arguments when not zero).
+	 */
+	void record(const char* name, uint64_t start, uint64_t end, const AllocCount& allocs = {});
+
+	/**
+	 * Names calling thread in trace output.
+	 *
+	 * @param name
+	 *   Thread name (must remain valid, normally a literal).
+	 */
+	void setThreadName(const char* name);
+
+	/**
+	 * Sets frame time above which recent zones are dumped automatically.
+	 *
+	 * @param ms
+	 *   Budget in milliseconds (0 disables).
+	 */
+	void setBudget(uint32_t ms);
+
+	/**
+	 * Sets span of recent zones included in a dump.
+	 *
+	 * @param seconds
+	 *   Window in seconds.
+	 */
+	void setWindow(uint32_t seconds);
+
+	/**
+	 * Sets directory dumps are written to.
+	 *
+	 * @param dir
+	 *   Output directory (default is executable directory).
+	 */
+	void setOutputDir(const std::string& dir);
+
+	/** Requests a dump at end of current frame. */
+	void requestDump();
+
+	/**
+	 * Marks end of a frame, dumping recent zones if requested or frame exceeded budget.
+	 *
+	 * Automatic dumps occur at most once per window so a dump does not include the hitch caused by
+	 * writing the previous one.
+	 */
+	void endFrame();
+
+	/**
+	 * Writes recent zones of all threads as Chrome trace event JSON.
+	 *
+	 * @param out
+	 *   Output stream.
+	 * @param reason
+	 *   Cause of dump included in trace metadata.
+	 */
+	void writeJson(std::ostream& out, const std::string& reason);
+
+	/**
+	 * Writes recent zones to a new file in output directory.
+	 *
+	 * @param reason
+	 *   Cause of dump included in trace metadata.
+	 * @return
+	 *   Path of written file or empty string if it could not be written.
+	 */
+	std::string dump(const std::string& reason);
+};
+
+
+/**
+ * Records time spent in a scope as a trace zone.
+ */
+class TraceZone {
+private:
+	const char* name;
+	uint64_t start;
+	AllocCount allocs;
+
+public:
+	/**
+	 * Starts a zone.
+	 *
+	 * @param name
+	 *   Zone name (must remain valid, normally a literal).
+	 */
+	TraceZone(const char* name): name(name), start(Trace::now()), allocs(AllocStats::get()) {}
+
+	~TraceZone() { Trace::record(name, start, Trace::now(), AllocStats::since(allocs)); }
+
+	TraceZone(const TraceZone&) = delete;
+	TraceZone& operator=(const TraceZone&) = delete;
+};
+
+#endif /* RRE_TRACE */
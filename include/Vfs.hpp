@@ -0,0 +1,149 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_VFS
+#define RRE_VFS
+
+#include <cstddef> // size_t
+#include <cstdint> // *int*_t
+#include <memory> // std::shared_ptr
+#include <string>
+#include <vector>
+
+
+/**
+ * Contents of a file read through virtual filesystem.
+ */
+struct VfsFile {
+	/** Keeps `data` alive (mapped file, archive or decompressed buffer). */
+	std::shared_ptr<const void> owner;
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+
+	/**
+	 * Checks if file was read.
+	 */
+	bool ready() const { return data != nullptr; }
+};
+
+/**
+ * File status retrieved through virtual filesystem.
+ */
+struct VfsStat {
+	/** Uncompressed byte count. */
+	uint64_t size = 0;
+	/** Modification time in file clock ticks. */
+	int64_t mtime = 0;
+};
+
+
+/**
+ * Virtual filesystem for game data.
+ *
+ * Either the loose data directory or a packed archive (see `Archive`) is mounted. Files are
+ * addressed by paths relative to data directory using `/` as node delimiter (e.g.
+ * "conf/game.xml"). Loose files are memory mapped on read, uncompressed archive entries
+ * reference archive mapping directly & compressed entries are decompressed on read.
+ */
+namespace Vfs {
+
+	/**
+	 * Mounts default game data.
+	 *
+	 * Uses `data.pak` in executable directory if present, otherwise `data` directory.
+	 *
+	 * @return
+	 *   `true` if data was mounted.
+	 */
+	bool mount();
+
+	/**
+	 * Mounts game data.
+	 *
+	 * @param path
+	 *   Absolute path to data directory or archive.
+	 * @return
+	 *   `true` if data was mounted.
+	 */
+	bool mount(std::string path);
+
+	/**
+	 * Unmounts game data.
+	 *
+	 * Files already read remain valid.
+	 */
+	void unmount();
+
+	/**
+	 * Checks if mounted data is a packed archive.
+	 */
+	bool isArchive();
+
+	/**
+	 * Retrieves path of mounted data.
+	 *
+	 * @return
+	 *   Absolute path to data directory or archive.
+	 */
+	std::string getMountPath();
+
+	/**
+	 * Converts path to virtual path.
+	 *
+	 * Delimiters are converted to `/`, `.` & `..` nodes are resolved & absolute paths inside
+	 * data directory are made relative to it.
+	 *
+	 * @param path
+	 *   Path to be converted.
+	 * @return
+	 *   Normalized virtual path.
+	 */
+	std::string normalize(std::string path);
+
+	/**
+	 * Checks for existing file.
+	 *
+	 * @param vpath
+	 *   Virtual path to file.
+	 */
+	bool exists(std::string vpath);
+
+	/**
+	 * Retrieves file status.
+	 *
+	 * @param vpath
+	 *   Virtual path to file.
+	 * @param st
+	 *   Set to file status.
+	 * @return
+	 *   `true` if file exists.
+	 */
+	bool stat(std::string vpath, VfsStat& st);
+
+	/**
+	 * Reads contents of a file.
+	 *
+	 * @param vpath
+	 *   Virtual path to file.
+	 * @return
+	 *   File contents (not ready if file could not be read).
+	 */
+	VfsFile read(std::string vpath);
+
+	/**
+	 * Lists files in a directory recursively.
+	 *
+	 * @param vdir
+	 *   Virtual path to directory.
+	 * @param suffix
+	 *   If not empty, only files ending with suffix are listed.
+	 * @return
+	 *   Virtual paths of files.
+	 */
+	std::vector<std::string> list(std::string vdir, std::string suffix="");
+};
+
+#endif /* RRE_VFS */
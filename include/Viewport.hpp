@@ -29,7 +29,7 @@
 class Viewport: public ViewportImpl {
 private:
 	/** Logger instance for this class. */
-	static Logger logger;
+	static Logger& logger;
 
 	/** Static singleton instance. */
 	static std::unique_ptr<Viewport> instance;
@@ -61,6 +61,20 @@ private:
 	SDL_Texture* background;
 	/** Text sprite representing RPS that can be drawn on renderer. */
 	Sprite* fps_sprite;
+	/** Text sprite representing mixer measurements. */
+	Sprite* audio_sprite;
+	/** Text sprite representing input latency measurements. */
+	Sprite* latency_sprite;
+	/** Text sprite representing renderer work of a frame. */
+	Sprite* render_sprite;
+	/** Text sprites of frame profiler statistics. */
+	std::vector<Sprite*> profiler_sprites;
+	/** Time profiler statistics were last rebuilt. */
+	uint64_t profiler_time;
+	/** Text sprites of memory page. */
+	std::vector<Sprite*> memory_sprites;
+	/** Time memory page was last rebuilt. */
+	uint64_t memory_time;
 
 	/** Currently playing movie. */
 	Movie* movie;
@@ -205,9 +219,15 @@ private:
 	/** Renders text sprites on viewport. */
 	void drawText();
 
-	/** Renders FPS text sprite on viewport. */
+	/** Renders FPS, mixer, latency & renderer text sprites on viewport. */
 	void drawFPS();
 
+	/** Renders frame profiler graph & statistics when enabled. */
+	void drawProfiler();
+
+	/** Renders memory page when enabled. */
+	void drawMemory();
+
 	/** Draws fade in/out animations on viewport renderer. */
 	void handleFade();
 };
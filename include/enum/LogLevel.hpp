@@ -0,0 +1,25 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_LOG_LEVEL
+#define RRE_LOG_LEVEL
+
+
+/** Defined logging levels. */
+enum LogLevel {
+	/** Don't output any messages (least verbose). */
+	SILENT,
+	/** Output messages up to "error" urgency level. */
+	ERROR,
+	/** Output messages up to "warning" urgency level. */
+	WARN,
+	/** Output messages up to "info" urgency level. */
+	INFO,
+	/** Output messages up to "debug" urgency level (most verbose). */
+	DEBUG
+};
+
+#endif /* RRE_LOG_LEVEL */
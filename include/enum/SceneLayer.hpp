@@ -0,0 +1,26 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifndef RRE_SCENE_LAYER
+#define RRE_SCENE_LAYER
+
+#include <cstdint> // *int*_t
+
+
+namespace SceneLayer {
+	/** Enumeration representing scene tile layers. */
+	enum Id: uint8_t {
+		BACKGROUND = 0,
+		TERRAIN,
+		OBJECTS,
+		COLLISION,
+		FOREGROUND,
+		/** Number of tile layers. */
+		COUNT
+	};
+}
+
+#endif /* RRE_SCENE_LAYER */
@@ -9,8 +9,7 @@
 
 #include <string>
 
-#include <pugixml.hpp>
-
+#include "ConfigDocument.hpp"
 #include "template/EntityTemplate.hpp"
 
 
@@ -24,7 +23,7 @@ namespace EntityFactory {
 	 * @return
 	 *   Entity template.
 	 */
-	EntityTemplate build(pugi::xml_node el);
+	EntityTemplate build(ConfigNode el);
 }
 
 #endif /* RRE_ENTITY_FACTORY */
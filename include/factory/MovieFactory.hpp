@@ -23,6 +23,8 @@ namespace MovieFactory {
 	/**
 	 * Builds & retrieves a configured movie.
 	 *
+	 * Movies configuration is parsed on first call & indexed by ID.
+	 *
 	 * @param id
 	 *   Movie identifier.
 	 * @return
@@ -9,8 +9,7 @@
 
 #include <memory>
 
-#include <pugixml.hpp>
-
+#include "ConfigDocument.hpp"
 #include "Sprite.hpp"
 
 
@@ -27,7 +26,7 @@ namespace SpriteFactory {
 	 * @return
 	 *   Unique sprite instance.
 	 */
-	std::shared_ptr<Sprite> build(pugi::xml_node el);
+	std::shared_ptr<Sprite> build(ConfigNode el);
 }
 
 #endif /* RRE_SPRITE_FACTORY */
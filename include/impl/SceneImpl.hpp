@@ -41,6 +41,16 @@ public:
 	 */
 	virtual uint32_t getHeight() = 0;
 
+	/**
+	 * Checks if tile data is streamed.
+	 *
+	 * Streamed scenes are unbounded so view is not clamped to scene size.
+	 *
+	 * @return
+	 *   `true` if a chunk source is set.
+	 */
+	virtual bool isStreamed() = 0;
+
 	/**
 	 * Sets drawing offset on horizontal axis.
 	 *
@@ -7,31 +7,100 @@
 #ifndef RRE_AUDIO_STORE
 #define RRE_AUDIO_STORE
 
+#include <cstdint> // *int*_t
 #include <string>
 
+#include <SDL2/SDL_mixer.h>
+
+#include "MemoryStats.hpp"
+
+
+/** Interned sound effect identifier. */
+typedef uint16_t SoundId;
+
+/**
+ * Decoded sound effect.
+ */
+struct SoundEffect {
+	/** Decoded samples. */
+	Mix_Chunk* chunk;
+	/** Sounds with higher priority may take channels of sounds with lower priority. */
+	uint8_t priority;
+	/** Maximum number of instances playing at once. */
+	uint8_t max_voices;
+};
 
 /**
  * Caches audio paths from configuration.
+ *
+ * Sound effects are decoded into memory when loaded so that playing them doesn't require file
+ * access or decoding.
  */
 namespace AudioStore {
+	/** Identifier of unknown sound effects. */
+	const SoundId NO_SOUND = UINT16_MAX;
+	/** Priority of sound effects not configured in `sounds.xml`. */
+	const uint8_t DEFAULT_PRIORITY = 1;
+	/** Instance limit of sound effects not configured in `sounds.xml`. */
+	const uint8_t DEFAULT_VOICES = 4;
 
 	/**
-	 * Loads music file paths from data/music directory.
+	 * Loads music file paths from data/music directory & decodes sound effects from data/sfx
+	 * directory.
+	 *
+	 * Must be called after audio device is opened.
 	 *
 	 * @return
 	 *   `true` if loading succeeded.
 	 */
 	bool load();
 
+	/** Frees decoded sound effects. */
+	void unload();
+
 	/**
 	 * Retrieves configured path to music file.
 	 *
 	 * @param id
 	 *   Music file identifier (path relative to data/music directory).
 	 * @return
-	 *   Absolute path to music file.
+	 *   Path to music file relative to data directory.
 	 */
 	std::string getMusicPath(const std::string id);
+
+	/**
+	 * Retrieves interned identifier of a sound effect.
+	 *
+	 * Identifiers should be retrieved once & kept by callers playing sounds often.
+	 *
+	 * @param id
+	 *   Sound effect name (path relative to data/sfx directory without extension).
+	 * @return
+	 *   Sound identifier or `NO_SOUND` if sound is not loaded.
+	 */
+	SoundId getSoundId(const std::string& id);
+
+	/**
+	 * Retrieves a sound effect.
+	 *
+	 * @param id
+	 *   Interned sound identifier.
+	 * @return
+	 *   Sound effect or `null` if identifier is invalid.
+	 */
+	const SoundEffect* getSound(SoundId id);
+
+	/**
+	 * Retrieves number of loaded sound effects.
+	 *
+	 * Interned identifiers are less than count.
+	 */
+	uint16_t getSoundCount();
+
+	/**
+	 * Estimates memory held by decoded sound effects.
+	 */
+	MemoryUsage getMemoryUsage();
 }
 
 #endif /* RRE_AUDIO_STORE */
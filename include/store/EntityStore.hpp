@@ -8,25 +8,51 @@
 #define RRE_ENTITY_STORE
 
 #include <string>
+#include <vector>
 
 #include "Character.hpp"
 #include "Entity.hpp"
+#include "MemoryStats.hpp"
 #include "Player.hpp"
 
 
 /**
  * Caches entities loaded from configuration.
+ *
+ * Configuration is indexed at startup. Entity templates & their sprites are built on first
+ * retrieval or when preloaded.
  */
 namespace EntityStore {
 
 	/**
-	 * Caches all configured entities into memory.
+	 * Indexes all configured entities.
 	 *
 	 * @return
 	 *   `true` if loading succeeded without error.
 	 */
 	bool load();
 
+	/**
+	 * Rebuilds built entity templates with changed configuration.
+	 *
+	 * Entities already built from templates are not affected. Their sprites are shared with
+	 * `SpriteStore` & updated there.
+	 *
+	 * @return
+	 *   `true` if configuration was reloaded without error.
+	 */
+	bool reload();
+
+	/**
+	 * Builds entity templates & their sprites ahead of use.
+	 *
+	 * @param ids
+	 *   Entity identifiers.
+	 * @return
+	 *   `true` if all entities are available.
+	 */
+	bool preload(const std::vector<std::string>& ids);
+
 	/**
 	 * Retrieves an entity from cache.
 	 *
@@ -66,6 +92,11 @@ namespace EntityStore {
 	 *   Copy of an player instance. If not found, `NullEntity` is returned.
 	 */
 	Player getPlayer(std::string id);
+
+	/**
+	 * Estimates memory held by properties of entities loaded into cache.
+	 */
+	MemoryUsage getMemoryUsage();
 }
 
 #endif /* RRE_ENTITY_STORE */
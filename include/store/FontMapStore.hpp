@@ -10,6 +10,7 @@
 #include <string>
 
 #include "FontMap.hpp"
+#include "MemoryStats.hpp"
 #include "Sprite.hpp"
 
 
@@ -49,6 +50,11 @@ namespace FontMapStore {
 	 *   `Sprite` representing a line of text or `null` if font map reference is undefined.
 	 */
 	Sprite* buildTextSprite(FontMap* font_map, std::string text);
+
+	/**
+	 * Estimates memory held by font map textures.
+	 */
+	MemoryUsage getMemoryUsage();
 };
 
 #endif /* RRE_FONT_MAP_STORE */
@@ -7,7 +7,12 @@
 #ifndef RRE_SCENE_STORE
 #define RRE_SCENE_STORE
 
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <memory> // std::shared_ptr
 #include <string>
+#include <utility> // std::pair
+#include <vector>
 
 #include "Scene.hpp"
 
@@ -32,14 +37,113 @@ namespace SceneStore {
 	/**
 	 * Retrieves a scene configured scene.
 	 *
-	 * TODO: need a function to delete cached scene data from memory
+	 * Scenes are kept in a least recently used cache. Scenes not referenced outside of the cache
+	 * are evicted when the cache exceeds its memory budget.
 	 *
 	 * @param id
 	 *   Scene identifier.
 	 * @return
-	 *   New or cached scene data.
+	 *   New or cached scene data or `null` if scene could not be loaded.
 	 */
-	Scene* get(std::string id);
+	std::shared_ptr<Scene> get(std::string id);
+
+	/**
+	 * Loads a scene & the entities & sprites it references ahead of use.
+	 *
+	 * Only data referenced by scene is loaded. Scene is added to cache.
+	 *
+	 * @param id
+	 *   Scene identifier.
+	 * @return
+	 *   `true` if scene & all referenced data could be loaded.
+	 */
+	bool preload(std::string id);
+
+	/**
+	 * Removes a scene from cache.
+	 *
+	 * Scene data is freed once all other references have been released.
+	 *
+	 * @param id
+	 *   Scene identifier.
+	 */
+	void release(std::string id);
+
+	/**
+	 * Reloads map data of a cached scene.
+	 *
+	 * Cached scene is updated in place. Objects & player in scene are kept.
+	 *
+	 * @param id
+	 *   Scene identifier.
+	 * @return
+	 *   `false` if scene is cached & could not be reloaded.
+	 */
+	bool reload(std::string id);
+
+	/**
+	 * Reloads cached scenes built from a file.
+	 *
+	 * New maps in scene directory are registered.
+	 *
+	 * @param path
+	 *   Changed file path relative to data directory.
+	 * @return
+	 *   Number of scenes reloaded.
+	 */
+	uint32_t reloadDependents(std::string path);
+
+	/**
+	 * Removes least recently used scenes from cache until usage is within budget.
+	 *
+	 * Scenes referenced outside of cache are not evicted, so this should be called again when a
+	 * scene is no longer in use.
+	 */
+	void evict();
+
+	/**
+	 * Updates estimated memory of a cached scene, e.g. after streamed chunks are loaded or
+	 * released.
+	 *
+	 * @param scene
+	 *   Scene instance, ignored if not cached.
+	 */
+	void updateUsage(const Scene* scene);
+
+	/** Removes all scenes from cache. */
+	void clear();
+
+	/**
+	 * Sets memory budget for cached scenes.
+	 *
+	 * @param bytes
+	 *   Maximum byte count of cached scene data (0 to only keep scenes in use).
+	 */
+	void setCacheBudget(size_t bytes);
+
+	/**
+	 * Retrieves memory budget for cached scenes.
+	 *
+	 * @return
+	 *   Maximum byte count of cached scene data.
+	 */
+	size_t getCacheBudget();
+
+	/**
+	 * Retrieves estimated memory held by cached scenes.
+	 *
+	 * @return
+	 *   Byte count of cached scene data.
+	 */
+	size_t getCacheUsage();
+
+	/**
+	 * Estimates memory held by cached scenes by category.
+	 *
+	 * @return
+	 *   Scene identifiers & memory ordered by identifier.
+	 */
+	std::vector<std::pair<std::string, SceneMemory>> getMemoryBreakdown();
 };
 
 #endif /* RRE_SCENE_STORE */
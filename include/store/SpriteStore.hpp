@@ -7,19 +7,25 @@
 #ifndef RRE_SPRITE_STORE
 #define RRE_SPRITE_STORE
 
+#include <cstdint> // *int*_t
 #include <memory> // std::shared_ptr, std::make_shared
 #include <string>
 
+#include "MemoryStats.hpp"
 #include "Sprite.hpp"
 
 
 /**
  * Caches sprites loaded from configuration.
+ *
+ * Configuration is indexed at startup. Textures & frame tables of a sprite are loaded on first
+ * retrieval (e.g. when an entity template using it is preloaded) so that unused sprites cost neither
+ * load time nor texture memory.
  */
 namespace SpriteStore {
 
 	/**
-	 * Caches all configured sprites into memory.
+	 * Indexes all configured sprites.
 	 *
 	 * @return
 	 *   `true` if loading succeeded without error.
@@ -27,9 +33,30 @@ namespace SpriteStore {
 	bool load();
 
 	/**
-	 * Retrieves a sprite from cache.
+	 * Rebuilds loaded sprites with changed configuration.
 	 *
-	 * NOTE: perhaps should return a shared pointer
+	 * Cached sprites are updated in place so that existing references draw new data. Sprites not
+	 * loaded yet use new configuration when loaded. Sprites removed from configuration are removed
+	 * from cache. Errors are logged without interrupting game & sprites that fail to rebuild keep
+	 * previous configuration.
+	 *
+	 * @return
+	 *   `true` if configuration was reloaded without error.
+	 */
+	bool reload();
+
+	/**
+	 * Reloads texture of sprites using an image.
+	 *
+	 * @param path
+	 *   Image path relative to data directory.
+	 * @return
+	 *   `true` if image is used by any sprite.
+	 */
+	bool reloadTexture(std::string path);
+
+	/**
+	 * Retrieves a sprite from cache, loading it if necessary.
 	 *
 	 * @param id
 	 *   Sprite identifier.
@@ -38,6 +65,16 @@ namespace SpriteStore {
 	 *   checked with `Sprite.ready()`.
 	 */
 	std::shared_ptr<Sprite> get(std::string id);
+
+	/**
+	 * Retrieves number of sprites loaded into cache.
+	 */
+	uint32_t getLoadedCount();
+
+	/**
+	 * Estimates memory held by sprites loaded into cache.
+	 */
+	MemoryUsage getMemoryUsage();
 }
 
 #endif /* RRE_SPRITE_STORE */
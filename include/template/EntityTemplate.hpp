@@ -19,7 +19,7 @@
 
 class EntityTemplate: public HashObject {
 private:
-	static Logger logger;
+	static Logger& logger;
 
 	std::shared_ptr<Sprite> sprite;
 
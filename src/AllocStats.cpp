@@ -0,0 +1,103 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <cstdlib> // std::abort, std::free, std::malloc
+#include <new>
+#include <unordered_set>
+
+#include "AllocStats.hpp"
+#include "Logger.hpp"
+
+using namespace std;
+
+
+namespace AllocStats {
+	static Logger& logger = Logger::getLogger("AllocStats");
+
+#if HAVE_ALLOC_TRACKING
+	/** Allocations of calling thread (constant initialized so usable before `main`). */
+	static thread_local AllocCount thread_count;
+#endif
+
+	/** Main thread count at end of previous frame. */
+	static AllocCount frame_start;
+	/** Allocations of most recent frame. */
+	static AllocCount frame;
+	/** Frames remaining before sections are checked. */
+	static uint32_t warmup = WARMUP;
+	static bool strict = false;
+	/** Sections already logged. */
+	static unordered_set<const char*> reported;
+};
+
+#if HAVE_ALLOC_TRACKING
+void* operator new(size_t size) {
+	AllocStats::thread_count.count++;
+	AllocStats::thread_count.bytes += size;
+	if (size == 0) {
+		size = 1;
+	}
+	void* ptr;
+	while ((ptr = malloc(size)) == nullptr) {
+		new_handler handler = get_new_handler();
+		if (handler == nullptr) {
+			throw bad_alloc();
+		}
+		handler();
+	}
+	return ptr;
+}
+
+// other non-aligned forms call these by default, over-aligned allocations are not counted
+void operator delete(void* ptr) noexcept {
+	free(ptr);
+}
+
+void operator delete(void* ptr, [[maybe_unused]] size_t size) noexcept {
+	free(ptr);
+}
+
+AllocCount AllocStats::get() {
+	return AllocStats::thread_count;
+}
+#endif
+
+void AllocStats::endFrame() {
+	AllocCount now = AllocStats::get();
+	AllocStats::frame = {now.count - AllocStats::frame_start.count,
+			now.bytes - AllocStats::frame_start.bytes};
+	AllocStats::frame_start = now;
+	if (AllocStats::warmup > 0) {
+		AllocStats::warmup--;
+	}
+}
+
+AllocCount AllocStats::getFrame() {
+	return AllocStats::frame;
+}
+
+void AllocStats::resetWarmup() {
+	AllocStats::warmup = WARMUP;
+}
+
+bool AllocStats::steady() {
+	return AllocStats::warmup == 0;
+}
+
+void AllocStats::setStrict(bool strict) {
+	AllocStats::strict = strict;
+}
+
+void AllocStats::onViolation(const char* name, const AllocCount& count) {
+	if (!AllocStats::strict && !AllocStats::reported.insert(name).second) {
+		return;
+	}
+	logger.error("Steady section \"", name, "\" allocated ", count.count, " times (", count.bytes,
+			" bytes)");
+	if (AllocStats::strict) {
+		abort();
+	}
+}
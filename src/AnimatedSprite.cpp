@@ -4,12 +4,14 @@
  * See: LICENSE.txt
  */
 
+#include <utility> // std::swap
+
 #include "AnimatedSprite.hpp"
 
 using namespace std;
 
 
-Logger AnimatedSprite::logger = Logger::getLogger("AnimatedSprite");
+Logger& AnimatedSprite::logger = Logger::getLogger("AnimatedSprite");
 
 // dummy animation to return in case animations have not been initialized
 static Animation _dummy_mode = Animation();
@@ -27,15 +29,35 @@ AnimatedSprite::AnimatedSprite(SDL_Texture* texture, uint32_t tile_width, uint32
 	default_mode = "dummy";
 }
 
-void AnimatedSprite::setMode(string id) {
-	if (modes.find(id) != modes.end()) {
-		current_mode = &modes[id];
+void AnimatedSprite::setMode(const string& id) {
+	auto iter = modes.find(id);
+	if (iter != modes.end()) {
+		current_mode = &iter->second;
 		return;
 	}
 	logger.warn("Unrecognized animation mode: ", id);
 	current_mode = getDefaultMode();
 }
 
+void AnimatedSprite::swap(Sprite& other) {
+	AnimatedSprite* a_other = dynamic_cast<AnimatedSprite*>(&other);
+	if (a_other == nullptr) {
+		logger.error("Cannot swap animated sprite data with static sprite");
+		return;
+	}
+
+	string mode_id = getModeId();
+	string other_mode_id = a_other->getModeId();
+	Sprite::swap(other);
+	std::swap(modes, a_other->modes);
+	std::swap(default_mode, a_other->default_mode);
+
+	// mode pointers reference animations owned by swapped maps
+	current_mode = modes.find(mode_id) != modes.end() ? &modes[mode_id] : getDefaultMode();
+	a_other->current_mode = a_other->modes.find(other_mode_id) != a_other->modes.end()
+			? &a_other->modes[other_mode_id] : a_other->getDefaultMode();
+}
+
 Animation* AnimatedSprite::getDefaultMode() {
 	if (modes.find(default_mode) != modes.end()) {
 		return &modes[default_mode];
@@ -0,0 +1,148 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <algorithm> // std::sort
+#include <cstring> // std::memcpy
+#include <filesystem>
+#include <fstream>
+#include <system_error> // std::error_code
+#include <vector>
+
+#include "Archive.hpp"
+#include "Filesystem.hpp"
+#include "Lz4.hpp"
+#include "MappedFile.hpp"
+
+using namespace std;
+
+
+// entries are only compressed if stored size is at most this fraction of original
+static const double COMPRESS_RATIO = 0.9;
+
+bool Archive::pack(const string& dir, const string& archive_path, bool compress, string& error) {
+	error_code ec;
+	if (!filesystem::is_directory(dir, ec)) {
+		error = "not a directory: " + dir;
+		return false;
+	}
+
+	// sorted names allow binary search of index
+	vector<string> names;
+	// don't pack output (or previous output) into itself when written inside source directory
+	filesystem::path skip = filesystem::absolute(archive_path).lexically_normal();
+	filesystem::path skip_tmp = filesystem::absolute(archive_path + ".tmp").lexically_normal();
+	for (const filesystem::directory_entry& item: filesystem::recursive_directory_iterator(dir, ec)) {
+		if (!item.is_regular_file()) {
+			continue;
+		}
+		filesystem::path item_path = filesystem::absolute(item.path()).lexically_normal();
+		if (item_path == skip || item_path == skip_tmp) {
+			continue;
+		}
+		names.push_back(filesystem::relative(item.path(), dir).generic_string());
+	}
+	if (ec) {
+		error = "cannot read directory: " + ec.message();
+		return false;
+	}
+	sort(names.begin(), names.end());
+
+	string tmp_path = archive_path + ".tmp";
+	ofstream fout(tmp_path, ios::binary | ios::trunc);
+	if (!fout.is_open()) {
+		error = "cannot open output file: " + tmp_path;
+		return false;
+	}
+
+	Header header = {};
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.byte_order = ENDIAN_MARKER;
+	header.entry_count = static_cast<uint32_t>(names.size());
+	fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	uint64_t pos = sizeof(header);
+	auto align = [&fout, &pos]() {
+		static const char pad[8] = {};
+		uint64_t rem = pos % 8;
+		if (rem != 0) {
+			fout.write(pad, 8 - rem);
+			pos += 8 - rem;
+		}
+	};
+
+	vector<Entry> entries;
+	string name_table;
+	vector<uint8_t> buffer;
+	for (const string& name: names) {
+		string path = (filesystem::path(dir) / name).string();
+		Entry entry = {};
+		entry.name = static_cast<uint32_t>(name_table.size());
+		entry.name_length = static_cast<uint32_t>(name.size());
+		entry.mtime = Filesystem::getMTime(path, ec);
+		name_table += name;
+
+		align();
+		entry.offset = pos;
+
+		MappedFile source;
+		if (!source.open(path)) {
+			// empty files cannot be mapped
+			if (filesystem::file_size(path, ec) != 0 || ec) {
+				error = "cannot read file: " + path;
+				fout.close();
+				filesystem::remove(tmp_path, ec);
+				return false;
+			}
+			entries.push_back(entry);
+			continue;
+		}
+		const uint8_t* data = source.getData();
+		size_t size = source.getSize();
+		entry.raw_size = size;
+		entry.size = size;
+
+		// blobs are referenced in place so must not be compressed
+		if (compress && !name.ends_with(".tmxb")) {
+			buffer.resize(Lz4::compressBound(size));
+			size_t c_size = Lz4::compress(data, size, buffer.data(), buffer.size());
+			if (c_size > 0 && c_size <= size * COMPRESS_RATIO) {
+				data = buffer.data();
+				entry.size = c_size;
+				entry.flags |= LZ4;
+			}
+		}
+
+		fout.write(reinterpret_cast<const char*>(data), entry.size);
+		pos += entry.size;
+		entries.push_back(entry);
+	}
+
+	align();
+	header.entries_offset = pos;
+	fout.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+	pos += entries.size() * sizeof(Entry);
+	header.names_offset = pos;
+	header.names_size = name_table.size();
+	fout.write(name_table.data(), name_table.size());
+
+	fout.seekp(0);
+	fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	fout.close();
+	if (!fout) {
+		error = "failed to write output file: " + tmp_path;
+		filesystem::remove(tmp_path, ec);
+		return false;
+	}
+
+	filesystem::rename(tmp_path, archive_path, ec);
+	if (ec) {
+		error = "cannot replace output file: " + ec.message();
+		filesystem::remove(tmp_path, ec);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,150 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include "config.h"
+
+#include <atomic>
+#include <cstdio> // snprintf
+
+#if HAVE_THREAD_CPUTIME
+#include <ctime> // clock_gettime
+#endif
+
+#include <SDL2/SDL_audio.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_timer.h>
+
+#include "AudioStats.hpp"
+#include "Logger.hpp"
+
+using namespace std;
+
+
+namespace AudioStats {
+	static Logger& logger = Logger::getLogger("AudioStats");
+
+	/** Obtained output format. */
+	static int32_t rate = 0;
+	static uint32_t frame_size = 0;
+
+	// written by audio thread
+
+	static atomic<uint64_t> callbacks{0};
+	static atomic<uint64_t> underruns{0};
+	/** Total CPU time of measured callbacks in nanoseconds. */
+	static atomic<uint64_t> mix_total{0};
+	/** Number of callbacks included in `mix_total`. */
+	static atomic<uint64_t> mix_count{0};
+	/** Longest callback CPU time in nanoseconds since measuring started. */
+	static atomic<uint64_t> mix_max{0};
+	/** Sample frames of most recent callback. */
+	static atomic<uint32_t> frames{0};
+
+	// used by audio thread only
+
+	/** Performance counter of previous callback. */
+	static uint64_t prev_time = 0;
+	/** Thread CPU time of previous callback in nanoseconds. */
+	static uint64_t prev_cpu = 0;
+
+	/**
+	 * Post-mix hook called by SDL_mixer from audio thread.
+	 */
+	static void onPostMix(void* udata, Uint8* stream, int len);
+};
+
+void AudioStats::onPostMix(void* udata, Uint8* stream, int len) {
+	uint32_t buffer_frames = len / AudioStats::frame_size;
+	AudioStats::frames.store(buffer_frames, memory_order_relaxed);
+	AudioStats::callbacks.fetch_add(1, memory_order_relaxed);
+
+	uint64_t now = SDL_GetPerformanceCounter();
+	if (AudioStats::prev_time != 0) {
+		// device consumes one buffer per period
+		uint64_t period = SDL_GetPerformanceFrequency() * buffer_frames / AudioStats::rate;
+		if (now - AudioStats::prev_time > period + period / 2) {
+			AudioStats::underruns.fetch_add(1, memory_order_relaxed);
+		}
+	}
+	AudioStats::prev_time = now;
+
+#if HAVE_THREAD_CPUTIME
+	// audio thread is blocked on device between callbacks, CPU time is spent mixing
+	timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	uint64_t cpu = (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+	if (AudioStats::prev_cpu != 0) {
+		uint64_t duration = cpu - AudioStats::prev_cpu;
+		AudioStats::mix_total.fetch_add(duration, memory_order_relaxed);
+		AudioStats::mix_count.fetch_add(1, memory_order_relaxed);
+		uint64_t prev_max = AudioStats::mix_max.load(memory_order_relaxed);
+		while (duration > prev_max
+				&& !AudioStats::mix_max.compare_exchange_weak(prev_max, duration,
+				memory_order_relaxed)) {}
+	}
+	AudioStats::prev_cpu = cpu;
+#endif
+}
+
+void AudioStats::start() {
+	int freq, channels;
+	Uint16 format;
+	if (Mix_QuerySpec(&freq, &format, &channels) == 0) {
+		logger.warn("Audio device not open, mixer not measured");
+		return;
+	}
+	AudioStats::rate = freq;
+	AudioStats::frame_size = channels * (SDL_AUDIO_BITSIZE(format) / 8);
+	AudioStats::prev_time = 0;
+	AudioStats::prev_cpu = 0;
+
+	logger.info("Audio output: ", to_string(freq), "Hz, ", to_string(channels), " channels, ",
+			to_string(SDL_AUDIO_BITSIZE(format)), "-bit");
+	Mix_SetPostMix(AudioStats::onPostMix, nullptr);
+}
+
+void AudioStats::stop() {
+	Mix_SetPostMix(nullptr, nullptr);
+}
+
+AudioStatsSnapshot AudioStats::getSnapshot() {
+	AudioStatsSnapshot snapshot = {};
+	snapshot.rate = AudioStats::rate;
+	snapshot.frames = AudioStats::frames.load(memory_order_relaxed);
+	snapshot.callbacks = AudioStats::callbacks.load(memory_order_relaxed);
+	snapshot.underruns = AudioStats::underruns.load(memory_order_relaxed);
+
+	uint64_t mix_count = AudioStats::mix_count.load(memory_order_relaxed);
+	if (mix_count > 0) {
+		snapshot.mix_mean = AudioStats::mix_total.load(memory_order_relaxed) / mix_count / 1000;
+	}
+	// not reset so that overlay refreshes don't hide session maximum from exit report
+	snapshot.mix_max = AudioStats::mix_max.load(memory_order_relaxed) / 1000;
+
+	if (snapshot.rate > 0 && snapshot.frames > 0) {
+		snapshot.latency = 1000.0f * snapshot.frames / snapshot.rate;
+		snapshot.load = 100.0f * snapshot.mix_mean / (snapshot.latency * 1000);
+	}
+	return snapshot;
+}
+
+string AudioStats::getSummary() {
+	AudioStatsSnapshot snapshot = AudioStats::getSnapshot();
+	char text[64];
+	snprintf(text, sizeof(text), "MIX: %.2fMS %.0f%% XRUN: %llu LAT: %.0fMS",
+			snapshot.mix_mean / 1000.0f, snapshot.load, (unsigned long long) snapshot.underruns,
+			snapshot.latency);
+	return text;
+}
+
+void AudioStats::writeJson(ostream& out) {
+	AudioStatsSnapshot snapshot = AudioStats::getSnapshot();
+	out << "{\"rate\":" << snapshot.rate << ",\"frames\":" << snapshot.frames
+			<< ",\"callbacks\":" << snapshot.callbacks << ",\"mix_mean_us\":" << snapshot.mix_mean
+			<< ",\"mix_max_us\":" << snapshot.mix_max << ",\"load_percent\":" << snapshot.load
+			<< ",\"underruns\":" << snapshot.underruns << ",\"latency_ms\":" << snapshot.latency
+			<< "}" << endl;
+}
@@ -9,7 +9,7 @@
 using namespace std;
 
 
-Logger Character::logger = Logger::getLogger("Character");
+Logger& Character::logger = Logger::getLogger("Character");
 
 Character::Character(shared_ptr<Sprite> sprite, uint32_t width, uint32_t height)
 : Entity(sprite, width, height) {
@@ -0,0 +1,643 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include "config.h"
+
+#include <cstring> // std::memchr, std::memcmp, std::memcpy, std::strcmp
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <system_error> // std::error_code
+#include <unordered_map>
+#include <vector>
+
+#include "ConfigDocument.hpp"
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+#include "Path.hpp"
+#include "StrUtil.hpp"
+#include "Vfs.hpp"
+
+using namespace std;
+
+
+static Logger& logger = Logger::getLogger("ConfigDocument");
+
+
+uint32_t ConfigAttribute::asUInt(uint32_t def) const {
+	uint32_t i;
+	if (val == nullptr || StrUtil::parseUInt(i, val).first != 0) {
+		return def;
+	}
+	return i;
+}
+
+
+ConfigNode::ConfigNode(): doc(nullptr), index(ConfigDocument::NONE) {}
+
+bool ConfigNode::empty() const {
+	return doc == nullptr || index == ConfigDocument::NONE;
+}
+
+const char* ConfigNode::name() const {
+	return empty() ? "" : doc->strings + doc->elements[index].name;
+}
+
+const char* ConfigNode::text() const {
+	return empty() ? "" : doc->strings + doc->elements[index].text;
+}
+
+ConfigNode ConfigNode::child(const char* name) const {
+	if (empty()) {
+		return ConfigNode();
+	}
+	uint32_t idx = doc->elements[index].first_child;
+	while (idx != ConfigDocument::NONE) {
+		if (strcmp(doc->strings + doc->elements[idx].name, name) == 0) {
+			return ConfigNode(doc, idx);
+		}
+		idx = doc->elements[idx].next_sibling;
+	}
+	return ConfigNode();
+}
+
+ConfigNode ConfigNode::nextSibling(const char* name) const {
+	if (empty()) {
+		return ConfigNode();
+	}
+	uint32_t idx = doc->elements[index].next_sibling;
+	while (idx != ConfigDocument::NONE) {
+		if (strcmp(doc->strings + doc->elements[idx].name, name) == 0) {
+			return ConfigNode(doc, idx);
+		}
+		idx = doc->elements[idx].next_sibling;
+	}
+	return ConfigNode();
+}
+
+ConfigAttribute ConfigNode::attribute(const char* name) const {
+	if (empty()) {
+		return ConfigAttribute();
+	}
+	const ConfigDocument::ElementRecord& el = doc->elements[index];
+	for (uint32_t idx = 0; idx < el.attribute_count; idx++) {
+		const ConfigDocument::AttributeRecord& attr = doc->attributes[el.first_attribute + idx];
+		if (strcmp(doc->strings + attr.name, name) == 0) {
+			return ConfigAttribute(doc->strings + attr.value);
+		}
+	}
+	return ConfigAttribute();
+}
+
+/**
+ * Adds string to FNV-1a hash.
+ *
+ * Null terminator is included so that adjacent strings are distinguished.
+ */
+static uint64_t _hashString(uint64_t h, const char* str) {
+	do {
+		h ^= (uint8_t) *str;
+		h *= 0x100000001b3ULL;
+	} while (*str++ != '\0');
+	return h;
+}
+
+uint64_t ConfigNode::hash() const {
+	uint64_t h = 0xcbf29ce484222325ULL;
+	if (empty()) {
+		return h;
+	}
+	const ConfigDocument::ElementRecord& el = doc->elements[index];
+	h = _hashString(h, doc->strings + el.name);
+	h = _hashString(h, doc->strings + el.text);
+	for (uint32_t idx = 0; idx < el.attribute_count; idx++) {
+		const ConfigDocument::AttributeRecord& attr = doc->attributes[el.first_attribute + idx];
+		h = _hashString(h, doc->strings + attr.name);
+		h = _hashString(h, doc->strings + attr.value);
+	}
+	uint32_t idx = el.first_child;
+	while (idx != ConfigDocument::NONE) {
+		h ^= ConfigNode(doc, idx).hash();
+		h *= 0x100000001b3ULL;
+		idx = doc->elements[idx].next_sibling;
+	}
+	return h;
+}
+
+
+/**
+ * Single pass XML reader emitting element, attribute & string records.
+ */
+class ConfigBuilder {
+private:
+	const char* data;
+	size_t size;
+	size_t pos;
+
+	/** Last child of each element used to link siblings. */
+	vector<uint32_t> last_child;
+	/** Currently open elements. */
+	vector<uint32_t> open;
+	/** Deduplicated names. */
+	unordered_map<string, uint32_t> name_index;
+
+	bool startsWith(const char* token) const {
+		size_t len = strlen(token);
+		return size - pos >= len && memcmp(data + pos, token, len) == 0;
+	}
+
+	static bool isSpace(char c) {
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+	void skipSpace() {
+		while (pos < size && isSpace(data[pos])) {
+			pos++;
+		}
+	}
+
+	/** Advances past a terminating token. */
+	bool skipPast(const char* token) {
+		size_t end = string_view(data, size).find(token, pos);
+		if (end == string_view::npos) {
+			return false;
+		}
+		pos = end + strlen(token);
+		return true;
+	}
+
+	string_view readName() {
+		size_t start = pos;
+		while (pos < size && !isSpace(data[pos]) && data[pos] != '/' && data[pos] != '>'
+				&& data[pos] != '=') {
+			pos++;
+		}
+		return string_view(data + start, pos - start);
+	}
+
+	/** Appends UTF-8 encoding of a code point. */
+	static void appendUtf8(string& out, uint32_t cp) {
+		if (cp < 0x80) {
+			out += (char) cp;
+		} else if (cp < 0x800) {
+			out += (char) (0xc0 | (cp >> 6));
+			out += (char) (0x80 | (cp & 0x3f));
+		} else if (cp < 0x10000) {
+			out += (char) (0xe0 | (cp >> 12));
+			out += (char) (0x80 | ((cp >> 6) & 0x3f));
+			out += (char) (0x80 | (cp & 0x3f));
+		} else {
+			out += (char) (0xf0 | (cp >> 18));
+			out += (char) (0x80 | ((cp >> 12) & 0x3f));
+			out += (char) (0x80 | ((cp >> 6) & 0x3f));
+			out += (char) (0x80 | (cp & 0x3f));
+		}
+	}
+
+	/**
+	 * Decodes entities & line endings.
+	 *
+	 * Unrecognized entities are kept as is.
+	 *
+	 * @param raw
+	 *   Raw text.
+	 * @param attribute
+	 *   If `true`, whitespace characters are converted to spaces.
+	 */
+	static string decode(string_view raw, bool attribute) {
+		string out;
+		out.reserve(raw.size());
+		for (size_t idx = 0; idx < raw.size(); idx++) {
+			char c = raw[idx];
+			if (c == '\r') {
+				// CRLF & CR are normalized to LF
+				if (idx + 1 < raw.size() && raw[idx + 1] == '\n') {
+					idx++;
+				}
+				c = '\n';
+			}
+			if (attribute && (c == '\n' || c == '\t')) {
+				c = ' ';
+			}
+			if (c != '&') {
+				out += c;
+				continue;
+			}
+
+			size_t end = raw.find(';', idx);
+			string_view ent = end == string_view::npos ? "" : raw.substr(idx + 1, end - idx - 1);
+			if (ent == "lt") {
+				out += '<';
+			} else if (ent == "gt") {
+				out += '>';
+			} else if (ent == "amp") {
+				out += '&';
+			} else if (ent == "quot") {
+				out += '"';
+			} else if (ent == "apos") {
+				out += '\'';
+			} else if (ent.size() > 1 && ent[0] == '#') {
+				uint32_t cp = 0;
+				bool hex = ent[1] == 'x';
+				bool valid = ent.size() > (hex ? 2 : 1);
+				for (size_t n = hex ? 2 : 1; n < ent.size() && valid; n++) {
+					char d = ent[n];
+					if (d >= '0' && d <= '9') {
+						cp = cp * (hex ? 16 : 10) + (d - '0');
+					} else if (hex && d >= 'a' && d <= 'f') {
+						cp = cp * 16 + (d - 'a' + 10);
+					} else if (hex && d >= 'A' && d <= 'F') {
+						cp = cp * 16 + (d - 'A' + 10);
+					} else {
+						valid = false;
+					}
+				}
+				if (!valid || cp > 0x10ffff) {
+					out += c;
+					continue;
+				}
+				appendUtf8(out, cp);
+			} else {
+				out += c;
+				continue;
+			}
+			idx = end;
+		}
+		return out;
+	}
+
+	/** Appends a string to string table & returns its offset. */
+	uint32_t addString(const string& str) {
+		uint32_t offset = (uint32_t) strings.size();
+		strings.insert(strings.end(), str.begin(), str.end());
+		strings.push_back('\0');
+		return offset;
+	}
+
+	uint32_t addName(string_view name) {
+		string key(name);
+		auto iter = name_index.find(key);
+		if (iter != name_index.end()) {
+			return iter->second;
+		}
+		uint32_t offset = addString(key);
+		name_index[key] = offset;
+		return offset;
+	}
+
+	void addText(string_view raw, bool cdata) {
+		ConfigDocument::ElementRecord& el = elements[open.back()];
+		if (el.text != 0) {
+			return;
+		}
+		string text = cdata ? string(raw) : decode(raw, false);
+		// whitespace between elements is ignored
+		bool blank = true;
+		for (char c: text) {
+			if (!isSpace(c)) {
+				blank = false;
+				break;
+			}
+		}
+		if (!blank) {
+			el.text = addString(text);
+		}
+	}
+
+	bool parseStartTag(string& error) {
+		string_view name = readName();
+		if (name.empty()) {
+			error = "missing element name";
+			return false;
+		}
+
+		uint32_t idx = (uint32_t) elements.size();
+		ConfigDocument::ElementRecord el = {};
+		el.name = addName(name);
+		el.first_child = ConfigDocument::NONE;
+		el.next_sibling = ConfigDocument::NONE;
+		el.first_attribute = (uint32_t) attributes.size();
+		elements.push_back(el);
+		last_child.push_back(ConfigDocument::NONE);
+
+		uint32_t parent = open.back();
+		if (last_child[parent] == ConfigDocument::NONE) {
+			elements[parent].first_child = idx;
+		} else {
+			elements[last_child[parent]].next_sibling = idx;
+		}
+		last_child[parent] = idx;
+
+		while (true) {
+			skipSpace();
+			if (pos >= size) {
+				error = "unterminated element \"" + string(name) + "\"";
+				return false;
+			}
+			if (startsWith("/>")) {
+				pos += 2;
+				return true;
+			}
+			if (data[pos] == '>') {
+				pos++;
+				open.push_back(idx);
+				return true;
+			}
+
+			string_view attr_name = readName();
+			skipSpace();
+			if (attr_name.empty() || pos >= size || data[pos] != '=') {
+				error = "malformed attribute in element \"" + string(name) + "\"";
+				return false;
+			}
+			pos++;
+			skipSpace();
+			if (pos >= size || (data[pos] != '"' && data[pos] != '\'')) {
+				error = "unquoted attribute \"" + string(attr_name) + "\"";
+				return false;
+			}
+			char quote = data[pos++];
+			const char* end = static_cast<const char*>(memchr(data + pos, quote, size - pos));
+			if (end == nullptr) {
+				error = "unterminated attribute \"" + string(attr_name) + "\"";
+				return false;
+			}
+			ConfigDocument::AttributeRecord attr;
+			attr.name = addName(attr_name);
+			attr.value = addString(decode(string_view(data + pos, end - (data + pos)), true));
+			attributes.push_back(attr);
+			elements[idx].attribute_count++;
+			pos = (end - data) + 1;
+		}
+	}
+
+	bool parseEndTag(string& error) {
+		string_view name = readName();
+		skipSpace();
+		if (pos >= size || data[pos] != '>') {
+			error = "malformed end tag \"" + string(name) + "\"";
+			return false;
+		}
+		pos++;
+		if (open.size() < 2 || string_view(strings.data() + elements[open.back()].name) != name) {
+			error = "unexpected end tag \"" + string(name) + "\"";
+			return false;
+		}
+		open.pop_back();
+		return true;
+	}
+
+public:
+	vector<ConfigDocument::ElementRecord> elements;
+	vector<ConfigDocument::AttributeRecord> attributes;
+	vector<char> strings;
+
+	ConfigBuilder(const char* data, size_t size): data(data), size(size), pos(0) {
+		// offset 0 is empty string
+		strings.push_back('\0');
+		// document root
+		ConfigDocument::ElementRecord root = {};
+		root.first_child = ConfigDocument::NONE;
+		root.next_sibling = ConfigDocument::NONE;
+		elements.push_back(root);
+		last_child.push_back(ConfigDocument::NONE);
+		open.push_back(0);
+	}
+
+	bool parse(string& error) {
+		while (pos < size) {
+			if (data[pos] != '<') {
+				const char* end = static_cast<const char*>(memchr(data + pos, '<', size - pos));
+				size_t len = end == nullptr ? size - pos : end - (data + pos);
+				addText(string_view(data + pos, len), false);
+				pos += len;
+				continue;
+			}
+
+			bool ok = true;
+			if (startsWith("<?")) {
+				ok = skipPast("?>");
+			} else if (startsWith("<!--")) {
+				ok = skipPast("-->");
+			} else if (startsWith("<![CDATA[")) {
+				pos += 9;
+				size_t start = pos;
+				ok = skipPast("]]>");
+				if (ok) {
+					addText(string_view(data + start, pos - 3 - start), true);
+				}
+			} else if (startsWith("<!")) {
+				ok = skipPast(">");
+			} else if (startsWith("</")) {
+				pos += 2;
+				if (!parseEndTag(error)) {
+					return false;
+				}
+			} else {
+				pos++;
+				if (!parseStartTag(error)) {
+					return false;
+				}
+			}
+			if (!ok) {
+				error = "unterminated markup";
+				return false;
+			}
+		}
+
+		if (open.size() > 1) {
+			error = "unclosed element \"" + string(strings.data() + elements[open.back()].name) + "\"";
+			return false;
+		}
+		if (elements[0].first_child == ConfigDocument::NONE) {
+			error = "no root element";
+			return false;
+		}
+		return true;
+	}
+};
+
+
+/**
+ * Calculates FNV-1a hash of data.
+ */
+static uint64_t _hash(const uint8_t* data, size_t size) {
+	uint64_t h = 0xcbf29ce484222325ULL;
+	for (size_t idx = 0; idx < size; idx++) {
+		h ^= data[idx];
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+/**
+ * Determines cache file path for a configuration.
+ */
+static string _getCachePath(const string& vpath) {
+	return Path::rabs(Path::join("cache", vpath + ".bin"));
+}
+
+/**
+ * Writes cache file.
+ *
+ * Failure is not an error as executable directory may not be writable.
+ */
+static void _writeCache(const string& path, const vector<uint8_t>& data) {
+	error_code ec;
+	filesystem::create_directories(filesystem::path(path).parent_path(), ec);
+	string tmp_path = path + ".tmp";
+	ofstream fout(tmp_path, ios::binary | ios::trunc);
+	if (fout.is_open()) {
+		fout.write(reinterpret_cast<const char*>(data.data()), data.size());
+		fout.close();
+	}
+	if (!fout) {
+		LOG_DEBUG(logger, "Cannot write config cache: ", path);
+		filesystem::remove(tmp_path, ec);
+		return;
+	}
+	filesystem::rename(tmp_path, path, ec);
+}
+
+
+bool ConfigDocument::open(shared_ptr<const void> owner, const uint8_t* data, size_t size,
+		string& error) {
+	header = nullptr;
+	this->owner = owner;
+
+	if (size < sizeof(Header) || reinterpret_cast<uintptr_t>(data) % alignof(Header) != 0) {
+		error = "truncated header";
+		return false;
+	}
+	const Header* h = reinterpret_cast<const Header*>(data);
+	if (memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0 || h->version != VERSION
+			|| h->byte_order != ENDIAN_MARKER) {
+		error = "incompatible format version";
+		return false;
+	}
+	uint64_t e_size = (uint64_t) h->element_count * sizeof(ElementRecord);
+	uint64_t a_size = (uint64_t) h->attribute_count * sizeof(AttributeRecord);
+	if (h->element_count == 0 || h->strings_size == 0
+			|| sizeof(Header) + e_size + a_size + h->strings_size != size) {
+		error = "corrupt table sizes";
+		return false;
+	}
+
+	span<const ElementRecord> e_table(reinterpret_cast<const ElementRecord*>(data + sizeof(Header)),
+			h->element_count);
+	span<const AttributeRecord> a_table(
+			reinterpret_cast<const AttributeRecord*>(data + sizeof(Header) + e_size), h->attribute_count);
+	const char* s_table = reinterpret_cast<const char*>(data + sizeof(Header) + e_size + a_size);
+
+	// string offsets must point inside table, which must be terminated
+	if (s_table[h->strings_size - 1] != '\0') {
+		error = "corrupt string table";
+		return false;
+	}
+	for (const ElementRecord& el: e_table) {
+		if (el.name >= h->strings_size || el.text >= h->strings_size
+				|| (el.first_child != NONE && el.first_child >= h->element_count)
+				|| (el.next_sibling != NONE && el.next_sibling >= h->element_count)
+				|| (uint64_t) el.first_attribute + el.attribute_count > h->attribute_count) {
+			error = "corrupt element";
+			return false;
+		}
+	}
+	for (const AttributeRecord& attr: a_table) {
+		if (attr.name >= h->strings_size || attr.value >= h->strings_size) {
+			error = "corrupt attribute";
+			return false;
+		}
+	}
+
+	header = h;
+	elements = e_table;
+	attributes = a_table;
+	strings = s_table;
+	return true;
+}
+
+bool ConfigDocument::build(const char* data, size_t size, int64_t mtime, uint64_t hash,
+		string& error) {
+	ConfigBuilder builder(data, size);
+	if (!builder.parse(error)) {
+		header = nullptr;
+		return false;
+	}
+
+	Header h = {};
+	memcpy(h.magic, MAGIC, sizeof(MAGIC));
+	h.version = VERSION;
+	h.byte_order = ENDIAN_MARKER;
+	h.element_count = (uint32_t) builder.elements.size();
+	h.source_mtime = mtime;
+	h.source_size = size;
+	h.source_hash = hash;
+	h.attribute_count = (uint32_t) builder.attributes.size();
+	h.strings_size = (uint32_t) builder.strings.size();
+
+	size_t e_size = builder.elements.size() * sizeof(ElementRecord);
+	size_t a_size = builder.attributes.size() * sizeof(AttributeRecord);
+	shared_ptr<vector<uint8_t>> buffer = make_shared<vector<uint8_t>>(
+			sizeof(Header) + e_size + a_size + builder.strings.size());
+	uint8_t* out = buffer->data();
+	memcpy(out, &h, sizeof(Header));
+	memcpy(out + sizeof(Header), builder.elements.data(), e_size);
+	memcpy(out + sizeof(Header) + e_size, builder.attributes.data(), a_size);
+	memcpy(out + sizeof(Header) + e_size + a_size, builder.strings.data(), builder.strings.size());
+
+	return open(buffer, buffer->data(), buffer->size(), error);
+}
+
+bool ConfigDocument::parse(const char* data, size_t size, string& error) {
+	return build(data, size, 0, _hash(reinterpret_cast<const uint8_t*>(data), size), error);
+}
+
+bool ConfigDocument::load(const string& vpath, string& error) {
+	VfsStat st;
+	if (!Vfs::stat(vpath, st)) {
+		error = "file not found";
+		return false;
+	}
+
+	// up to date cache is used without reading source
+	string cache_path = _getCachePath(vpath);
+	shared_ptr<MappedFile> cached = make_shared<MappedFile>();
+	string cache_error;
+	bool have_cache = cached->open(cache_path)
+			&& open(cached, cached->getData(), cached->getSize(), cache_error);
+	if (have_cache && header->source_mtime == st.mtime && header->source_size == st.size) {
+		return true;
+	}
+
+	VfsFile file = Vfs::read(vpath);
+	if (!file.ready()) {
+		header = nullptr;
+		error = "cannot read file";
+		return false;
+	}
+	uint64_t hash = _hash(file.data, file.size);
+
+	if (have_cache && header->source_hash == hash && header->source_size == file.size) {
+		// only modification time changed
+		const uint8_t* c_data = cached->getData();
+		shared_ptr<vector<uint8_t>> buffer = make_shared<vector<uint8_t>>(c_data, c_data + cached->getSize());
+		reinterpret_cast<Header*>(buffer->data())->source_mtime = st.mtime;
+		if (!open(buffer, buffer->data(), buffer->size(), error)) {
+			return false;
+		}
+	} else if (!build(reinterpret_cast<const char*>(file.data), file.size, st.mtime, hash, error)) {
+		return false;
+	}
+
+	// tables are held in memory, mapping must be released before replacing file
+	cached = nullptr;
+	_writeCache(cache_path, *static_pointer_cast<const vector<uint8_t>>(owner));
+
+	LOG_DEBUG(logger, "Updated config cache: ", cache_path);
+
+	return true;
+}
@@ -4,13 +4,22 @@
  * See: LICENSE.txt
  */
 
-
 #include "config.h"
 
+#include <chrono>
+#include <deque>
+#include <future>
+#include <utility> // std::move
+
+#include <SDL2/SDL_timer.h>
+
 #include "DataLoader.hpp"
+#include "Dialog.hpp"
 #include "FontMap.hpp"
 #include "Logger.hpp"
 #include "SingletonRepo.hpp"
+#include "StartupMetrics.hpp"
+#include "Trace.hpp"
 #include "factory/FontMapFactory.hpp"
 #include "store/AudioStore.hpp"
 #include "store/FontMapStore.hpp"
@@ -18,50 +27,175 @@
 #include "store/SceneStore.hpp"
 #include "store/SpriteStore.hpp"
 
+using namespace std;
+
 
 namespace DataLoader {
+	static Logger& logger = Logger::getLogger("DataLoader");
+
 	bool loaded = false;
+
+	/** Queued load task. */
+	struct LoadTask {
+		string name;
+		function<bool()> run;
+		bool background;
+		Priority priority;
+	};
+
+	/** Queued tasks by priority. */
+	static deque<LoadTask> tasks[Priority::COUNT];
+
+	/** Background task being loaded by worker. */
+	static LoadTask pending;
+	/** Result of background task, valid while it is being loaded. */
+	static future<bool> pending_result;
+	static uint64_t pending_start = 0;
+
+	/**
+	 * Loads next queued task.
+	 *
+	 * Background tasks are started on worker & completed by a later call. Tasks are loaded one at a
+	 * time so that later tasks can depend on earlier ones.
+	 *
+	 * @param priority
+	 *   Highest priority value to load from.
+	 * @param wait
+	 *   If `true`, waits for running background task.
+	 * @return
+	 *   `false` if no tasks are queued up to priority or background task is still running.
+	 */
+	static bool runNext(Priority priority, bool wait);
+
+	/**
+	 * Reports a loaded task.
+	 *
+	 * @param task
+	 *   Loaded task.
+	 * @param result
+	 *   Result of task.
+	 * @param start
+	 *   Time task was started.
+	 */
+	static void complete(const LoadTask& task, bool result, uint64_t start);
 };
 
 bool DataLoader::load() {
-	Logger logger = Logger::getLogger("DataLoader");
-
 	if (DataLoader::loaded) {
 		logger.warn("Data already loaded");
 		return true;
 	}
 
-	if (!FontMapFactory::loadConfig()) {
-		return false;
-	}
+	// critical path: fonts are needed to draw intro & title text
+	{
+		StartupScope scope("data.fonts");
+
+		if (!FontMapFactory::loadConfig()) {
+			return false;
+		}
 
 #if HAVE_BUILTIN_FONT_MAP
-	if (!FontMapFactory::loadBuiltin()) {
-		return false;
-	}
+		if (!FontMapFactory::loadBuiltin()) {
+			return false;
+		}
 #endif
 
-	FontMap* font_main = FontMapStore::get("main");
-	if (font_main != nullptr) {
-		GetViewport()->setFontMap(font_main);
+		FontMap* font_main = FontMapStore::get("main");
+		if (font_main != nullptr) {
+			GetViewport()->setFontMap(font_main);
+		}
 	}
 
-	if (!AudioStore::load()) {
-		return false;
+	// loaded while intro plays
+
+	// indexes & sound effects don't use renderer, textures are loaded with scenes
+	DataLoader::queue(TITLE, "audio", AudioStore::load, true);
+	DataLoader::queue(SCENE, "sprites", SpriteStore::load, true);
+	DataLoader::queue(SCENE, "entities", EntityStore::load, true);
+	DataLoader::queue(SCENE, "scenes", SceneStore::load, true);
+
+	DataLoader::loaded = true;
+	return true;
+}
+
+void DataLoader::queue(Priority priority, string name, function<bool()> task, bool background) {
+	DataLoader::tasks[priority].push_back({name, move(task), background, priority});
+}
+
+void DataLoader::complete(const LoadTask& task, bool result, uint64_t start) {
+	// dialogs requested by worker are shown from main thread
+	Dialog::showPending();
+	if (!result) {
+		logger.error("Failed to load game data: ", task.name);
 	}
+	uint64_t time = StartupMetrics::elapsed() - start;
+	string phase = "data." + task.name;
+	StartupMetrics::record(phase.c_str(), time, 0);
+	LOG_DEBUG(logger, "Loaded ", task.name, " (", to_string(time / 1000), "ms)");
 
-	if (!SpriteStore::load()) {
-		return false;
+	if (DataLoader::ready()) {
+		StartupMetrics::markInteractive();
 	}
+}
 
-	if (!EntityStore::load()) {
-		return false;
+bool DataLoader::runNext(Priority priority, bool wait) {
+	if (DataLoader::pending_result.valid()) {
+		if (!wait && DataLoader::pending_result.wait_for(chrono::seconds(0))
+				!= future_status::ready) {
+			return false;
+		}
+		// clears result so that task is not pending when reported
+		bool result = DataLoader::pending_result.get();
+		DataLoader::complete(DataLoader::pending, result, DataLoader::pending_start);
+		DataLoader::pending = {};
+		return true;
 	}
 
-	if (!SceneStore::load()) {
-		return false;
+	for (uint8_t p = 0; p <= priority; p++) {
+		deque<LoadTask>& queued = DataLoader::tasks[p];
+		if (queued.empty()) {
+			continue;
+		}
+		LoadTask task = move(queued.front());
+		queued.pop_front();
+
+		uint64_t start = StartupMetrics::elapsed();
+		if (task.background) {
+			DataLoader::pending = move(task);
+			DataLoader::pending_start = start;
+			DataLoader::pending_result = async(launch::async, DataLoader::pending.run);
+			// completed by next call
+			return true;
+		}
+		DataLoader::complete(task, task.run(), start);
+		return true;
 	}
+	return false;
+}
 
-	DataLoader::loaded = true;
+bool DataLoader::step(uint32_t budget) {
+	TraceZone zone("DataLoader::step");
+	uint64_t start = SDL_GetTicks64();
+	do {
+		if (!DataLoader::runNext(SCENE, false)) {
+			break;
+		}
+	} while (SDL_GetTicks64() - start < budget);
+	return DataLoader::ready();
+}
+
+void DataLoader::finish(Priority priority) {
+	while (DataLoader::runNext(priority, true)) {}
+}
+
+bool DataLoader::ready(Priority priority) {
+	if (DataLoader::pending_result.valid() && DataLoader::pending.priority <= priority) {
+		return false;
+	}
+	for (uint8_t p = 0; p <= priority; p++) {
+		if (!DataLoader::tasks[p].empty()) {
+			return false;
+		}
+	}
 	return true;
 }
@@ -5,6 +5,9 @@
  */
 
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <SDL2/SDL.h>
 
@@ -12,7 +15,25 @@
 #include "SingletonRepo.hpp"
 
 
+/** Dialog requested by a thread other than main thread. */
+struct PendingDialog {
+	Uint32 flags;
+	std::string title;
+	std::string msg;
+};
+
+/** Thread running static initialization. */
+static const std::thread::id main_thread = std::this_thread::get_id();
+static std::mutex pending_mtx;
+static std::vector<PendingDialog> pending;
+
 void message(Uint32 flags, std::string title, std::string msg) {
+	if (std::this_thread::get_id() != main_thread) {
+		// message boxes must be shown from main thread
+		std::lock_guard<std::mutex> lock(pending_mtx);
+		pending.push_back({flags, title, msg});
+		return;
+	}
 	if (!SDL_WasInit(SDL_INIT_VIDEO)) {
 		std::cerr << "ERROR: SDL video not initialized, cannot display dialog" << std::endl;
 		std::cout << "(" << flags << ") " << title << ": " << msg << std::endl;
@@ -41,3 +62,14 @@ void Dialog::error(std::string title, std::string msg) {
 void Dialog::error(std::string msg) {
 	Dialog::error("Error", msg);
 }
+
+void Dialog::showPending() {
+	std::vector<PendingDialog> queued;
+	{
+		std::lock_guard<std::mutex> lock(pending_mtx);
+		queued.swap(pending);
+	}
+	for (const PendingDialog& dialog: queued) {
+		message(dialog.flags, dialog.title, dialog.msg);
+	}
+}
@@ -7,7 +7,7 @@
 #include "EnergyBar.hpp"
 
 
-Logger EnergyBar::logger = Logger::getLogger("EnergyBar");
+Logger& EnergyBar::logger = Logger::getLogger("EnergyBar");
 
 void EnergyBar::setOuterColor(uint8_t r, uint8_t g, uint8_t b) {
 	color_outer.r = r;
@@ -32,14 +32,14 @@ void EnergyBar::render(Renderer* ctx, int32_t energy) {
 	ctx->setDrawColor(0, 0, 0);
 	ctx->fillRect(x, y, 8, height);
 
-	int32_t offset_y = -2;
+	// segments don't overlap so each color is drawn in a single pass
+	ctx->setDrawColor(color_outer);
 	for (int32_t seg = 0; seg < energy; seg++) {
-		ctx->setDrawColor(color_outer);
-		ctx->fillRect(x + 1, y + height + offset_y, 6, 1);
-		ctx->setDrawColor(color_inner);
-		ctx->fillRect(x + 3, y + height + offset_y, 2, 1);
-
-		offset_y -= 2;
+		ctx->fillRect(x + 1, y + height - 2 * (seg + 1), 6, 1);
+	}
+	ctx->setDrawColor(color_inner);
+	for (int32_t seg = 0; seg < energy; seg++) {
+		ctx->fillRect(x + 3, y + height - 2 * (seg + 1), 2, 1);
 	}
 
 	ctx->restore();
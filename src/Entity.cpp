@@ -16,7 +16,7 @@
 using namespace std;
 
 
-Logger Entity::logger = Logger::getLogger("Entity");
+Logger& Entity::logger = Logger::getLogger("Entity");
 
 Entity::Entity(shared_ptr<Sprite> sprite, uint32_t width, uint32_t height) {
 	this->sprite = sprite;
@@ -196,28 +196,28 @@ bool Entity::collides(Entity* other) {
 
 void Entity::onClipLeft() {
 	// DEBUG:
-	logger.debug("Entity hit left boundary of scene");
+	LOG_DEBUG(logger, "Entity hit left boundary of scene");
 
 	// TODO:
 }
 
 void Entity::onClipRight() {
 	// DEBUG:
-	logger.debug("Entity hit right boundary of scene");
+	LOG_DEBUG(logger, "Entity hit right boundary of scene");
 
 	// TODO:
 }
 
 void Entity::onClipTop() {
 	// DEBUG:
-	logger.debug("Entity hit top boundary of scene");
+	LOG_DEBUG(logger, "Entity hit top boundary of scene");
 
 	// TODO:
 }
 
 void Entity::onClipBottom() {
 	// DEBUG:
-	logger.debug("Entity hit bottom boundary of scene");
+	LOG_DEBUG(logger, "Entity hit bottom boundary of scene");
 
 	// TODO:
 }
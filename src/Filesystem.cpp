@@ -4,7 +4,7 @@
  * See: LICENSE.txt
  */
 
-#include <fstream>
+#include <system_error> // std::error_code
 #ifdef __WIN32__
 #include <windows.h> // CreateDirectory
 #endif
@@ -15,12 +15,8 @@ using namespace std;
 
 
 bool Filesystem::fexist(const string path) {
-	ifstream ofile;
-	ofile.open(path);
-	bool exists = ofile.is_open();
-	ofile.close();
-
-	return exists;
+	error_code ec;
+	return filesystem::is_regular_file(path, ec);
 }
 
 int Filesystem::mkdir(const string path, dperm mode) {
@@ -0,0 +1,175 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <algorithm> // std::max, std::min, std::nth_element
+#include <array>
+#include <chrono>
+#include <fstream>
+
+#include "AllocStats.hpp"
+#include "FrameProfiler.hpp"
+#include "Logger.hpp"
+
+using namespace std;
+
+
+namespace FrameProfiler {
+	static Logger& logger = Logger::getLogger("FrameProfiler");
+
+	static const array<const char*, COUNT> names = {
+		"events", "input", "step", "logic", "parallax", "background", "terrain", "collision",
+		"objects", "foreground", "weather", "hud", "fade", "present"
+	};
+
+	/** Stage times of current frame in nanoseconds. */
+	static array<uint64_t, COUNT> current = {};
+	/** Stage times of recent frames in microseconds indexed by frame modulo `HISTORY`. */
+	static array<array<uint32_t, COUNT>, HISTORY> history = {};
+	/** Time between presents of recent frames in microseconds. */
+	static array<uint32_t, HISTORY> frame_times = {};
+	static uint64_t frames = 0;
+	static chrono::steady_clock::time_point prev_present;
+
+	static bool graph = false;
+	static ofstream csv;
+
+	/**
+	 * Computes statistics of recent values.
+	 *
+	 * @param value
+	 *   Function retrieving value by history index.
+	 */
+	template <typename F>
+	static StageStats computeStats(F value);
+};
+
+const char* FrameProfiler::getName(Stage stage) {
+	return FrameProfiler::names[stage];
+}
+
+void FrameProfiler::add(Stage stage, uint64_t time) {
+	FrameProfiler::current[stage] += time;
+}
+
+void FrameProfiler::endFrame() {
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
+	uint32_t frame_time = 0;
+	if (FrameProfiler::frames > 0) {
+		frame_time = chrono::duration_cast<chrono::microseconds>(now
+				- FrameProfiler::prev_present).count();
+	}
+	FrameProfiler::prev_present = now;
+
+	uint32_t idx = FrameProfiler::frames % HISTORY;
+	FrameProfiler::frame_times[idx] = frame_time;
+	array<uint32_t, COUNT>& times = FrameProfiler::history[idx];
+	for (uint8_t stage = 0; stage < COUNT; stage++) {
+		times[stage] = FrameProfiler::current[stage] / 1000;
+	}
+	FrameProfiler::current.fill(0);
+	AllocStats::endFrame();
+
+	if (FrameProfiler::csv.is_open()) {
+		FrameProfiler::csv << FrameProfiler::frames << "," << frame_time;
+		for (uint32_t time: times) {
+			FrameProfiler::csv << "," << time;
+		}
+#if HAVE_ALLOC_TRACKING
+		AllocCount allocs = AllocStats::getFrame();
+		FrameProfiler::csv << "," << allocs.count << "," << allocs.bytes;
+#endif
+		FrameProfiler::csv << "\n";
+	}
+	FrameProfiler::frames++;
+}
+
+uint64_t FrameProfiler::getFrameCount() {
+	return FrameProfiler::frames;
+}
+
+uint32_t FrameProfiler::getTime(Stage stage, uint32_t age) {
+	if (age >= min<uint64_t>(FrameProfiler::frames, HISTORY)) {
+		return 0;
+	}
+	return FrameProfiler::history[(FrameProfiler::frames - 1 - age) % HISTORY][stage];
+}
+
+uint32_t FrameProfiler::getFrameTime(uint32_t age) {
+	if (age >= min<uint64_t>(FrameProfiler::frames, HISTORY)) {
+		return 0;
+	}
+	return FrameProfiler::frame_times[(FrameProfiler::frames - 1 - age) % HISTORY];
+}
+
+template <typename F>
+FrameProfiler::StageStats FrameProfiler::computeStats(F value) {
+	uint32_t count = min<uint64_t>(FrameProfiler::frames, HISTORY);
+	if (count == 0) {
+		return {0, 0, 0, 0};
+	}
+	array<uint32_t, HISTORY> values;
+	uint64_t total = 0;
+	for (uint32_t idx = 0; idx < count; idx++) {
+		values[idx] = value(idx);
+		total += values[idx];
+	}
+
+	StageStats stats;
+	stats.avg = total / count;
+	stats.max = *max_element(values.begin(), values.begin() + count);
+	uint32_t p50 = count / 2;
+	nth_element(values.begin(), values.begin() + p50, values.begin() + count);
+	stats.p50 = values[p50];
+	uint32_t p95 = min(count - 1, (count * 95) / 100);
+	nth_element(values.begin(), values.begin() + p95, values.begin() + count);
+	stats.p95 = values[p95];
+	return stats;
+}
+
+FrameProfiler::StageStats FrameProfiler::getStats(Stage stage) {
+	return FrameProfiler::computeStats([stage](uint32_t idx) {
+		return FrameProfiler::history[idx][stage];
+	});
+}
+
+FrameProfiler::StageStats FrameProfiler::getFrameStats() {
+	return FrameProfiler::computeStats([](uint32_t idx) {
+		return FrameProfiler::frame_times[idx];
+	});
+}
+
+void FrameProfiler::toggleGraph() {
+	FrameProfiler::graph = !FrameProfiler::graph;
+}
+
+bool FrameProfiler::graphVisible() {
+	return FrameProfiler::graph;
+}
+
+bool FrameProfiler::startCsv(const string& path) {
+	FrameProfiler::stopCsv();
+	FrameProfiler::csv.open(path, ios::trunc);
+	if (!FrameProfiler::csv.is_open()) {
+		logger.error("Cannot write frame timings: ", path);
+		return false;
+	}
+	// times in microseconds
+	FrameProfiler::csv << "frame,frame_us";
+	for (const char* name: FrameProfiler::names) {
+		FrameProfiler::csv << "," << name << "_us";
+	}
+#if HAVE_ALLOC_TRACKING
+	FrameProfiler::csv << ",allocs,alloc_bytes";
+#endif
+	FrameProfiler::csv << "\n";
+	return true;
+}
+
+void FrameProfiler::stopCsv() {
+	if (FrameProfiler::csv.is_open()) {
+		FrameProfiler::csv.close();
+	}
+}
@@ -9,25 +9,23 @@
 
 #include <unordered_map>
 
-#include <pugixml.hpp>
-
+#include "ConfigDocument.hpp"
 #include "Dialog.hpp"
-#include "Filesystem.hpp"
 #include "GameConfig.hpp"
 #include "Logger.hpp"
 #include "Path.hpp"
 #include "StrUtil.hpp"
+#include "Vfs.hpp"
 #include "factory/MovieFactory.hpp"
 
-using namespace pugi;
 using namespace std;
 
 
 namespace GameConfig {
-	Logger logger = Logger::getLogger("GameConfig");
+	Logger& logger = Logger::getLogger("GameConfig");
 
 	// path to master game configuration
-	const string file_conf = Path::rabs("data/conf/game.xml");
+	const string file_conf = "conf/game.xml";
 }
 
 // configured options
@@ -37,6 +35,15 @@ namespace GameConfig {
 string title = "";
 uint16_t scale = 1;
 static uint32_t step_delay = 300;
+// scene cache budget in megabytes
+static uint32_t scene_cache = 32;
+// chunks loaded beyond view in streamed scenes
+static uint32_t stream_radius = 1;
+// logic steps of player movement to prefetch streamed chunks for
+static uint32_t stream_prefetch = 10;
+// time in milliseconds to transition between music tracks
+static uint32_t music_crossfade = 500;
+static AudioSpec audio_spec = {44100, 1024, 2};
 unordered_map<string, string> menu_backgrounds;
 unordered_map<string, string> menu_music_ids;
 string intro_id = "";
@@ -59,26 +66,27 @@ int GameConfig::load() {
 		return 0;
 	}
 
-	if (!Filesystem::fexist(GameConfig::file_conf)) {
+	if (!Vfs::exists(GameConfig::file_conf)) {
 		GameConfig::logger.warn("Game configuration not found: \"", GameConfig::file_conf, "\"");
 		return 0;
 	}
 
-	xml_document doc;
-	if (doc.load_file(GameConfig::file_conf.c_str()).status != status_ok) {
-		onConfigError("XML Loading Error", "Failed to load game configuration");
+	ConfigDocument doc;
+	string error;
+	if (!doc.load(GameConfig::file_conf, error)) {
+		onConfigError("XML Loading Error", "Failed to load game configuration (" + error + ")");
 		return 1;
 	}
 
-	xml_node el_root = doc.child("game");
-	if (el_root.type() == node_null) {
+	ConfigNode el_root = doc.child("game");
+	if (el_root.empty()) {
 		onConfigError("XML Parsing Error", "Root element not found");
 		return 1;
 	}
 
-	xml_node el_intro = el_root.child("intro");
-	if (el_intro.type() != node_null) {
-		xml_attribute attr_movie = el_intro.attribute("movie");
+	ConfigNode el_intro = el_root.child("intro");
+	if (!el_intro.empty()) {
+		ConfigAttribute attr_movie = el_intro.attribute("movie");
 		if (attr_movie.empty()) {
 			onConfigError("XML Parsing Error",
 					"Intro element without \"movie\" attribute");
@@ -87,18 +95,18 @@ int GameConfig::load() {
 		intro_id = attr_movie.value();
 	}
 
-	xml_node el_title = el_root.child("title");
-	if (el_title.type() != node_null) {
-		title = el_title.text().get();
+	ConfigNode el_title = el_root.child("title");
+	if (!el_title.empty()) {
+		title = el_title.text();
 	}
 	if (title.empty()) {
 		GameConfig::logger.warn("Game title not configured");
 		title = "R&R Engine " + string(RRE_VERSION);
 	}
 
-	xml_node el_scale = el_root.child("scale");
-	if (el_scale.type() != node_null) { // && StrUtil::toUint())
-		ParseResult res = StrUtil::parseUShort(scale, el_scale.text().get());
+	ConfigNode el_scale = el_root.child("scale");
+	if (!el_scale.empty()) { // && StrUtil::toUint())
+		ParseResult res = StrUtil::parseUShort(scale, el_scale.text());
 		if (res.first != 0) {
 			onConfigError("XML Parsing Error", "\"scale\" value must be integer greater than 0: "
 					+ res.second);
@@ -110,17 +118,78 @@ int GameConfig::load() {
 		scale = 4;
 	}
 
-	xml_node el_step_delay = el_root.child("step_delay");
-	if (el_step_delay.type() != node_null) {
-		ParseResult res = StrUtil::parseUInt(step_delay, el_step_delay.text().get());
+	ConfigNode el_step_delay = el_root.child("step_delay");
+	if (!el_step_delay.empty()) {
+		ParseResult res = StrUtil::parseUInt(step_delay, el_step_delay.text());
 		if (res.first != 0) {
 			GameConfig::logger.warn("Step delay must be a positive integer: ", res.second);
 		}
 	}
 
-	xml_node el_menu = el_root.child("menu");
-	while (el_menu.type() != node_null) {
-		xml_attribute attr_id = el_menu.attribute("id");
+	ConfigNode el_scene_cache = el_root.child("scene_cache");
+	if (!el_scene_cache.empty()) {
+		ParseResult res = StrUtil::parseUInt(scene_cache, el_scene_cache.text());
+		if (res.first != 0) {
+			GameConfig::logger.warn("Scene cache budget must be a positive integer: ", res.second);
+		}
+	}
+
+	ConfigNode el_scene_stream = el_root.child("scene_stream");
+	if (!el_scene_stream.empty()) {
+		ConfigAttribute attr_radius = el_scene_stream.attribute("radius");
+		if (!attr_radius.empty()) {
+			ParseResult res = StrUtil::parseUInt(stream_radius, attr_radius.value());
+			if (res.first != 0) {
+				GameConfig::logger.warn("Scene stream radius must be a positive integer: ", res.second);
+			}
+		}
+		ConfigAttribute attr_prefetch = el_scene_stream.attribute("prefetch");
+		if (!attr_prefetch.empty()) {
+			ParseResult res = StrUtil::parseUInt(stream_prefetch, attr_prefetch.value());
+			if (res.first != 0) {
+				GameConfig::logger.warn("Scene stream prefetch must be a positive integer: ", res.second);
+			}
+		}
+	}
+
+	ConfigNode el_audio = el_root.child("audio");
+	if (!el_audio.empty()) {
+		ConfigAttribute attr_crossfade = el_audio.attribute("crossfade");
+		if (!attr_crossfade.empty()) {
+			ParseResult res = StrUtil::parseUInt(music_crossfade, attr_crossfade.value());
+			if (res.first != 0) {
+				GameConfig::logger.warn("Music crossfade must be a positive integer: ", res.second);
+			}
+		}
+		// values are range checked when set
+		AudioSpec spec = audio_spec;
+		ConfigAttribute attr_rate = el_audio.attribute("rate");
+		if (!attr_rate.empty()) {
+			ParseResult res = StrUtil::parseUInt(spec.rate, attr_rate.value());
+			if (res.first != 0) {
+				GameConfig::logger.warn("Audio sample rate must be a positive integer: ", res.second);
+			}
+		}
+		ConfigAttribute attr_chunk = el_audio.attribute("chunk");
+		if (!attr_chunk.empty()) {
+			ParseResult res = StrUtil::parseUShort(spec.chunk, attr_chunk.value());
+			if (res.first != 0) {
+				GameConfig::logger.warn("Audio chunk size must be a positive integer: ", res.second);
+			}
+		}
+		ConfigAttribute attr_channels = el_audio.attribute("channels");
+		if (!attr_channels.empty()) {
+			ParseResult res = StrUtil::parseUShort(spec.channels, attr_channels.value());
+			if (res.first != 0) {
+				GameConfig::logger.warn("Audio channels must be an integer from 1 to 8: ", res.second);
+			}
+		}
+		GameConfig::setAudioSpec(spec);
+	}
+
+	ConfigNode el_menu = el_root.child("menu");
+	while (!el_menu.empty()) {
+		ConfigAttribute attr_id = el_menu.attribute("id");
 		if (attr_id.empty()) {
 			onConfigError("XML Parsing Error", "\"menu\" element without \"id\" attribute");
 			return 1;
@@ -132,21 +201,21 @@ int GameConfig::load() {
 			return 1;
 		}
 
-		xml_attribute attr_bg = el_menu.attribute("background");
+		ConfigAttribute attr_bg = el_menu.attribute("background");
 		if (attr_bg.empty()) {
 			GameConfig::logger.warn("Menu (", id, ") without background");
 		} else {
 			menu_backgrounds[id] = Path::join("background", attr_bg.value());
 		}
 
-		xml_attribute attr_music = el_menu.attribute("music");
+		ConfigAttribute attr_music = el_menu.attribute("music");
 		if (attr_music.empty()) {
 			GameConfig::logger.warn("Menu (", id, ") without music");
 		} else {
 			menu_music_ids[id] = attr_music.value();
 		}
 
-		el_menu = el_menu.next_sibling("menu");
+		el_menu = el_menu.nextSibling("menu");
 	}
 
 	// TODO: add option for aspect ratio
@@ -187,3 +256,43 @@ string GameConfig::getMenuMusicId(string id) {
 uint32_t GameConfig::getStepDelay() {
 	return step_delay;
 }
+
+size_t GameConfig::getSceneCacheBudget() {
+	return (size_t) scene_cache * 1024 * 1024;
+}
+
+uint32_t GameConfig::getStreamRadius() {
+	return stream_radius;
+}
+
+uint32_t GameConfig::getStreamPrefetch() {
+	return stream_prefetch;
+}
+
+uint32_t GameConfig::getMusicCrossfade() {
+	return music_crossfade;
+}
+
+AudioSpec GameConfig::getAudioSpec() {
+	return audio_spec;
+}
+
+void GameConfig::setAudioSpec(AudioSpec spec) {
+	// zero values reach `Mix_OpenAudio` & silently disable audio
+	if (spec.rate == 0) {
+		GameConfig::logger.warn("Audio sample rate must be a positive integer: 0");
+	} else {
+		audio_spec.rate = spec.rate;
+	}
+	if (spec.chunk == 0) {
+		GameConfig::logger.warn("Audio chunk size must be a positive integer: 0");
+	} else {
+		audio_spec.chunk = spec.chunk;
+	}
+	if (spec.channels == 0 || spec.channels > 8) {
+		GameConfig::logger.warn("Audio channels must be an integer from 1 to 8: ",
+				to_string(spec.channels));
+	} else {
+		audio_spec.channels = spec.channels;
+	}
+}
@@ -10,14 +10,16 @@
 //~ #include <string>
 #endif
 
+#include "FrameProfiler.hpp"
 #include "GameLogic.hpp"
+#include "GameLoop.hpp"
 #include "SingletonRepo.hpp"
 #include "impl/SceneImpl.hpp"
 
 using namespace std;
 
 
-Logger GameLogic::logger = Logger::getLogger("GameLogic");
+Logger& GameLogic::logger = Logger::getLogger("GameLogic");
 
 // initialize singleton instance to NULL
 unique_ptr<GameLogic> GameLogic::instance = nullptr;
@@ -29,6 +31,7 @@ uint64_t prev_step_time = 0;
 #endif
 
 void GameLogic::step(uint64_t step_time) {
+	FrameScope scope(FrameProfiler::STEP);
 	this->step_time = step_time;
 
 #if RRE_DEBUGGING
@@ -36,8 +39,25 @@ void GameLogic::step(uint64_t step_time) {
 	//~ this->logger.debug("time since last step: ", std::to_string(step_diff), "ms");
 #endif
 
+	// key presses & releases since previous step, player direction is applied from events
+	const InputSnapshot* input;
+	{
+		FrameScope input_scope(FrameProfiler::INPUT);
+		input = &GetInput()->beginStep();
+	}
+
+	if (GameLoop::getMode() == GameMode::TITLE) {
+		// TODO: use translated event to determine how to proceed
+		bool alt = input->isDown(SDL_SCANCODE_LALT) || input->isDown(SDL_SCANCODE_RALT);
+		if (!alt && (input->wasPressed(SDL_SCANCODE_RETURN)
+				|| input->wasPressed(SDL_SCANCODE_KP_ENTER))) {
+			GameLoop::setMode(GameMode::SCENE);
+		}
+	}
+
 	SceneImpl* scene = GetGameVisuals()->getScene();
 	if (scene) {
+		FrameScope logic_scope(FrameProfiler::LOGIC);
 		scene->logic();
 	}
 
@@ -51,7 +71,5 @@ void GameLogic::step(uint64_t step_time) {
 void GameLogic::setStepDelay(uint32_t delay) {
 	step_delay = delay;
 
-#if RRE_DEBUGGING
-	logger.debug("Step delay set to ", to_string(step_delay), "ms");
-#endif
+	LOG_DEBUG(logger, "Step delay set to ", to_string(step_delay), "ms");
 }
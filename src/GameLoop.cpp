@@ -12,10 +12,19 @@
 #include <SDL2/SDL_events.h>
 #include <SDL2/SDL_timer.h>
 
+#include "AllocStats.hpp"
+#include "DataLoader.hpp"
+#include "FrameProfiler.hpp"
 #include "GameLogic.hpp"
 #include "GameLoop.hpp"
+#include "HotReload.hpp"
+#include "InputLatency.hpp"
 #include "Logger.hpp"
+#include "MusicPlayer.hpp"
 #include "SingletonRepo.hpp"
+#include "SoundPlayer.hpp"
+#include "StartupMetrics.hpp"
+#include "Trace.hpp"
 #include "impl/ViewportImpl.hpp"
 
 using namespace std;
@@ -23,7 +32,7 @@ using namespace std;
 
 namespace GameLoop {
 	// logger instance
-	Logger logger = Logger::getLogger("GameLoop");
+	Logger& logger = Logger::getLogger("GameLoop");
 
 	GameMode::Mode mode = GameMode::NONE;
 }
@@ -37,9 +46,7 @@ static bool paused = false;
 static string pause_id = "";
 
 void GameLoop::start() {
-#if RRE_DEBUGGING
-	GameLoop::logger.debug("Starting game loop ...");
-#endif
+	LOG_DEBUG(GameLoop::logger, "Starting game loop ...");
 
 	ViewportImpl* viewport = GetViewport();
 	GameLogic* logic = GetGameLogic();
@@ -61,7 +68,7 @@ void GameLoop::start() {
 	uint64_t last_draw_time = 0;
 
 #if RRE_DEBUGGING
-	GameLoop::logger.debug("Game logic step interval: ", to_string(step_interval), "ms");
+	LOG_DEBUG(GameLoop::logger, "Game logic step interval: ", to_string(step_interval), "ms");
 
 	// number of frames drawn during this interval
 	uint16_t f_drawn = 0;
@@ -81,32 +88,57 @@ void GameLoop::start() {
 		// elapsed time (in milliseconds) since game logic was last executed
 		uint16_t time_elapsed = time_now - time_prev;
 
-		while (SDL_PollEvent(&event) != 0) {
-			if (event.type == SDL_QUIT) {
-				GameLoop::end();
-			} else if (event.type == SDL_KEYDOWN) {
-				GetInput()->onKeyDown(event.key.keysym.sym);
-			} else if (event.type == SDL_KEYUP) {
-				GetInput()->onKeyUp(event.key.keysym.sym);
-			} else if (event.type == SDL_JOYBUTTONDOWN || event.type == SDL_JOYBUTTONUP) {
-				GetInput()->translateGamepadButtonEvent(event.jbutton.button, event.jbutton.state);
-			} else if (event.type == SDL_JOYHATMOTION) {
-				GetInput()->translateGamepadHatEvent(event.jhat);
-			} else if (event.type == SDL_JOYAXISMOTION) {
-				GetInput()->translateGamepadAxisEvent(event.jaxis);
+		// synthetic input for latency measurement
+		if (InputLatency::inject(time_now)) {
+			GameLoop::end();
+		}
+
+		{
+			FrameScope scope(FrameProfiler::EVENTS);
+			while (SDL_PollEvent(&event) != 0) {
+				if (event.type == SDL_QUIT) {
+					GameLoop::end();
+				} else if (event.type == SDL_KEYDOWN) {
+					GetInput()->onKeyDown(event.key.keysym.scancode, event.key.timestamp);
+				} else if (event.type == SDL_KEYUP) {
+					GetInput()->onKeyUp(event.key.keysym.scancode, event.key.timestamp);
+				} else if (event.type == SDL_JOYBUTTONDOWN || event.type == SDL_JOYBUTTONUP) {
+					GetInput()->translateGamepadButtonEvent(event.jbutton.button, event.jbutton.state);
+				} else if (event.type == SDL_JOYHATMOTION) {
+					GetInput()->translateGamepadHatEvent(event.jhat);
+				} else if (event.type == SDL_JOYAXISMOTION) {
+					GetInput()->translateGamepadAxisEvent(event.jaxis);
+				} else if (event.type == SDL_CONTROLLERDEVICEADDED) {
+					GetInput()->onGamepadAdded(event.cdevice.which);
+				} else if (event.type == SDL_CONTROLLERDEVICEREMOVED) {
+					GetInput()->onGamepadRemoved(event.cdevice.which);
+				} else if (event.type == SDL_WINDOWEVENT
+						&& event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+					// window size is cached by renderer
+					GetRenderer()->updateSize();
+				}
 			}
+			GetInput()->endFrame();
 		}
 
+		// apply changed game data in development mode, stores may still be loaded by worker
+		if (DataLoader::ready()) {
+			HotReload::poll(time_now);
+		}
+
+		// start music loaded in background
+		MusicPlayer::update();
+		// sounds triggered after this point belong to a new frame
+		SoundPlayer::update();
+
 		// don't complete loop until unpaused
 		if (paused) continue;
 
-		const uint8_t* k_state = SDL_GetKeyboardState(NULL);
-
-		if (GameLoop::mode == GameMode::TITLE) {
-			// TODO: use translated event to determine how to proceed
-			if (k_state[SDL_SCANCODE_RETURN] || k_state[SDL_SCANCODE_KP_ENTER]) {
-				GameLoop::setMode(GameMode::SCENE);
-			}
+		// remaining game data is loaded in slices between frames
+		if (!DataLoader::ready()) {
+			DataLoader::step();
+			// loading allocates, steady state starts once done
+			AllocStats::resetWarmup();
 		}
 
 		// limit game stepping frequency to defined millisecond intervals
@@ -119,6 +151,9 @@ void GameLoop::start() {
 		// limit viewport redraw frequency to configured max FPS
 		if (time_now - last_draw_time >= draw_interval) {
 			viewport->render();
+			// dumps recent zones on request or hitch
+			Trace::endFrame();
+			StartupMetrics::markFirstFrame();
 			last_draw_time = time_now;
 #if RRE_DEBUGGING
 			f_drawn++;
@@ -146,6 +181,7 @@ GameMode::Mode GameLoop::getMode() {
 void GameLoop::setMode(GameMode::Mode mode) {
 	GameLoop::mode = mode;
 	GetViewport()->setRenderMode(GameLoop::mode);
+	AllocStats::resetWarmup();
 }
 
 void GameLoop::setPaused(bool pause, string id) {
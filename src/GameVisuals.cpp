@@ -11,19 +11,23 @@
 using namespace std;
 
 
-Logger GameVisuals::logger = Logger::getLogger("GameVisuals");
+Logger& GameVisuals::logger = Logger::getLogger("GameVisuals");
 
 // initialize singleton instance
 unique_ptr<GameVisuals> GameVisuals::instance = nullptr;
 mutex GameVisuals::mtx;
 
 bool GameVisuals::setScene(string id) {
-	unsetScene();
 	if (id.empty()) {
 		// empty string means no scene is to be set
+		unsetScene();
 		return true;
 	}
+	// previous scene is kept referenced while loading so that it is not evicted when re-set
+	shared_ptr<SceneImpl> previous = scene;
 	scene = SceneStore::get(id);
+	previous.reset();
+	SceneStore::evict();
 	bool result = scene != nullptr;
 	if (!result) {
 		logger.error("Failed to set scene: ", id);
@@ -37,10 +41,12 @@ bool GameVisuals::setScene(string id) {
 }
 
 void GameVisuals::unsetScene() {
-	if (scene) {
-		delete scene;
-		scene = nullptr;
+	if (!scene) {
+		return;
 	}
+	// scene data is owned by cache, released scene may now be evicted if over budget
+	scene.reset();
+	SceneStore::evict();
 }
 
 void GameVisuals::renderScene() {
@@ -6,16 +6,22 @@
 
 #include <SDL2/SDL.h> // SDL2 defines SDL_Init in main header, this has been moved to SDL_init.h in SDL3
 #include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
 
+#include "AudioStats.hpp"
 #include "Dialog.hpp"
+#include "GameConfig.hpp"
 #include "GameWindow.hpp"
+#include "MusicPlayer.hpp"
 #include "SingletonRepo.hpp"
+#include "SoundPlayer.hpp"
+#include "StartupMetrics.hpp"
 #include "store/AudioStore.hpp"
 
 using namespace std;
 
 
-Logger GameWindow::logger = Logger::getLogger("GameWindow");
+Logger& GameWindow::logger = Logger::getLogger("GameWindow");
 
 // initialize singleton instance
 unique_ptr<GameWindow> GameWindow::instance = nullptr;
@@ -25,7 +31,6 @@ GameWindow::GameWindow() {
 	this->title = "R&R Engine";
 	this->window = nullptr;
 	this->viewport = nullptr;
-	this->music = nullptr;
 	this->quit = false;
 	// initialize saved state
 	saveState();
@@ -39,68 +44,91 @@ void GameWindow::setTitle(const string title) {
 }
 
 int GameWindow::init(const string title, const int width, const int height) {
-	this->logger.debug("Initializing SDL ...");
+	LOG_DEBUG(this->logger, "Initializing SDL ...");
 
 	this->title = title;
 
 	// initialize video subsystem
-	if (SDL_Init(SDL_INIT_VIDEO) != 0) {
-		// NOTE: message logged to console as video subsystem failed to initialize
-		string msg = SDL_GetError();
-		this->logger.error(msg);
-		Dialog::error(msg);
-		SDL_Quit();
-		return 1;
+	{
+		StartupScope scope("window.video");
+		if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+			// NOTE: message logged to console as video subsystem failed to initialize
+			string msg = SDL_GetError();
+			this->logger.error(msg);
+			Dialog::error(msg);
+			SDL_Quit();
+			return 1;
+		}
 	}
 
 	// create the SDL frame & viewport renderer
-	this->window = SDL_CreateWindow(this->title.c_str(), SDL_WINDOWPOS_CENTERED,
-			SDL_WINDOWPOS_CENTERED, width, height, SDL_WINDOW_SHOWN);
+	{
+		StartupScope scope("window.create");
+		this->window = SDL_CreateWindow(this->title.c_str(), SDL_WINDOWPOS_CENTERED,
+				SDL_WINDOWPOS_CENTERED, width, height, SDL_WINDOW_SHOWN);
+	}
 
 	// initialize PNG image support
-	if (IMG_Init(IMG_INIT_PNG) == 0) {
-		string msg = IMG_GetError();
-		this->logger.error(msg);
-		Dialog::error(msg);
-		this->shutdown();
-		return 1;
+	{
+		StartupScope scope("window.image");
+		if (IMG_Init(IMG_INIT_PNG) == 0) {
+			string msg = IMG_GetError();
+			this->logger.error(msg);
+			Dialog::error(msg);
+			this->shutdown();
+			return 1;
+		}
 	}
 
 	// initialize audio subsystem
-	if (SDL_Init(SDL_INIT_AUDIO) != 0) {
-		string msg = SDL_GetError();
-		this->logger.error(msg);
-		Dialog::error(msg);
-		this->shutdown();
-		return 1;
-	}
+	{
+		StartupScope scope("window.audio");
+		if (SDL_Init(SDL_INIT_AUDIO) != 0) {
+			string msg = SDL_GetError();
+			this->logger.error(msg);
+			Dialog::error(msg);
+			this->shutdown();
+			return 1;
+		}
 
-	// initialize mixer for playing OGG audio files
-	const int flags = MIX_INIT_OGG;
-	const int initted = Mix_Init(flags);
-	if ((initted&flags) != flags) {
-		string msg = Mix_GetError();
-		this->logger.error(msg);
-		Dialog::error(msg);
-		this->shutdown();
-		return 1;
-	}
-	if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 1024) != 0) {
-		string msg = Mix_GetError();
-		this->logger.error(msg);
-		Dialog::error(msg);
-		this->shutdown();
-		return 1;
+		// initialize mixer for playing OGG audio files
+		const int flags = MIX_INIT_OGG;
+		const int initted = Mix_Init(flags);
+		if ((initted&flags) != flags) {
+			string msg = Mix_GetError();
+			this->logger.error(msg);
+			Dialog::error(msg);
+			this->shutdown();
+			return 1;
+		}
+		AudioSpec spec = GameConfig::getAudioSpec();
+		if (Mix_OpenAudio(spec.rate, MIX_DEFAULT_FORMAT, spec.channels, spec.chunk) != 0) {
+			string msg = Mix_GetError();
+			this->logger.error(msg);
+			Dialog::error(msg);
+			this->shutdown();
+			return 1;
+		}
+		MusicPlayer::init(GameConfig::getMusicCrossfade());
+		SoundPlayer::init();
+		AudioStats::start();
 	}
 
 	// initialize joystick/gamepad input support
-	if (SDL_Init(SDL_INIT_JOYSTICK) != 0) {
-		string msg = SDL_GetError();
-		this->logger.error(msg);
-		Dialog::error(msg);
+	{
+		StartupScope scope("window.joystick");
+		// game controller subsystem reports device connect/disconnect events
+		if (SDL_Init(SDL_INIT_JOYSTICK | SDL_INIT_GAMECONTROLLER) != 0) {
+			string msg = SDL_GetError();
+			this->logger.error(msg);
+			Dialog::error(msg);
+		}
 	}
 
-	this->viewport = GetViewport();
+	{
+		StartupScope scope("window.renderer");
+		this->viewport = GetViewport();
+	}
 
 	return 0;
 }
@@ -110,40 +138,18 @@ void GameWindow::endGameLoop() {
 }
 
 void GameWindow::playMusic(string id) {
-	if (Mix_PlayingMusic() != 0) {
-		// close previous stream
-		this->stopMusic();
-	}
-
 	string file_music = AudioStore::getMusicPath(id);
-	string audio_error = "";
 	if (file_music.compare("") == 0) {
 		string msg = "Music for ID \"" + id + "\" not configured or file not found";
 		this->logger.warn(msg);
-	} else {
-		this->music = Mix_LoadMUS(file_music.c_str());
-		if (this->music == nullptr) {
-			audio_error = Mix_GetError();
-			if (audio_error.compare("") == 0) {
-				audio_error = "Failed to load music: \"" + file_music + "\"";
-			}
-			this->logger.warn(audio_error);
-		}
-
-		if (Mix_PlayMusic(this->music, -1) != 0) {
-			audio_error = Mix_GetError();
-			if (audio_error.compare("") == 0) {
-				audio_error = "Failed to play music: \"" + file_music + "\"";
-			}
-			this->logger.warn(audio_error);
-		}
+		return;
 	}
+	// loaded in background & started once previous music has faded out
+	MusicPlayer::play(file_music);
 }
 
 void GameWindow::stopMusic() {
-	Mix_HaltMusic();
-	Mix_FreeMusic(this->music);
-	this->music = nullptr;
+	MusicPlayer::stop();
 }
 
 void GameWindow::toggleFullscreen() {
@@ -159,7 +165,10 @@ void GameWindow::toggleFullscreen() {
 }
 
 void GameWindow::shutdown() {
-	this->stopMusic();
+	AudioStats::stop();
+	MusicPlayer::shutdown();
+	SoundPlayer::shutdown();
+	AudioStore::unload();
 	Mix_CloseAudio();
 	Mix_Quit();
 	IMG_Quit();
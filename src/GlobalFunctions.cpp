@@ -12,7 +12,7 @@
 #include "enum/MomentumDir.hpp"
 
 
-static Logger _logger = Logger::getLogger("GlobalFunctions");
+static Logger& _logger = Logger::getLogger("GlobalFunctions");
 
 Player* GetPlayer() {
 	SceneImpl* scene = GetGameVisuals()->getScene();
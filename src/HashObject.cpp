@@ -10,10 +10,24 @@
 using namespace std;
 
 
-Logger HashObject::logger = Logger::getLogger("HashObject");
+Logger& HashObject::logger = Logger::getLogger("HashObject");
+const string HashObject::empty;
 
-int32_t HashObject::getInt(string key) const {
-	string s_value = get(key);
+/**
+ * Retrieves bytes allocated by a string outside of the string object.
+ */
+static size_t _heapSize(const string& s) {
+	const char* chars = s.data();
+	const char* obj = (const char*) &s;
+	// short strings are stored inline
+	if (chars >= obj && chars < obj + sizeof(string)) {
+		return 0;
+	}
+	return s.capacity() + 1;
+}
+
+int32_t HashObject::getInt(const string& key) const {
+	const string& s_value = get(key);
 	int32_t i_value = 0;
 	ParseResult res = StrUtil::parseInt(i_value, s_value);
 	if (res.first != 0) {
@@ -22,8 +36,8 @@ int32_t HashObject::getInt(string key) const {
 	return i_value;
 }
 
-uint32_t HashObject::getUInt(string key) const {
-	string s_value = get(key);
+uint32_t HashObject::getUInt(const string& key) const {
+	const string& s_value = get(key);
 	uint32_t i_value = 0;
 	ParseResult res = StrUtil::parseUInt(i_value, s_value);
 	if (res.first != 0) {
@@ -33,8 +47,8 @@ uint32_t HashObject::getUInt(string key) const {
 	return i_value;
 }
 
-int64_t HashObject::getLong(string key) const {
-	string s_value = get(key);
+int64_t HashObject::getLong(const string& key) const {
+	const string& s_value = get(key);
 	int64_t l_value = 0;
 	ParseResult res = StrUtil::parseLong(l_value, s_value);
 	if (res.first != 0) {
@@ -43,8 +57,8 @@ int64_t HashObject::getLong(string key) const {
 	return l_value;
 }
 
-uint64_t HashObject::getULong(string key) const {
-	string s_value = get(key);
+uint64_t HashObject::getULong(const string& key) const {
+	const string& s_value = get(key);
 	uint64_t l_value = 0;
 	ParseResult res = StrUtil::parseULong(l_value, s_value);
 	if (res.first != 0) {
@@ -54,8 +68,8 @@ uint64_t HashObject::getULong(string key) const {
 	return l_value;
 }
 
-float HashObject::getFloat(string key, float def) const {
-	string s_value = get(key);
+float HashObject::getFloat(const string& key, float def) const {
+	const string& s_value = get(key);
 	float f_value = def;
 	ParseResult res = StrUtil::parseFloat(f_value, s_value);
 	if (res.first != 0) {
@@ -64,8 +78,8 @@ float HashObject::getFloat(string key, float def) const {
 	return f_value;
 }
 
-double HashObject::getDouble(string key) const {
-	string s_value = get(key);
+double HashObject::getDouble(const string& key) const {
+	const string& s_value = get(key);
 	double d_value = 0;
 	ParseResult res = StrUtil::parseDouble(d_value, s_value);
 	if (res.first != 0) {
@@ -73,3 +87,13 @@ double HashObject::getDouble(string key) const {
 	}
 	return d_value;
 }
+
+size_t HashObject::getByteSize() const {
+	size_t bytes = data.bucket_count() * sizeof(void*);
+	for (const auto& [key, value]: data) {
+		// node holds key/value pair, next pointer & cached hash
+		bytes += sizeof(pair<const string, string>) + sizeof(void*) + sizeof(size_t);
+		bytes += _heapSize(key) + _heapSize(value);
+	}
+	return bytes;
+}
@@ -0,0 +1,204 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include "config.h"
+
+#if HAVE_HOT_RELOAD
+#include <cerrno>
+#include <cstring> // strerror
+#include <filesystem>
+#include <unordered_map>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "HotReload.hpp"
+#include "Logger.hpp"
+#include "Path.hpp"
+#include "Vfs.hpp"
+#include "store/EntityStore.hpp"
+#include "store/SceneStore.hpp"
+#include "store/SpriteStore.hpp"
+
+using namespace std;
+
+
+namespace HotReload {
+	static Logger& logger = Logger::getLogger("HotReload");
+
+#if HAVE_HOT_RELOAD
+	/** inotify instance (-1 if not watching). */
+	static int fd = -1;
+	/** Watched directories relative to data directory indexed by watch descriptor. */
+	static unordered_map<int, string> watches;
+	/** Changed files with time of most recent change. */
+	static unordered_map<string, uint64_t> pending;
+	/** Time of most recent check for changes. */
+	static uint64_t last_poll = 0;
+
+	/**
+	 * Watches a directory & its subdirectories.
+	 *
+	 * @param vdir
+	 *   Directory relative to data directory (empty for data directory).
+	 */
+	static void addWatch(const string& vdir);
+#endif
+};
+
+#if HAVE_HOT_RELOAD
+void HotReload::addWatch(const string& vdir) {
+	string dir = vdir.empty() ? Vfs::getMountPath() : Path::join(Vfs::getMountPath(), vdir);
+	int wd = inotify_add_watch(HotReload::fd, dir.c_str(),
+			IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+	if (wd < 0) {
+		logger.warn("Cannot watch directory (", strerror(errno), "): ", dir);
+		return;
+	}
+	HotReload::watches[wd] = vdir;
+
+	error_code ec;
+	for (const filesystem::directory_entry& entry: filesystem::directory_iterator(dir, ec)) {
+		if (entry.is_directory(ec)) {
+			string name = entry.path().filename().string();
+			HotReload::addWatch(vdir.empty() ? name : vdir + "/" + name);
+		}
+	}
+}
+#endif
+
+bool HotReload::start() {
+#if HAVE_HOT_RELOAD
+	if (HotReload::fd >= 0) {
+		return true;
+	}
+	if (Vfs::isArchive()) {
+		logger.warn("Hot reload not available for packed data: ", Vfs::getMountPath());
+		return false;
+	}
+
+	HotReload::fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (HotReload::fd < 0) {
+		logger.error("Failed to initialize file watcher: ", strerror(errno));
+		return false;
+	}
+	HotReload::addWatch("");
+
+	logger.info("Watching data directory for changes (", to_string(HotReload::watches.size()),
+			" directories): ", Vfs::getMountPath());
+	return true;
+#else
+	logger.warn("Hot reload not supported by this build");
+	return false;
+#endif
+}
+
+void HotReload::stop() {
+#if HAVE_HOT_RELOAD
+	if (HotReload::fd < 0) {
+		return;
+	}
+	// watches are removed with instance
+	close(HotReload::fd);
+	HotReload::fd = -1;
+	HotReload::watches.clear();
+	HotReload::pending.clear();
+#endif
+}
+
+bool HotReload::active() {
+#if HAVE_HOT_RELOAD
+	return HotReload::fd >= 0;
+#else
+	return false;
+#endif
+}
+
+void HotReload::poll(uint64_t time_now) {
+#if HAVE_HOT_RELOAD
+	if (HotReload::fd < 0 || time_now - HotReload::last_poll < POLL_INTERVAL) {
+		return;
+	}
+	HotReload::last_poll = time_now;
+
+	alignas(inotify_event) char buffer[4096];
+	ssize_t len;
+	while ((len = read(HotReload::fd, buffer, sizeof(buffer))) > 0) {
+		for (char* ptr = buffer; ptr < buffer + len;) {
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+			ptr += sizeof(inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				logger.warn("File watcher queue overflowed, some changes were not reloaded");
+				continue;
+			}
+			if (event->mask & IN_IGNORED) {
+				// directory was removed
+				HotReload::watches.erase(event->wd);
+				continue;
+			}
+
+			auto watch = HotReload::watches.find(event->wd);
+			if (watch == HotReload::watches.end() || event->len == 0) {
+				continue;
+			}
+			string vpath = watch->second.empty() ? event->name : watch->second + "/" + event->name;
+
+			if (event->mask & IN_ISDIR) {
+				if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+					HotReload::addWatch(vpath);
+				}
+				continue;
+			}
+			if (event->mask & IN_CREATE) {
+				// contents are reported when file is closed
+				continue;
+			}
+
+			// restart debounce timer
+			HotReload::pending[vpath] = time_now;
+		}
+	}
+
+	for (auto iter = HotReload::pending.begin(); iter != HotReload::pending.end();) {
+		if (time_now - iter->second < DEBOUNCE) {
+			iter++;
+			continue;
+		}
+		string vpath = iter->first;
+		iter = HotReload::pending.erase(iter);
+		HotReload::reload(vpath);
+	}
+#endif
+}
+
+void HotReload::reload(string path) {
+	LOG_DEBUG(logger, "File changed: ", path);
+
+	if (path == "conf/sprites.xml") {
+		SpriteStore::reload();
+		return;
+	}
+	if (path == "conf/entities.xml") {
+		EntityStore::reload();
+		return;
+	}
+	if (path.starts_with("conf/")) {
+		logger.info("Restart required to apply configuration changes: ", path);
+		return;
+	}
+
+	// an image may be used by both sprites & scenes
+	[[maybe_unused]] bool handled = SpriteStore::reloadTexture(path);
+	if (SceneStore::reloadDependents(path) > 0) {
+		handled = true;
+	}
+
+	if (!handled) {
+		LOG_DEBUG(logger, "Changed file not in use: ", path);
+	}
+}
@@ -7,7 +7,7 @@
 #include "Image.hpp"
 
 
-Logger Image::logger = Logger::getLogger("Image");
+Logger& Image::logger = Logger::getLogger("Image");
 
 Image::Image(SDL_Texture* texture): Image() {
 	setTexture(texture);
@@ -23,3 +23,21 @@ void Image::setTexture(SDL_Texture* texture) {
 	// get dimensions
 	SDL_QueryTexture(this->texture, NULL, NULL, &this->width, &this->height);
 }
+
+void Image::replaceTexture(SDL_Texture* texture) {
+	if (texture == nullptr) {
+		this->logger.warn("Not replacing texture with null texture");
+		return;
+	}
+	if (this->texture != nullptr) {
+		TextureLoader::destroy(this->texture);
+	}
+	this->texture = nullptr;
+	this->width = 0;
+	this->height = 0;
+	setTexture(texture);
+}
+
+size_t Image::getByteSize() {
+	return TextureLoader::getByteSize(this->texture);
+}
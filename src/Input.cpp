@@ -8,21 +8,24 @@
 
 #include <algorithm>
 // #include <cstdlib> // std::abs
-#include <cstring>  // std::memcmp
 
 #include <SDL2/SDL_timer.h>
 #include <SDL2/SDL_video.h>
 
+#include "FrameProfiler.hpp"
 #include "GameLoop.hpp"
 #include "GlobalFunctions.hpp"
 #include "Input.hpp"
+#include "InputLatency.hpp"
+#include "MemoryStats.hpp"
 #include "SingletonRepo.hpp"
+#include "Trace.hpp"
 #include "enum/MomentumDir.hpp"
 
 using namespace std;
 
 
-Logger Input::logger = Logger::getLogger("Input");
+Logger& Input::logger = Logger::getLogger("Input");
 
 // initialize singleton instance
 unique_ptr<Input> Input::instance = nullptr;
@@ -30,6 +33,10 @@ mutex Input::mtx;
 
 Input::Input() {
 	gamepad = nullptr;
+	axis_values.fill(0);
+	axis_changed = 0;
+	axis_time = 0;
+	axis_dir = MomentumDir::NONE;
 	// TODO: move to `init` function
 	updateGamepads();
 
@@ -37,46 +44,47 @@ Input::Input() {
 	if (!setGamepad(3)) {
 		logger.error("failed to set gamepad: ", SDL_GetError());
 	} else {
-		logger.debug("gamepad set: ", getGamepadName(gamepad));
+		LOG_DEBUG(logger, "gamepad set: ", getGamepadName(gamepad));
 	}
 #endif
 }
 
+/**
+ * Converts a device GUID to string used as registry key.
+ */
+static string _guidString(SDL_JoystickGUID guid) {
+	char sguid[33];
+	SDL_JoystickGetGUIDString(guid, sguid, 33);
+	return sguid;
+}
+
 bool Input::setGamepad(SDL_JoystickGUID guid) {
-	if (gamepad != nullptr) {
-		SDL_GameControllerClose(gamepad);
-		gamepad = nullptr;
-	}
 	gamepad = getGamepad(guid);
 	if (gamepad == nullptr) {
 		SDL_SetError("device not found");
 		return false;
 	}
-	SDL_JoystickGUID dev_guid = SDL_JoystickGetGUID(SDL_GameControllerGetJoystick(gamepad));
-	if (memcmp(&dev_guid, &guid, sizeof(SDL_JoystickGUID)) != 0) {
-		SDL_SetError("device GUID mismatch");
-		return false;
-	}
 	return true;
 }
 
 bool Input::setGamepad(int32_t idx) {
-	for (auto dev_info: gamepad_guids) {
-		if (idx == dev_info.first) {
-			return setGamepad(dev_info.second);
-		}
+	if (idx < 0 || idx >= SDL_NumJoysticks()) {
+		return false;
 	}
-	return false;
+	auto iter = gamepads.find(SDL_JoystickGetDeviceInstanceID(idx));
+	if (iter == gamepads.end()) {
+		return false;
+	}
+	gamepad = iter->second;
+	return true;
 }
 
 SDL_GameController* Input::getGamepad(SDL_JoystickGUID guid) {
-	for (int idx = 0; idx < SDL_NumJoysticks(); idx++) {
-		SDL_JoystickGUID dev_guid = SDL_JoystickGetDeviceGUID(idx);
-		if (memcmp(&dev_guid, &guid, sizeof(SDL_JoystickGUID)) == 0) {
-			return SDL_GameControllerOpen(idx);
-		}
+	auto iter = gamepad_ids.find(_guidString(guid));
+	if (iter == gamepad_ids.end()) {
+		return nullptr;
 	}
-	return nullptr;
+	return gamepads[iter->second];
 }
 
 string Input::getGamepadName(SDL_GameController* dev) {
@@ -84,93 +92,141 @@ string Input::getGamepadName(SDL_GameController* dev) {
 }
 
 void Input::updateGamepads() {
-	if (gamepad && !SDL_GameControllerGetAttached(gamepad)) {
-		SDL_GameControllerClose(gamepad);
-		gamepad = nullptr;
-	}
-	gamepad_guids.clear();
 	for (int32_t dev_idx = 0; dev_idx < SDL_NumJoysticks(); dev_idx++) {
-		SDL_JoystickGUID dev_guid = SDL_JoystickGetDeviceGUID(dev_idx);
-		SDL_GameController* dev = getGamepad(dev_guid);
-		if (!dev) {
-			continue;
-		}
-		gamepad_guids.push_back({dev_idx, dev_guid});
-		SDL_GameControllerClose(dev);
+		onGamepadAdded(dev_idx);
 	}
 
-#if RRE_DEBUGGING
-	logger.debug("attached gamepads: ", to_string(gamepad_guids.size()));
-	for (auto dev_info: gamepad_guids) {
-		int32_t dev_idx = dev_info.first;
-		SDL_JoystickGUID dev_guid = dev_info.second;
-		SDL_GameController* dev = getGamepad(dev_guid);
-		if (!dev) {
-			continue;
+	LOG_DEBUG(logger, "attached gamepads: ", to_string(gamepads.size()));
+}
+
+void Input::onGamepadAdded(int32_t idx) {
+	if (!SDL_IsGameController(idx)) {
+		return;
+	}
+	// devices present at startup are also reported by event
+	if (gamepads.find(SDL_JoystickGetDeviceInstanceID(idx)) != gamepads.end()) {
+		return;
+	}
+	SDL_GameController* dev = SDL_GameControllerOpen(idx);
+	if (!dev) {
+		logger.warn("Failed to open gamepad: ", SDL_GetError());
+		return;
+	}
+	SDL_Joystick* js = SDL_GameControllerGetJoystick(dev);
+	SDL_JoystickID id = SDL_JoystickInstanceID(js);
+	string sguid = _guidString(SDL_JoystickGetGUID(js));
+	gamepads[id] = dev;
+	// first connected of identical devices is used for lookup by GUID
+	gamepad_ids.emplace(sguid, id);
+	if (gamepad == nullptr) {
+		gamepad = dev;
+	}
+
+	LOG_DEBUG(logger, "gamepad connected: ", SDL_JoystickName(js));
+	LOG_DEBUG(logger, "- GUID:     ", sguid);
+	LOG_DEBUG(logger, "  index:    ", to_string(idx));
+	LOG_DEBUG(logger, "  instance: ", to_string(id));
+}
+
+void Input::onGamepadRemoved(SDL_JoystickID id) {
+	auto iter = gamepads.find(id);
+	if (iter == gamepads.end()) {
+		return;
+	}
+	SDL_GameController* dev = iter->second;
+	gamepads.erase(iter);
+
+	SDL_Joystick* js = SDL_GameControllerGetJoystick(dev);
+	string sguid = _guidString(SDL_JoystickGetGUID(js));
+	auto id_iter = gamepad_ids.find(sguid);
+	if (id_iter != gamepad_ids.end() && id_iter->second == id) {
+		gamepad_ids.erase(id_iter);
+		// another identical device may still be attached
+		for (auto& dev_info: gamepads) {
+			if (_guidString(SDL_JoystickGetGUID(SDL_GameControllerGetJoystick(dev_info.second))) == sguid) {
+				gamepad_ids[sguid] = dev_info.first;
+				break;
+			}
 		}
-		SDL_Joystick* js = SDL_GameControllerGetJoystick(dev);
-		char sguid[33];
-		SDL_JoystickGetGUIDString(dev_guid, sguid, 33);
-		logger.debug("- GUID:  ", sguid);
-		logger.debug("  index: ", to_string(dev_idx));
-		logger.debug("  name:  ", SDL_JoystickName(js));
-		SDL_JoystickClose(js);
-		SDL_GameControllerClose(dev);
 	}
-#endif
+
+	LOG_DEBUG(logger, "gamepad disconnected: ", SDL_JoystickName(js));
+
+	if (gamepad == dev) {
+		gamepad = gamepads.empty() ? nullptr : gamepads.begin()->second;
+	}
+	SDL_GameControllerClose(dev);
 }
 
 void Input::translateGamepadHatEvent(SDL_JoyHatEvent evt) {
 	// TODO: allow to be customized
 	if (evt.value == 0) {
-		onKeyUp(SDLK_UP);
-		onKeyUp(SDLK_DOWN);
-		onKeyUp(SDLK_LEFT);
-		onKeyUp(SDLK_RIGHT);
+		onKeyUp(up, evt.timestamp);
+		onKeyUp(down, evt.timestamp);
+		onKeyUp(left, evt.timestamp);
+		onKeyUp(right, evt.timestamp);
 	}
 	if (evt.value & 8) {
-		onKeyDown(SDLK_LEFT);
+		onKeyDown(left, evt.timestamp);
 	}
 	if (evt.value & 2) {
-		onKeyDown(SDLK_RIGHT);
+		onKeyDown(right, evt.timestamp);
 	}
 	if (evt.value & 1) {
-		onKeyDown(SDLK_UP);
+		onKeyDown(up, evt.timestamp);
 	}
 	if (evt.value & 4) {
-		onKeyDown(SDLK_DOWN);
+		onKeyDown(down, evt.timestamp);
 	}
 }
 
 void Input::translateGamepadAxisEvent(SDL_JoyAxisEvent evt) {
-	// FIXME: need to veto if sensitivity threshold not met
-
-	// DEBUG:
-	// logger.debug("axis ", to_string(evt.axis), " value: ", to_string(evt.value));
+	if (evt.axis >= AXIS_COUNT) {
+		return;
+	}
+	// devices may report many positions per frame, only latest is kept
+	axis_values[evt.axis] = evt.value;
+	axis_changed |= 1 << evt.axis;
+	axis_time = evt.timestamp;
+}
 
-	// TODO:
+void Input::endFrame() {
+	if (axis_changed == 0) {
+		return;
+	}
+	if (!GameLoop::isPaused()) {
+		for (uint8_t axis = 0; axis < AXIS_COUNT; axis++) {
+			if (axis_changed & (1 << axis)) {
+				events.push_back({axis_time, InputEvent::AXIS, axis, axis_values[axis],
+						InputLatency::tag(axis_time)});
+			}
+		}
+	}
+	axis_changed = 0;
 }
 
 void Input::translateGamepadButtonEvent(uint8_t button, uint8_t state) {
-	// DEBUG:
-	string msg = "";
-	if (state == SDL_PRESSED) {
-		msg = "pressed ";
-	} else if (state == SDL_RELEASED) {
-		msg = "released ";
-	}
-	msg += "button " + to_string(button);
-	logger.debug(msg);
+	LOG_DEBUG(logger, state == SDL_PRESSED ? "pressed " : (state == SDL_RELEASED ? "released " : ""),
+			"button ", to_string(button));
 
 	// TODO:
 }
 
-bool Input::keyIsPressed(SDL_Keycode key) {
-	return find(this->pressed_keys.begin(), this->pressed_keys.end(), key) != this->pressed_keys.end();
+bool Input::keyIsDirection(SDL_Scancode key) {
+	return key == left || key == right || key == up || key == down;
 }
 
-bool Input::keyIsDirection(SDL_Keycode key) {
-	return key == left || key == right || key == up || key == down;
+uint8_t Input::keyToDirection(SDL_Scancode key) {
+	if (key == left) {
+		return MomentumDir::LEFT;
+	} else if (key == right) {
+		return MomentumDir::RIGHT;
+	} else if (key == up) {
+		return MomentumDir::UP;
+	} else if (key == down) {
+		return MomentumDir::DOWN;
+	}
+	return MomentumDir::NONE;
 }
 
 void Input::releaseKey(SDL_Keycode key, uint16_t mod) {
@@ -186,53 +242,122 @@ void Input::releaseKey(SDL_Keycode key, uint16_t mod) {
 	SDL_PushEvent((SDL_Event*) &event);
 }
 
-void Input::onKeyDown(SDL_Keycode keycode) {
-	if (this->keyIsPressed(keycode)) {
+void Input::applyEvent(const InputEvent& evt, Player*& player) {
+	uint8_t add = MomentumDir::NONE;
+	uint8_t remove = MomentumDir::NONE;
+	if (evt.type == InputEvent::AXIS) {
+		// TODO: allow axes to be customized
+		uint8_t neg, pos;
+		if (evt.code == 0) {
+			neg = MomentumDir::LEFT;
+			pos = MomentumDir::RIGHT;
+		} else if (evt.code == 1) {
+			neg = MomentumDir::UP;
+			pos = MomentumDir::DOWN;
+		} else {
+			return;
+		}
+		uint8_t held = MomentumDir::NONE;
+		if (evt.value <= -AXIS_DEADZONE) {
+			held = neg;
+		} else if (evt.value >= AXIS_DEADZONE) {
+			held = pos;
+		}
+		uint8_t prev = axis_dir & (neg | pos);
+		add = held & ~prev;
+		remove = prev & ~held;
+		axis_dir = (axis_dir & ~(neg | pos)) | held;
+	} else if (evt.type == InputEvent::KEY_DOWN) {
+		add = keyToDirection((SDL_Scancode) evt.code);
+	} else {
+		remove = keyToDirection((SDL_Scancode) evt.code);
+	}
+	if (add == MomentumDir::NONE && remove == MomentumDir::NONE) {
 		return;
 	}
-	this->pressed_keys.push_back(keycode);
 
-	if ((keycode == SDLK_RETURN || keycode == SDLK_KP_ENTER) && (keyIsPressed(SDLK_LALT)
-			|| keyIsPressed(SDLK_RALT))) {
+	if (!player) {
+		player = GetPlayer();
+		if (!player) {
+			return;
+		}
+	}
+	if (remove != MomentumDir::NONE) {
+		player->removeDirection(remove);
+	}
+	if (add != MomentumDir::NONE) {
+		player->addDirection(add);
+	}
+
+	LOG_DEBUG(logger, "Player direction: ", player->getDirection());
+}
+
+const InputSnapshot& Input::beginStep() {
+	if (!this->events.empty()) {
+		// axis positions are queued after keys received in same frame
+		stable_sort(this->events.begin(), this->events.end(),
+				[](const InputEvent& a, const InputEvent& b) { return a.time < b.time; });
+		// player is looked up once per step
+		Player* player = nullptr;
+		for (const InputEvent& evt: this->events) {
+			this->applyEvent(evt, player);
+			InputLatency::markApplied(evt.seq);
+		}
+		this->events.clear();
+	}
+
+	this->snapshot.down = this->keys;
+	this->snapshot.pressed = this->step_pressed;
+	this->snapshot.released = this->step_released;
+	this->step_pressed.reset();
+	this->step_released.reset();
+	return this->snapshot;
+}
+
+void Input::onKeyDown(SDL_Scancode key, uint64_t time) {
+	if (key >= SDL_NUM_SCANCODES || this->keyIsPressed(key)) {
+		return;
+	}
+	this->keys.set(key);
+	this->step_pressed.set(key);
+
+	if ((key == SDL_SCANCODE_RETURN || key == SDL_SCANCODE_KP_ENTER)
+			&& (keyIsPressed(SDL_SCANCODE_LALT) || keyIsPressed(SDL_SCANCODE_RALT))) {
 		GetGameWindow()->toggleFullscreen();
 		GameLoop::setPaused(true, "KB_ALT_ENTER");
 		// FIXME: key release simulation works but subsequent presses are still processed until actually released
 		//releaseKey(keycode, KMOD_ALT);
 		return;
 	}
+	if (key == this->profiler) {
+		FrameProfiler::toggleGraph();
+		return;
+	}
+	if (key == this->trace_dump) {
+		Trace::requestDump();
+		return;
+	}
+	if (key == this->memory_page) {
+		MemoryStats::togglePage();
+		return;
+	}
 	// don't process game loop keyboard events while paused
 	if (GameLoop::isPaused()) return;
 
-	if (keyIsDirection(keycode)) {
-		uint8_t new_dir = GetPlayerDirection();
-		switch(keycode) {
-			case SDLK_LEFT:
-				new_dir = AddPlayerDirection(MomentumDir::LEFT);
-				break;
-			case SDLK_RIGHT:
-				new_dir = AddPlayerDirection(MomentumDir::RIGHT);
-				break;
-			case SDLK_UP:
-				new_dir = AddPlayerDirection(MomentumDir::UP);
-				break;
-			case SDLK_DOWN:
-				new_dir = AddPlayerDirection(MomentumDir::DOWN);
-				break;
-		}
-
-#ifdef RRE_DEBUGGING
-		logger.debug("Player direction: ", to_string(new_dir));
-#endif
+	if (keyIsDirection(key)) {
+		this->events.push_back({time, InputEvent::KEY_DOWN, (uint16_t) key, 0,
+				InputLatency::tag(time)});
 	}
 }
 
-void Input::onKeyUp(SDL_Keycode keycode) {
-	if (!this->keyIsPressed(keycode)) {
+void Input::onKeyUp(SDL_Scancode key, uint64_t time) {
+	if (key >= SDL_NUM_SCANCODES || !this->keyIsPressed(key)) {
 		return;
 	}
-	this->pressed_keys.erase(remove(this->pressed_keys.begin(), this->pressed_keys.end(), keycode), this->pressed_keys.end());
+	this->keys.reset(key);
+	this->step_released.set(key);
 
-	if ((keycode == SDLK_RETURN || keycode == SDLK_KP_ENTER)
+	if ((key == SDL_SCANCODE_RETURN || key == SDL_SCANCODE_KP_ENTER)
 			&& GameLoop::isPaused("KB_ALT_ENTER")) {
 		GameLoop::setPaused(false);
 		return;
@@ -240,25 +365,8 @@ void Input::onKeyUp(SDL_Keycode keycode) {
 	// don't process game loop keyboard events while paused
 	if (GameLoop::isPaused()) return;
 
-	if (keyIsDirection(keycode)) {
-		uint8_t new_dir = GetPlayerDirection();
-		switch(keycode) {
-			case SDLK_LEFT:
-				new_dir = RemovePlayerDirection(MomentumDir::LEFT);
-				break;
-			case SDLK_RIGHT:
-				new_dir = RemovePlayerDirection(MomentumDir::RIGHT);
-				break;
-			case SDLK_UP:
-				new_dir = RemovePlayerDirection(MomentumDir::UP);
-				break;
-			case SDLK_DOWN:
-				new_dir = RemovePlayerDirection(MomentumDir::DOWN);
-				break;
-		}
-
-#ifdef RRE_DEBUGGING
-		logger.debug("Player direction: ", to_string(new_dir));
-#endif
+	if (keyIsDirection(key)) {
+		this->events.push_back({time, InputEvent::KEY_UP, (uint16_t) key, 0,
+				InputLatency::tag(time)});
 	}
 }
@@ -0,0 +1,195 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <algorithm> // std::nth_element
+#include <array>
+#include <cstdio> // snprintf
+#include <vector>
+
+#include <SDL2/SDL_events.h>
+#include <SDL2/SDL_timer.h>
+
+#include "GameLoop.hpp"
+#include "InputLatency.hpp"
+#include "Logger.hpp"
+
+using namespace std;
+
+
+namespace InputLatency {
+	static Logger& logger = Logger::getLogger("InputLatency");
+
+	/** Number of event times kept for events not yet presented. */
+	static const uint32_t PENDING_SIZE = 256;
+	/** Number of recent latencies used for percentile. */
+	static const uint32_t HISTORY_SIZE = 1024;
+
+	/** Most recently assigned sequence. */
+	static uint32_t seq_tagged = NO_SEQ;
+	/** Most recently applied sequence. */
+	static uint32_t seq_applied = NO_SEQ;
+	/** Most recent sequence reflected by frame being rendered. */
+	static uint32_t seq_rendered = NO_SEQ;
+	/** Most recent sequence measured. */
+	static uint32_t seq_presented = NO_SEQ;
+	/** Event times indexed by sequence modulo `PENDING_SIZE`. */
+	static array<uint64_t, PENDING_SIZE> pending;
+
+	static uint64_t samples = 0;
+	static uint64_t total = 0;
+	static uint32_t lowest = UINT32_MAX;
+	/** Recent latencies (ring buffer). */
+	static array<uint32_t, HISTORY_SIZE> history;
+
+	// synthetic injection
+
+	/** Delays in milliseconds cycled between injected events. */
+	static const array<uint32_t, 7> INJECT_DELAYS = {250, 287, 331, 262, 349, 303, 271};
+	/** Time in milliseconds allowed to reach scene before injection is abandoned. */
+	static const uint32_t INJECT_TIMEOUT = 30000;
+
+	static uint64_t inject_target = 0;
+	static uint64_t inject_deadline = 0;
+	static uint64_t inject_next = 0;
+	static uint32_t inject_count = 0;
+	/** Key currently held by injection. */
+	static SDL_Scancode inject_held = SDL_SCANCODE_UNKNOWN;
+
+	/**
+	 * Pushes a synthetic key event.
+	 */
+	static void pushKey(SDL_Scancode key, bool down);
+};
+
+uint32_t InputLatency::tag(uint64_t time) {
+	InputLatency::seq_tagged++;
+	if (InputLatency::seq_tagged == NO_SEQ) {
+		InputLatency::seq_tagged++;
+	}
+	InputLatency::pending[InputLatency::seq_tagged % PENDING_SIZE] = time;
+	return InputLatency::seq_tagged;
+}
+
+void InputLatency::markApplied(uint32_t seq) {
+	if (seq != NO_SEQ) {
+		InputLatency::seq_applied = seq;
+	}
+}
+
+void InputLatency::markRendered() {
+	InputLatency::seq_rendered = InputLatency::seq_applied;
+}
+
+void InputLatency::markPresented(uint64_t time) {
+	uint32_t seq = InputLatency::seq_presented;
+	if (seq == InputLatency::seq_rendered) {
+		return;
+	}
+	// event times older than pending buffer were overwritten
+	if (InputLatency::seq_rendered - seq > PENDING_SIZE) {
+		seq = InputLatency::seq_rendered - PENDING_SIZE;
+	}
+	while (seq != InputLatency::seq_rendered) {
+		seq++;
+		if (seq == NO_SEQ) {
+			continue;
+		}
+		uint64_t event_time = InputLatency::pending[seq % PENDING_SIZE];
+		uint32_t latency = time > event_time ? time - event_time : 0;
+		InputLatency::history[InputLatency::samples % HISTORY_SIZE] = latency;
+		InputLatency::samples++;
+		InputLatency::total += latency;
+		if (latency < InputLatency::lowest) {
+			InputLatency::lowest = latency;
+		}
+	}
+	InputLatency::seq_presented = seq;
+}
+
+InputLatencySnapshot InputLatency::getSnapshot() {
+	InputLatencySnapshot snapshot = {InputLatency::samples, 0, 0, 0};
+	if (snapshot.samples == 0) {
+		return snapshot;
+	}
+	snapshot.min = InputLatency::lowest;
+	snapshot.avg = (float) InputLatency::total / snapshot.samples;
+
+	size_t count = min<uint64_t>(snapshot.samples, HISTORY_SIZE);
+	vector<uint32_t> recent(InputLatency::history.begin(), InputLatency::history.begin() + count);
+	size_t idx = (count * 99) / 100;
+	if (idx >= count) {
+		idx = count - 1;
+	}
+	nth_element(recent.begin(), recent.begin() + idx, recent.end());
+	snapshot.p99 = recent[idx];
+	return snapshot;
+}
+
+string InputLatency::getSummary() {
+	InputLatencySnapshot snapshot = InputLatency::getSnapshot();
+	char text[64];
+	snprintf(text, sizeof(text), "INPUT: %uMS AVG: %.1fMS P99: %uMS", snapshot.min, snapshot.avg,
+			snapshot.p99);
+	return text;
+}
+
+void InputLatency::writeJson(ostream& out) {
+	InputLatencySnapshot snapshot = InputLatency::getSnapshot();
+	out << "{\"samples\":" << snapshot.samples << ",\"min_ms\":" << snapshot.min << ",\"avg_ms\":"
+			<< snapshot.avg << ",\"p99_ms\":" << snapshot.p99 << "}" << endl;
+}
+
+void InputLatency::pushKey(SDL_Scancode key, bool down) {
+	SDL_Event event = {};
+	event.type = down ? SDL_KEYDOWN : SDL_KEYUP;
+	event.key.timestamp = SDL_GetTicks();
+	event.key.state = down ? SDL_PRESSED : SDL_RELEASED;
+	event.key.keysym.scancode = key;
+	SDL_PushEvent(&event);
+}
+
+void InputLatency::startInjection(uint32_t count) {
+	InputLatency::inject_target = InputLatency::samples + count;
+	InputLatency::inject_deadline = SDL_GetTicks64() + INJECT_TIMEOUT;
+	InputLatency::inject_next = 0;
+	InputLatency::inject_count = 0;
+	InputLatency::inject_held = SDL_SCANCODE_UNKNOWN;
+}
+
+bool InputLatency::inject(uint64_t time_now) {
+	if (InputLatency::inject_target == 0) {
+		return false;
+	}
+	if (InputLatency::samples >= InputLatency::inject_target) {
+		return true;
+	}
+	GameMode::Mode mode = GameLoop::getMode();
+	if (mode != GameMode::SCENE && time_now > InputLatency::inject_deadline) {
+		logger.error("Scene not reached, injection abandoned");
+		return true;
+	}
+	if (time_now < InputLatency::inject_next || GameLoop::isPaused()) {
+		return false;
+	}
+
+	// previous key is released before next is pressed
+	if (InputLatency::inject_held != SDL_SCANCODE_UNKNOWN) {
+		InputLatency::pushKey(InputLatency::inject_held, false);
+		InputLatency::inject_held = SDL_SCANCODE_UNKNOWN;
+	} else if (mode == GameMode::TITLE) {
+		InputLatency::inject_held = SDL_SCANCODE_RETURN;
+	} else if (mode == GameMode::SCENE) {
+		// TODO: use configured binding
+		InputLatency::inject_held = SDL_SCANCODE_RIGHT;
+	}
+	if (InputLatency::inject_held != SDL_SCANCODE_UNKNOWN) {
+		InputLatency::pushKey(InputLatency::inject_held, true);
+	}
+
+	InputLatency::inject_next = time_now
+			+ INJECT_DELAYS[InputLatency::inject_count++ % INJECT_DELAYS.size()];
+	return false;
+}
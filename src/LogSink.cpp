@@ -0,0 +1,380 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib> // atexit
+#include <cstring> // memcpy
+#include <filesystem>
+#include <fstream>
+#include <functional> // std::hash
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "LogSink.hpp"
+#include "Path.hpp"
+
+using namespace std;
+
+
+namespace LogSink {
+	/** Max number of registered files. */
+	static const uint8_t MAX_FILES = 8;
+	/** Number of call sites tracked for rate limiting (sites may share an entry). */
+	static const uint32_t SITE_COUNT = 512;
+
+	/**
+	 * Buffered message.
+	 *
+	 * All state is zero initialized so that messages can be logged during static initialization.
+	 */
+	struct Slot {
+		/** Twice the lap (`pos / CAPACITY`) in which slot may be written, plus 1 once written. */
+		atomic<uint64_t> seq;
+		LogLevel level;
+		uint8_t file;
+		uint16_t length;
+		char text[MESSAGE_SIZE];
+	};
+
+	/** Rate limit state of a call site. */
+	struct Site {
+		/** Second of current counting window. */
+		atomic<uint64_t> window{0};
+		/** Messages in current window. */
+		atomic<uint32_t> count{0};
+		/** Messages suppressed since site was last allowed. */
+		atomic<uint32_t> suppressed{0};
+	};
+
+	static array<Slot, CAPACITY> ring;
+	/** Next position to be claimed by a producer. */
+	static atomic<uint64_t> head{0};
+	/** Next position to be read by writer. */
+	static uint64_t tail = 0;
+
+	static atomic<uint8_t> overflow{DROP};
+	static atomic<uint64_t> dropped{0};
+	/** Dropped count already reported by writer. */
+	static uint64_t dropped_reported = 0;
+
+	static atomic<uint32_t> rate_limit{0};
+	static array<Site, SITE_COUNT> sites;
+
+	/** Registered files, including default file. */
+	static atomic<uint8_t> file_count{1};
+	static atomic<bool> file_output{true};
+	/** Guards file registration. */
+	static mutex register_mtx;
+
+	/** Guards output streams. */
+	static mutex output_mtx;
+	/** Files that could not be opened. */
+	static array<bool, MAX_FILES> file_failed;
+
+	static thread writer;
+	static atomic<bool> running{false};
+
+	/**
+	 * Retrieves registered file paths.
+	 *
+	 * Created on first use as loggers register files during static initialization. Path of
+	 * default file is empty until resolved by `getDefaultPath`.
+	 */
+	static array<string, MAX_FILES>& getPaths() {
+		static array<string, MAX_FILES> paths;
+		return paths;
+	}
+
+	/**
+	 * Retrieves path of default file, resolving it on first use.
+	 *
+	 * Not resolved when loggers are registered as other static state, e.g. `Path::dir_root`, may
+	 * not yet be initialized.
+	 */
+	static const string& getDefaultPath();
+
+	/**
+	 * Makes a file path absolute & normalized.
+	 */
+	static string canonical(const string& path);
+
+	/**
+	 * Retrieves file output streams.
+	 */
+	static array<ofstream, MAX_FILES>& getFiles() {
+		static array<ofstream, MAX_FILES> files;
+		return files;
+	}
+
+	/**
+	 * Appends text to a file, opening it on first use.
+	 *
+	 * Caller must hold `output_mtx`.
+	 */
+	static void writeFile(uint8_t idx, const string& text);
+
+	/**
+	 * Writes a message directly.
+	 */
+	static void writeNow(LogLevel level, uint8_t file, const string& text);
+
+	/**
+	 * Writer thread loop.
+	 */
+	static void run();
+};
+
+const string& LogSink::getDefaultPath() {
+	static const string path = LogSink::canonical(
+			Path::join(Path::dirname(Path::getExecutable()), "debug.log"));
+	return path;
+}
+
+string LogSink::canonical(const string& path) {
+	error_code ec;
+	filesystem::path abs = filesystem::absolute(path, ec);
+	if (ec) {
+		return path;
+	}
+	return abs.lexically_normal().string();
+}
+
+void LogSink::writeFile(uint8_t idx, const string& text) {
+	if (!LogSink::file_output.load(memory_order_relaxed)
+			|| idx >= LogSink::file_count.load(memory_order_acquire) || LogSink::file_failed[idx]) {
+		return;
+	}
+	ofstream& fout = LogSink::getFiles()[idx];
+	if (!fout.is_open()) {
+		const string& path = idx == DEFAULT_FILE ? LogSink::getDefaultPath()
+				: LogSink::getPaths()[idx];
+		// previous session's messages are replaced
+		fout.open(path, ios::trunc);
+		if (!fout.is_open()) {
+			LogSink::file_failed[idx] = true;
+			cerr << "ERROR: (Logger) Cannot open log file: " << path << "\n";
+			return;
+		}
+	}
+	fout << text;
+	fout.flush();
+}
+
+void LogSink::writeNow(LogLevel level, uint8_t file, const string& text) {
+	lock_guard<mutex> lock(LogSink::output_mtx);
+	string line = text + "\n";
+	if (level == ERROR) {
+		cerr << line << flush;
+	} else {
+		cout << line << flush;
+	}
+	LogSink::writeFile(file, line);
+}
+
+void LogSink::run() {
+	string out, err;
+	array<string, MAX_FILES> file_out;
+
+	while (true) {
+		// read flag before draining so messages pushed before stop are written
+		bool stopping = !LogSink::running.load(memory_order_acquire);
+
+		while (true) {
+			LogSink::Slot& slot = LogSink::ring[LogSink::tail % CAPACITY];
+			uint64_t lap = LogSink::tail / CAPACITY;
+			if (slot.seq.load(memory_order_acquire) != lap * 2 + 1) {
+				break;
+			}
+			string& target = slot.level == ERROR ? err : out;
+			target.append(slot.text, slot.length);
+			target += '\n';
+			if (slot.file < MAX_FILES) {
+				file_out[slot.file].append(slot.text, slot.length);
+				file_out[slot.file] += '\n';
+			}
+			slot.seq.store((lap + 1) * 2, memory_order_release);
+			LogSink::tail++;
+		}
+
+		uint64_t drop_count = LogSink::dropped.load(memory_order_relaxed);
+		if (drop_count != LogSink::dropped_reported) {
+			err += "WARN:  (Logger) " + to_string(drop_count - LogSink::dropped_reported)
+					+ " messages dropped, log buffer full\n";
+			LogSink::dropped_reported = drop_count;
+		}
+
+		if (out.empty() && err.empty()) {
+			if (stopping) {
+				break;
+			}
+			this_thread::sleep_for(chrono::milliseconds(FLUSH_INTERVAL));
+			continue;
+		}
+
+		{
+			lock_guard<mutex> lock(LogSink::output_mtx);
+			if (!out.empty()) {
+				cout << out << flush;
+			}
+			if (!err.empty()) {
+				cerr << err << flush;
+			}
+			for (uint8_t idx = 0; idx < MAX_FILES; idx++) {
+				if (!file_out[idx].empty()) {
+					LogSink::writeFile(idx, file_out[idx]);
+					file_out[idx].clear();
+				}
+			}
+		}
+		out.clear();
+		err.clear();
+	}
+}
+
+void LogSink::start() {
+	if (LogSink::running.exchange(true)) {
+		return;
+	}
+
+	static bool registered = false;
+	if (!registered) {
+		// streams must outlive writer, which is joined at exit
+		LogSink::getPaths();
+		LogSink::getFiles();
+		LogSink::getDefaultPath();
+		atexit(LogSink::stop);
+		registered = true;
+	}
+	LogSink::writer = thread(LogSink::run);
+}
+
+void LogSink::stop() {
+	if (!LogSink::running.exchange(false)) {
+		return;
+	}
+	if (LogSink::writer.joinable()) {
+		LogSink::writer.join();
+	}
+}
+
+void LogSink::setOverflow(Overflow policy) {
+	LogSink::overflow.store(policy, memory_order_relaxed);
+}
+
+void LogSink::setRateLimit(uint32_t count) {
+	LogSink::rate_limit.store(count, memory_order_relaxed);
+}
+
+bool LogSink::allow(const char* file, uint32_t line, uint32_t& suppressed) {
+	suppressed = 0;
+	uint32_t limit = LogSink::rate_limit.load(memory_order_relaxed);
+	if (limit == 0) {
+		return true;
+	}
+
+	size_t idx = (hash<const void*>()(file) ^ (line * 2654435761u)) % SITE_COUNT;
+	LogSink::Site& site = LogSink::sites[idx];
+	uint64_t now = chrono::duration_cast<chrono::seconds>(
+			chrono::steady_clock::now().time_since_epoch()).count();
+	uint64_t window = site.window.load(memory_order_relaxed);
+	if (window != now && site.window.compare_exchange_strong(window, now, memory_order_relaxed)) {
+		site.count.store(0, memory_order_relaxed);
+	}
+	if (site.count.fetch_add(1, memory_order_relaxed) >= limit) {
+		site.suppressed.fetch_add(1, memory_order_relaxed);
+		return false;
+	}
+	suppressed = site.suppressed.exchange(0, memory_order_relaxed);
+	return true;
+}
+
+void LogSink::setFileOutput(bool enabled) {
+	LogSink::file_output.store(enabled, memory_order_relaxed);
+}
+
+uint8_t LogSink::addFile(const string& path) {
+	if (path.empty()) {
+		return DEFAULT_FILE;
+	}
+	string abs = LogSink::canonical(path);
+	if (abs == LogSink::getDefaultPath()) {
+		return DEFAULT_FILE;
+	}
+
+	lock_guard<mutex> lock(LogSink::register_mtx);
+	uint8_t count = LogSink::file_count.load(memory_order_relaxed);
+	for (uint8_t idx = DEFAULT_FILE + 1; idx < count; idx++) {
+		if (LogSink::getPaths()[idx] == abs) {
+			return idx;
+		}
+	}
+	if (count >= MAX_FILES) {
+		return NO_FILE;
+	}
+	LogSink::getPaths()[count] = abs;
+	LogSink::file_count.store(count + 1, memory_order_release);
+	return count;
+}
+
+string LogSink::getPath(uint8_t idx) {
+	if (idx == DEFAULT_FILE) {
+		return LogSink::getDefaultPath();
+	}
+	lock_guard<mutex> lock(LogSink::register_mtx);
+	if (idx >= LogSink::file_count.load(memory_order_relaxed)) {
+		return "";
+	}
+	return LogSink::getPaths()[idx];
+}
+
+void LogSink::push(LogLevel level, uint8_t file, const string& text) {
+	if (!LogSink::running.load(memory_order_acquire)) {
+		LogSink::writeNow(level, file, text);
+		return;
+	}
+
+	uint64_t pos = LogSink::head.load(memory_order_relaxed);
+	LogSink::Slot* slot;
+	while (true) {
+		slot = &LogSink::ring[pos % CAPACITY];
+		int64_t diff = (int64_t) (slot->seq.load(memory_order_acquire) - (pos / CAPACITY) * 2);
+		if (diff == 0) {
+			if (LogSink::head.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			// writer has not yet read slot in previous lap
+			if (LogSink::overflow.load(memory_order_relaxed) == SYNC) {
+				LogSink::writeNow(level, file, text);
+			} else {
+				LogSink::dropped.fetch_add(1, memory_order_relaxed);
+			}
+			return;
+		} else {
+			pos = LogSink::head.load(memory_order_relaxed);
+		}
+	}
+
+	size_t length = text.length();
+	if (length > MESSAGE_SIZE) {
+		length = MESSAGE_SIZE;
+		memcpy(slot->text, text.data(), length - 3);
+		memcpy(slot->text + length - 3, "...", 3);
+	} else {
+		memcpy(slot->text, text.data(), length);
+	}
+	slot->length = (uint16_t) length;
+	slot->level = level;
+	slot->file = file;
+	slot->seq.store((pos / CAPACITY) * 2 + 1, memory_order_release);
+}
+
+uint64_t LogSink::getDropped() {
+	return LogSink::dropped.load(memory_order_relaxed);
+}
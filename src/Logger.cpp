@@ -7,7 +7,6 @@
 #include "config.h"
 
 #include "Logger.hpp"
-#include "Path.hpp"
 
 using namespace std;
 
@@ -24,28 +23,16 @@ bool Logger::verbose = false;
 Logger::Logger(string id, LogLevel level, string file) {
 	this->id = id;
 	this->level = level;
-	if (file.compare("") == 0) {
-		file = Path::join(Path::dir_root, "debug.log");
-	}
-	this->file = file;
-
-	// TODO: get absolute path of 'file' parameter
+	// empty path registers default file, which is resolved when first written
+	this->file_idx = LogSink::addFile(file);
 
-#if RRE_DEBUGGING
 	if (Logger::verbose) {
-		this->debug("Initialized logging to file: \"" + this->file + "\"");
+		LOG_DEBUG(*this, "Initialized logging to file: \"" + this->getFile() + "\"");
 	}
-#endif
 }
 
 void Logger::setVerbose(bool verbose) {
 	Logger::verbose = verbose;
-#if RRE_DEBUGGING
-	Logger::getLogger("Logger").debug("Verbose output "
+	LOG_DEBUG(Logger::getLogger("Logger"), "Verbose output "
 			+ string(Logger::verbose ? "enabled" : "disabled"));
-#endif
-}
-
-void Logger::write(string msg) {
-	// TODO: export to file
 }
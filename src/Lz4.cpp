@@ -0,0 +1,161 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <cstring> // std::memcpy
+#include <vector>
+
+#include "Lz4.hpp"
+
+using namespace std;
+
+
+// format limits defined by LZ4 block specification
+static const size_t MIN_MATCH = 4;
+static const size_t LAST_LITERALS = 5;
+static const size_t MF_LIMIT = 12;
+static const size_t MAX_OFFSET = 65535;
+
+static const uint32_t HASH_BITS = 16;
+
+static uint32_t _read32(const uint8_t* p) {
+	uint32_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+static uint32_t _hash(uint32_t seq) {
+	return (seq * 2654435761U) >> (32 - HASH_BITS);
+}
+
+/**
+ * Writes a length continuation (bytes of 255 followed by remainder).
+ */
+static bool _writeLength(size_t len, uint8_t* dst, size_t& op, size_t cap) {
+	while (len >= 255) {
+		if (op >= cap) return false;
+		dst[op++] = 255;
+		len -= 255;
+	}
+	if (op >= cap) return false;
+	dst[op++] = (uint8_t) len;
+	return true;
+}
+
+/**
+ * Writes a sequence of literals optionally followed by a match.
+ */
+static bool _writeSequence(const uint8_t* literals, size_t lit_len, size_t offset, size_t match_len,
+		uint8_t* dst, size_t& op, size_t cap) {
+	if (op >= cap) return false;
+	size_t token_pos = op++;
+	uint8_t token = (uint8_t) ((lit_len >= 15 ? 15 : lit_len) << 4);
+	if (lit_len >= 15 && !_writeLength(lit_len - 15, dst, op, cap)) return false;
+	if (lit_len > cap - op) return false;
+	memcpy(dst + op, literals, lit_len);
+	op += lit_len;
+
+	if (match_len > 0) {
+		if (cap - op < 2) return false;
+		dst[op++] = (uint8_t) (offset & 0xff);
+		dst[op++] = (uint8_t) (offset >> 8);
+		size_t m = match_len - MIN_MATCH;
+		token |= (uint8_t) (m >= 15 ? 15 : m);
+		if (m >= 15 && !_writeLength(m - 15, dst, op, cap)) return false;
+	}
+	dst[token_pos] = token;
+	return true;
+}
+
+size_t Lz4::compress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_capacity) {
+	size_t ip = 0, anchor = 0, op = 0;
+
+	if (src_size >= MF_LIMIT) {
+		// most recent position of each hashed 4 byte sequence (offset by 1 so 0 means unset)
+		vector<uint32_t> table(1 << HASH_BITS, 0);
+		const size_t match_limit = src_size - LAST_LITERALS;
+
+		// last match must start at least MF_LIMIT bytes before end of block
+		while (ip + MF_LIMIT <= src_size) {
+			uint32_t seq = _read32(src + ip);
+			uint32_t h = _hash(seq);
+			size_t ref = table[h];
+			table[h] = (uint32_t) ip + 1;
+
+			if (ref == 0 || ip - (ref - 1) > MAX_OFFSET || _read32(src + ref - 1) != seq) {
+				ip++;
+				continue;
+			}
+			ref--;
+
+			size_t len = MIN_MATCH;
+			while (ip + len < match_limit && src[ref + len] == src[ip + len]) {
+				len++;
+			}
+			if (!_writeSequence(src + anchor, ip - anchor, ip - ref, len, dst, op, dst_capacity)) {
+				return 0;
+			}
+			ip += len;
+			anchor = ip;
+		}
+	}
+
+	// remaining bytes are written as literals
+	if (!_writeSequence(src + anchor, src_size - anchor, 0, 0, dst, op, dst_capacity)) {
+		return 0;
+	}
+	return op;
+}
+
+bool Lz4::decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+	size_t ip = 0, op = 0;
+	while (ip < src_size) {
+		uint8_t token = src[ip++];
+
+		size_t lit_len = token >> 4;
+		if (lit_len == 15) {
+			uint8_t b;
+			do {
+				if (ip >= src_size) return false;
+				b = src[ip++];
+				lit_len += b;
+			} while (b == 255);
+		}
+		if (lit_len > src_size - ip || lit_len > dst_size - op) return false;
+		memcpy(dst + op, src + ip, lit_len);
+		ip += lit_len;
+		op += lit_len;
+
+		// last sequence has no match
+		if (ip == src_size) {
+			break;
+		}
+
+		if (src_size - ip < 2) return false;
+		size_t offset = src[ip] | ((size_t) src[ip + 1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > op) return false;
+
+		size_t match_len = token & 15;
+		if (match_len == 15) {
+			uint8_t b;
+			do {
+				if (ip >= src_size) return false;
+				b = src[ip++];
+				match_len += b;
+			} while (b == 255);
+		}
+		match_len += MIN_MATCH;
+		if (match_len > dst_size - op) return false;
+
+		// byte-wise copy as match may overlap output
+		const uint8_t* match = dst + op - offset;
+		for (size_t idx = 0; idx < match_len; idx++) {
+			dst[op + idx] = match[idx];
+		}
+		op += match_len;
+	}
+	return op == dst_size;
+}
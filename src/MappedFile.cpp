@@ -0,0 +1,99 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#ifdef __WIN32__
+#include <windows.h> // CreateFileMapping, MapViewOfFile
+#else
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close
+#endif
+
+#include "MappedFile.hpp"
+
+using namespace std;
+
+
+MappedFile::MappedFile() {
+	data = nullptr;
+	size = 0;
+#ifdef __WIN32__
+	file_handle = INVALID_HANDLE_VALUE;
+	map_handle = nullptr;
+#endif
+}
+
+bool MappedFile::open(string path) {
+	close();
+
+#ifdef __WIN32__
+	file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file_handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER f_size;
+	if (!GetFileSizeEx(file_handle, &f_size) || f_size.QuadPart == 0) {
+		close();
+		return false;
+	}
+	map_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (map_handle == nullptr) {
+		close();
+		return false;
+	}
+	void* view = MapViewOfFile(map_handle, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr) {
+		close();
+		return false;
+	}
+	data = static_cast<const uint8_t*>(view);
+	size = static_cast<size_t>(f_size.QuadPart);
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+	void* view = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// mapping stays valid after descriptor is closed
+	::close(fd);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+	data = static_cast<const uint8_t*>(view);
+	size = static_cast<size_t>(st.st_size);
+#endif
+
+	return true;
+}
+
+void MappedFile::close() {
+#ifdef __WIN32__
+	if (data != nullptr) {
+		UnmapViewOfFile(data);
+	}
+	if (map_handle != nullptr) {
+		CloseHandle(map_handle);
+		map_handle = nullptr;
+	}
+	if (file_handle != INVALID_HANDLE_VALUE) {
+		CloseHandle(file_handle);
+		file_handle = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (data != nullptr) {
+		munmap(const_cast<uint8_t*>(data), size);
+	}
+#endif
+	data = nullptr;
+	size = 0;
+}
@@ -0,0 +1,134 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <cstdio> // snprintf
+
+#include "MemoryStats.hpp"
+#include "StrUtil.hpp"
+#include "TextureLoader.hpp"
+#include "store/AudioStore.hpp"
+#include "store/EntityStore.hpp"
+#include "store/FontMapStore.hpp"
+#include "store/SceneStore.hpp"
+#include "store/SpriteStore.hpp"
+
+using namespace std;
+
+
+namespace MemoryStats {
+	static bool page = false;
+
+	/**
+	 * Formats a byte count for on-screen display.
+	 */
+	static string _formatBytes(uint64_t bytes) {
+		char text[16];
+		if (bytes < 1024) {
+			snprintf(text, sizeof(text), "%lluB", (unsigned long long) bytes);
+		} else if (bytes < 1024 * 1024) {
+			snprintf(text, sizeof(text), "%lluK", (unsigned long long) bytes / 1024);
+		} else {
+			snprintf(text, sizeof(text), "%.1fM", bytes / (1024.0 * 1024.0));
+		}
+		return text;
+	}
+
+	/**
+	 * Formats a line of subsystem usage for on-screen display.
+	 */
+	static string _formatUsage(const string& label, const MemoryUsage& usage) {
+		return label + ": " + _formatBytes(usage.bytes) + " (" + to_string(usage.count) + ")";
+	}
+
+	/**
+	 * Writes subsystem usage as JSON object.
+	 */
+	static void _writeUsage(ostream& out, const MemoryUsage& usage) {
+		out << "{\"bytes\":" << usage.bytes << ",\"count\":" << usage.count << "}";
+	}
+
+	/**
+	 * Sums usage of all subsystems.
+	 *
+	 * Scene textures are not added as they are counted as loaded textures.
+	 */
+	static uint64_t _total(const MemoryUsage& textures, const MemoryUsage& entities,
+			const MemoryUsage& audio, const vector<pair<string, SceneMemory>>& scenes) {
+		uint64_t total = textures.bytes + entities.bytes + audio.bytes;
+		for (const auto& [id, memory]: scenes) {
+			total += memory.total() - memory.textures;
+		}
+		return total;
+	}
+};
+
+vector<string> MemoryStats::getSummary() {
+	MemoryUsage textures = TextureLoader::getMemoryUsage();
+	MemoryUsage entities = EntityStore::getMemoryUsage();
+	MemoryUsage audio = AudioStore::getMemoryUsage();
+	vector<pair<string, SceneMemory>> scenes = SceneStore::getMemoryBreakdown();
+
+	vector<string> lines;
+	lines.push_back("MEM: " + _formatBytes(_total(textures, entities, audio, scenes)));
+	lines.push_back(_formatUsage("TEXTURES", textures));
+	lines.push_back(_formatUsage(" SPRITES", SpriteStore::getMemoryUsage()));
+	lines.push_back(_formatUsage(" FONTS", FontMapStore::getMemoryUsage()));
+	for (const auto& [id, memory]: scenes) {
+		lines.push_back(StrUtil::toUpper(id) + ": " + _formatBytes(memory.total()) + " OBJ "
+				+ to_string(memory.objects));
+		lines.push_back(" TEX " + _formatBytes(memory.textures) + " TILE "
+				+ _formatBytes(memory.tile_layers));
+		lines.push_back(" COL " + _formatBytes(memory.collision) + " PROP "
+				+ _formatBytes(memory.properties));
+	}
+	lines.push_back(_formatUsage("ENTITIES", entities));
+	lines.push_back(_formatUsage("AUDIO", audio));
+	return lines;
+}
+
+void MemoryStats::writeReport(ostream& out) {
+	MemoryUsage textures = TextureLoader::getMemoryUsage();
+	MemoryUsage entities = EntityStore::getMemoryUsage();
+	MemoryUsage audio = AudioStore::getMemoryUsage();
+	vector<pair<string, SceneMemory>> scenes = SceneStore::getMemoryBreakdown();
+
+	MemoryUsage scene_usage;
+	for (const auto& [id, memory]: scenes) {
+		scene_usage.bytes += memory.total();
+		scene_usage.count++;
+	}
+
+	out << "{\"total\":" << _total(textures, entities, audio, scenes)
+			<< ",\"stores\":{\"TextureLoader\":";
+	_writeUsage(out, textures);
+	out << ",\"SpriteStore\":";
+	_writeUsage(out, SpriteStore::getMemoryUsage());
+	out << ",\"FontMapStore\":";
+	_writeUsage(out, FontMapStore::getMemoryUsage());
+	out << ",\"SceneStore\":";
+	_writeUsage(out, scene_usage);
+	out << ",\"EntityStore\":";
+	_writeUsage(out, entities);
+	out << ",\"AudioStore\":";
+	_writeUsage(out, audio);
+	out << "},\"scenes\":{";
+	bool first = true;
+	for (const auto& [id, memory]: scenes) {
+		out << (first ? "" : ",") << "\"" << id << "\":{\"textures\":" << memory.textures
+				<< ",\"tile_layers\":" << memory.tile_layers << ",\"collision\":" << memory.collision
+				<< ",\"properties\":" << memory.properties << ",\"objects\":" << memory.objects << "}";
+		first = false;
+	}
+	out << "}}" << endl;
+}
+
+void MemoryStats::togglePage() {
+	MemoryStats::page = !MemoryStats::page;
+}
+
+bool MemoryStats::pageVisible() {
+	return MemoryStats::page;
+}
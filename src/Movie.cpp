@@ -16,12 +16,26 @@
 using namespace std;
 
 
-Logger Movie::logger = Logger::getLogger("Movie");
+Logger& Movie::logger = Logger::getLogger("Movie");
+
+Movie::Movie(MovieFrameList frames) {
+	vector<string> paths;
+	for (MovieFrame f: frames) {
+		if (!this->frames.empty() && this->frames.back().first == f.first) {
+			// same image is displayed for combined duration
+			this->frames.back().second += f.second;
+			continue;
+		}
+		this->frames.push_back(f);
+		paths.push_back(f.first);
+	}
+	this->stream = new MovieStream(paths);
+}
 
 uint32_t Movie::getDuration() {
 	uint32_t ms = 0;
 	for (MovieFrame f: frames) {
-		ms += f.first;
+		ms += f.second;
 	}
 	return ms;
 }
@@ -38,15 +52,15 @@ void Movie::render(Renderer* ctx) {
 	}
 
 	uint16_t frames_count = this->frames.size();
-	if (!this->playing || frames_count == 0) {
+	if (!this->playing || frames_count == 0 || this->stream == nullptr) {
 		return;
 	}
 
 	uint32_t render_time = SDL_GetTicks64();
 
-	MovieFrame frame = this->frames[this->frame_index]; // @suppress("Invalid arguments")
+	uint32_t duration = this->frames[this->frame_index].second; // @suppress("Invalid arguments")
 
-	if (render_time - this->frame_start > frame.first) {
+	if (render_time - this->frame_start > duration) {
 		this->frame_index++;
 
 		if (this->frame_index >= frames_count) {
@@ -57,12 +71,13 @@ void Movie::render(Renderer* ctx) {
 		}
 
 		this->frame_start = render_time;
-		frame = this->frames[this->frame_index];
 	}
 
 	// frame image may be `null`
-	if (frame.second) {
-		ctx->drawImage(frame.second, 0, 0);
+	SDL_Rect rect;
+	SDL_Texture* texture = this->stream->getFrame(ctx, this->frame_index, rect);
+	if (texture != nullptr) {
+		ctx->drawTexture(texture, rect);
 	}
 
 	uint16_t y_offset = 0;
@@ -78,10 +93,8 @@ void Movie::render(Renderer* ctx) {
 }
 
 void Movie::onComplete() {
-#if RRE_DEBUGGING
-	logger.debug("movie duration: ", to_string(getDuration()), " (actual ",
+	LOG_DEBUG(logger, "movie duration: ", to_string(getDuration()), " (actual ",
 			to_string(SDL_GetTicks64() - frame_start), ")");
-#endif
 
 	// TODO: execute callback to notify thread that movie has finished
 }
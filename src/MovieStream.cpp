@@ -0,0 +1,268 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include "config.h"
+
+#include <algorithm> // std::max
+
+#include <SDL2/SDL_error.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_pixels.h>
+#include <SDL2/SDL_rwops.h>
+
+#include "MovieStream.hpp"
+#include "Trace.hpp"
+#include "Vfs.hpp"
+
+using namespace std;
+
+
+Logger& MovieStream::logger = Logger::getLogger("MovieStream");
+
+/**
+ * Calculates FNV-1a hash of surface pixels.
+ */
+static uint64_t _hashPixels(const SDL_Surface* surface) {
+	uint64_t h = 0xcbf29ce484222325ULL;
+	const size_t row_size = (size_t) surface->w * surface->format->BytesPerPixel;
+	const uint8_t* row = static_cast<const uint8_t*>(surface->pixels);
+	for (int32_t y = 0; y < surface->h; y++) {
+		// padding at end of rows is ignored
+		for (size_t idx = 0; idx < row_size; idx++) {
+			h ^= row[idx];
+			h *= 0x100000001b3ULL;
+		}
+		row += surface->pitch;
+	}
+	return h;
+}
+
+MovieStream::MovieStream(vector<string> paths, uint32_t ring_size) {
+	this->paths = paths;
+	// at least one slot must be available to worker while a frame is displayed
+	this->slots.resize(max(ring_size, (uint32_t) 2));
+	this->stopping = false;
+	this->display_slot = -1;
+	this->display_frame = 0;
+	this->late_frame = UINT32_MAX;
+	this->late_count = 0;
+
+	this->worker = thread(&MovieStream::decode, this);
+}
+
+MovieStream::~MovieStream() {
+	{
+		lock_guard<mutex> lock(mtx);
+		stopping = true;
+	}
+	cv.notify_all();
+	if (worker.joinable()) {
+		worker.join();
+	}
+
+	if (late_count > 0) {
+		LOG_DEBUG(logger, "frames not decoded in time: ", to_string(late_count));
+	}
+
+	for (Slot& slot: slots) {
+		if (slot.surface != nullptr) {
+			SDL_FreeSurface(slot.surface);
+		}
+		if (slot.texture != nullptr) {
+			SDL_DestroyTexture(slot.texture);
+		}
+	}
+	slots.clear();
+}
+
+void MovieStream::decode() {
+	Trace::setThreadName("movie");
+	// previous frame used to detect duplicates
+	bool prev_image = false;
+	int32_t prev_width = 0;
+	int32_t prev_height = 0;
+	uint64_t prev_hash = 0;
+
+	const uint32_t frames_count = paths.size();
+	for (uint32_t f = 0; f < frames_count; f++) {
+		Slot* slot = nullptr;
+		{
+			unique_lock<mutex> lock(mtx);
+			cv.wait(lock, [&]() {
+				if (stopping) {
+					return true;
+				}
+				for (Slot& s: slots) {
+					if (s.state == FREE) {
+						slot = &s;
+						return true;
+					}
+				}
+				return false;
+			});
+			if (stopping) {
+				return;
+			}
+		}
+
+		TraceZone zone("MovieStream::decode");
+		SDL_Surface* surface = nullptr;
+		uint64_t hash = 0;
+		if (!paths[f].empty()) {
+			surface = decodeImage(paths[f]);
+			if (surface != nullptr) {
+				hash = _hashPixels(surface);
+			}
+		}
+
+		const bool has_image = surface != nullptr;
+		bool duplicate = f > 0 && has_image == prev_image;
+		if (duplicate && has_image) {
+			duplicate = surface->w == prev_width && surface->h == prev_height && hash == prev_hash;
+		}
+
+		prev_image = has_image;
+		if (has_image) {
+			prev_width = surface->w;
+			prev_height = surface->h;
+			prev_hash = hash;
+		}
+
+		// pixels are kept as previous frame may have been skipped instead of displayed
+		lock_guard<mutex> lock(mtx);
+		slot->frame = f;
+		slot->duplicate = duplicate;
+		slot->surface = surface;
+		slot->state = DECODED;
+	}
+}
+
+SDL_Surface* MovieStream::decodeImage(const string& path) {
+	// only PNG supported
+	string vpath = path;
+	if (!vpath.ends_with(".png")) {
+		vpath += ".png";
+	}
+
+	VfsFile file = Vfs::read(vpath);
+	if (!file.ready()) {
+		logger.error("Failed to load movie frame, file not found: ", vpath);
+		return nullptr;
+	}
+
+	SDL_RWops* rw = SDL_RWFromConstMem(file.data, file.size);
+	if (rw == nullptr) {
+		logger.error("Failed to load movie frame \"", vpath, "\": ", SDL_GetError());
+		return nullptr;
+	}
+	SDL_Surface* loaded = IMG_Load_RW(rw, 1);
+	if (loaded == nullptr) {
+		logger.error("Failed to load movie frame \"", vpath, "\": ", IMG_GetError());
+		return nullptr;
+	}
+
+	// converted to texture format so upload is a plain copy
+	SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+	SDL_FreeSurface(loaded);
+	if (surface == nullptr) {
+		logger.error("Failed to convert movie frame \"", vpath, "\": ", SDL_GetError());
+	}
+	return surface;
+}
+
+void MovieStream::upload(Renderer* ctx, Slot& slot) {
+	SDL_Surface* surface = slot.surface;
+	slot.surface = nullptr;
+	slot.state = UPLOADED;
+	slot.has_image = false;
+	if (surface == nullptr) {
+		return;
+	}
+
+	// texture is only recreated if frame dimensions change
+	if (slot.texture == nullptr || slot.width != surface->w || slot.height != surface->h) {
+		if (slot.texture != nullptr) {
+			SDL_DestroyTexture(slot.texture);
+		}
+		slot.texture = ctx->createStreamingTexture(surface->w, surface->h);
+		slot.width = slot.texture != nullptr ? surface->w : 0;
+		slot.height = slot.texture != nullptr ? surface->h : 0;
+		if (slot.texture == nullptr) {
+			logger.error("Failed to create movie frame texture: ", SDL_GetError());
+		}
+	}
+
+	if (slot.texture != nullptr) {
+		if (SDL_UpdateTexture(slot.texture, nullptr, surface->pixels, surface->pitch) == 0) {
+			slot.has_image = true;
+		} else {
+			logger.error("Failed to update movie frame texture: ", SDL_GetError());
+		}
+	}
+	SDL_FreeSurface(surface);
+}
+
+SDL_Texture* MovieStream::getFrame(Renderer* ctx, uint32_t frame, SDL_Rect& rect) {
+	lock_guard<mutex> lock(mtx);
+
+	if (display_slot < 0 || frame != display_frame) {
+		int32_t next = -1;
+		bool released = false;
+		for (uint32_t idx = 0; idx < slots.size(); idx++) {
+			Slot& slot = slots[idx];
+			if (slot.state == FREE || (int32_t) idx == display_slot) {
+				continue;
+			}
+			if (slot.frame == frame) {
+				next = idx;
+			} else if (slot.frame < frame) {
+				// skipped frame
+				if (slot.surface != nullptr) {
+					SDL_FreeSurface(slot.surface);
+					slot.surface = nullptr;
+				}
+				slot.state = FREE;
+				released = true;
+			}
+		}
+
+		if (next >= 0) {
+			Slot& slot = slots[next];
+			if (slot.duplicate && display_slot >= 0 && display_frame + 1 == frame) {
+				// displayed slot already shows identical pixels
+				if (slot.surface != nullptr) {
+					SDL_FreeSurface(slot.surface);
+					slot.surface = nullptr;
+				}
+				slot.state = FREE;
+			} else {
+				upload(ctx, slot);
+				if (display_slot >= 0) {
+					slots[display_slot].state = FREE;
+				}
+				display_slot = next;
+			}
+			display_frame = frame;
+			released = true;
+		} else if (frame != late_frame) {
+			// counted once while waiting for worker
+			late_frame = frame;
+			late_count++;
+		}
+
+		if (released) {
+			cv.notify_one();
+		}
+	}
+
+	if (display_slot < 0 || !slots[display_slot].has_image) {
+		return nullptr;
+	}
+
+	Slot& slot = slots[display_slot];
+	rect = {0, 0, slot.width, slot.height};
+	return slot.texture;
+}
@@ -0,0 +1,256 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include "config.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility> // std::exchange
+
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_rwops.h>
+
+#include "Logger.hpp"
+#include "MusicPlayer.hpp"
+#include "Trace.hpp"
+#include "Vfs.hpp"
+
+using namespace std;
+
+
+namespace MusicPlayer {
+	static Logger& logger = Logger::getLogger("MusicPlayer");
+
+	/**
+	 * Opened music stream.
+	 *
+	 * NOTE: stream is not freed with track, moved with `std::exchange` & freed with `release`
+	 */
+	struct Track {
+		string path;
+		/** Encoded data (must outlive `music`). */
+		VfsFile data;
+		Mix_Music* music = nullptr;
+		/** Request the track was loaded for. */
+		uint32_t request = 0;
+	};
+
+	static uint32_t crossfade = 0;
+
+	static thread worker;
+	static mutex mtx;
+	static condition_variable cv;
+	static bool stopping = false;
+
+	// shared with worker, guarded by `mtx`
+
+	/** Most recent request (incremented to cancel requests in progress). */
+	static uint32_t request = 0;
+	/** Path requested to be loaded (empty if none). */
+	static string request_path;
+	/** Track finished loading by worker. */
+	static Track loaded;
+	static bool has_loaded = false;
+
+	// used by main thread only
+
+	/** Track playing or fading out. */
+	static Track active;
+	/** Track waiting for active track to fade out. */
+	static Track next;
+	static bool fading_out = false;
+
+	/** Worker loop loading requested tracks. */
+	static void load();
+
+	/**
+	 * Frees a track.
+	 *
+	 * NOTE: must not be playing as `Mix_FreeMusic` waits for fading music to finish
+	 */
+	static void release(Track& track);
+
+	/**
+	 * Fades out active track.
+	 */
+	static void fadeOut();
+};
+
+void MusicPlayer::load() {
+	Trace::setThreadName("music");
+	unique_lock<mutex> lock(MusicPlayer::mtx);
+	while (true) {
+		MusicPlayer::cv.wait(lock, [] {
+			return MusicPlayer::stopping || !MusicPlayer::request_path.empty();
+		});
+		if (MusicPlayer::stopping) {
+			return;
+		}
+
+		Track track;
+		track.path = MusicPlayer::request_path;
+		track.request = MusicPlayer::request;
+		MusicPlayer::request_path.clear();
+		lock.unlock();
+
+		uint64_t load_start = Trace::now();
+		track.data = Vfs::read(track.path);
+		if (!track.data.ready()) {
+			logger.warn("Failed to load music, file not found: \"", track.path, "\"");
+		} else {
+			// page in encoded data so that stream doesn't fault on disk reads while mixing
+			volatile uint8_t sum = 0;
+			for (size_t idx = 0; idx < track.data.size; idx += 4096) {
+				sum = sum + track.data.data[idx];
+			}
+			track.music = Mix_LoadMUS_RW(SDL_RWFromConstMem(track.data.data, track.data.size), 1);
+			if (track.music == nullptr) {
+				string audio_error = Mix_GetError();
+				if (audio_error.empty()) {
+					audio_error = "Failed to load music: \"" + track.path + "\"";
+				}
+				logger.warn(audio_error);
+			}
+		}
+
+		Trace::record("MusicPlayer::load", load_start, Trace::now());
+
+		lock.lock();
+		if (track.request != MusicPlayer::request) {
+			// cancelled while loading, free outside of lock
+			lock.unlock();
+			MusicPlayer::release(track);
+			lock.lock();
+			continue;
+		}
+		if (MusicPlayer::has_loaded) {
+			// previous result was never collected
+			Track stale = exchange(MusicPlayer::loaded, Track());
+			lock.unlock();
+			MusicPlayer::release(stale);
+			lock.lock();
+		}
+		MusicPlayer::loaded = exchange(track, Track());
+		MusicPlayer::has_loaded = true;
+	}
+}
+
+void MusicPlayer::release(Track& track) {
+	if (track.music != nullptr) {
+		Mix_FreeMusic(track.music);
+	}
+	track = Track();
+}
+
+void MusicPlayer::fadeOut() {
+	if (MusicPlayer::active.music == nullptr || MusicPlayer::fading_out) {
+		return;
+	}
+	if (MusicPlayer::crossfade / 2 == 0 || Mix_FadeOutMusic(MusicPlayer::crossfade / 2) == 0) {
+		Mix_HaltMusic();
+	}
+	MusicPlayer::fading_out = true;
+}
+
+void MusicPlayer::init(uint32_t crossfade) {
+	if (MusicPlayer::worker.joinable()) {
+		return;
+	}
+	MusicPlayer::crossfade = crossfade;
+	MusicPlayer::stopping = false;
+	MusicPlayer::worker = thread(MusicPlayer::load);
+}
+
+void MusicPlayer::shutdown() {
+	{
+		lock_guard<mutex> lock(MusicPlayer::mtx);
+		MusicPlayer::stopping = true;
+	}
+	MusicPlayer::cv.notify_all();
+	if (MusicPlayer::worker.joinable()) {
+		MusicPlayer::worker.join();
+	}
+
+	Mix_HaltMusic();
+	MusicPlayer::release(MusicPlayer::active);
+	MusicPlayer::release(MusicPlayer::next);
+	MusicPlayer::release(MusicPlayer::loaded);
+	MusicPlayer::has_loaded = false;
+	MusicPlayer::fading_out = false;
+}
+
+void MusicPlayer::play(string path) {
+	if (path.empty()) {
+		return;
+	}
+	lock_guard<mutex> lock(MusicPlayer::mtx);
+	bool pending = !MusicPlayer::request_path.empty() || MusicPlayer::next.music != nullptr
+			|| MusicPlayer::has_loaded;
+	if (!pending && !MusicPlayer::fading_out && MusicPlayer::active.path == path
+			&& MusicPlayer::active.music != nullptr) {
+		// already playing
+		return;
+	}
+
+	MusicPlayer::request++;
+	MusicPlayer::request_path = path;
+	MusicPlayer::cv.notify_one();
+}
+
+void MusicPlayer::stop() {
+	{
+		lock_guard<mutex> lock(MusicPlayer::mtx);
+		// cancel request in progress
+		MusicPlayer::request++;
+		MusicPlayer::request_path.clear();
+	}
+	MusicPlayer::release(MusicPlayer::next);
+	MusicPlayer::fadeOut();
+}
+
+void MusicPlayer::update() {
+	{
+		lock_guard<mutex> lock(MusicPlayer::mtx);
+		if (MusicPlayer::has_loaded) {
+			Track track = exchange(MusicPlayer::loaded, Track());
+			MusicPlayer::has_loaded = false;
+			if (track.request == MusicPlayer::request && track.music != nullptr) {
+				MusicPlayer::release(MusicPlayer::next);
+				MusicPlayer::next = exchange(track, Track());
+			} else {
+				MusicPlayer::release(track);
+			}
+		}
+	}
+
+	if (MusicPlayer::active.music != nullptr && Mix_PlayingMusic() == 0) {
+		// fade out complete
+		MusicPlayer::release(MusicPlayer::active);
+		MusicPlayer::fading_out = false;
+	}
+
+	if (MusicPlayer::next.music == nullptr) {
+		return;
+	}
+	if (MusicPlayer::active.music != nullptr) {
+		// next track starts once active track is silent
+		MusicPlayer::fadeOut();
+		return;
+	}
+
+	MusicPlayer::active = exchange(MusicPlayer::next, Track());
+	if (Mix_FadeInMusic(MusicPlayer::active.music, -1, MusicPlayer::crossfade / 2) != 0) {
+		string audio_error = Mix_GetError();
+		if (audio_error.empty()) {
+			audio_error = "Failed to play music: \"" + MusicPlayer::active.path + "\"";
+		}
+		logger.warn(audio_error);
+		MusicPlayer::release(MusicPlayer::active);
+	} else {
+		LOG_DEBUG(logger, "Playing music: ", MusicPlayer::active.path);
+	}
+}
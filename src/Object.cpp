@@ -7,4 +7,4 @@
 #include "Object.hpp"
 
 
-Logger Object::logger = Logger::getLogger("Object");
+Logger& Object::logger = Logger::getLogger("Object");
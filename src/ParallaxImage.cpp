@@ -7,7 +7,7 @@
 #include "ParallaxImage.hpp"
 
 
-Logger ParallaxImage::logger = Logger::getLogger("ParallaxImage");
+Logger& ParallaxImage::logger = Logger::getLogger("ParallaxImage");
 
 void ParallaxImage::render(Renderer* ctx, uint32_t x, uint32_t y) {
 	if (orientation == HORIZONTAL) {
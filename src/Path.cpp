@@ -126,7 +126,9 @@ string Path::getExecutable(bool trim_parent, bool trim_ext) {
 #ifdef __WIN32__
 	GetModuleFileName(NULL, buffer, PATH_MAX); // @suppress("Function cannot be resolved")
 #else
-	readlink("/proc/self/exe", buffer, PATH_MAX); // @suppress("Function cannot be resolved")
+	// result is not null terminated
+	ssize_t length = readlink("/proc/self/exe", buffer, PATH_MAX - 1);
+	buffer[length < 0 ? 0 : length] = '\0';
 #endif
 
 	string exe = (string) buffer;
@@ -10,7 +10,7 @@
 using namespace std;
 
 
-Logger Player::logger = Logger::getLogger("Player");
+Logger& Player::logger = Logger::getLogger("Player");
 
 Player::Player(shared_ptr<Sprite> sprite, uint32_t width, uint32_t height)
 : Character(sprite, width, height) {
@@ -61,6 +61,12 @@ void Player::onMoved() {
 	uint32_t half_res_w = NATIVE_RES.first / 2;
 	int32_t p_center = rect.x + (rect.w / 2);
 	int32_t diff = p_center - half_res_w;
+	if (scene->isStreamed()) {
+		// view of unbounded scene follows player on both axes
+		scene->setOffsetX(diff);
+		scene->setOffsetY(rect.y + (rect.h / 2) - (int32_t) (NATIVE_RES.second / 2));
+		return;
+	}
 	if (diff > 0 && p_center < scene->getWidth() - half_res_w) {
 		scene->setOffsetX(diff);
 	}
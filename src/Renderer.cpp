@@ -4,53 +4,85 @@
  * See: LICENSE.txt
  */
 
+#include <algorithm> // std::max
+#include <cstdio> // snprintf
+
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_video.h>
 
 #include "Renderer.hpp"
 #include "SingletonRepo.hpp"
+#include "Trace.hpp"
 
 using namespace std;
 
 
-Logger Renderer::logger = Logger::getLogger("Renderer");
+Logger& Renderer::logger = Logger::getLogger("Renderer");
 
 Renderer::Renderer() {
 	internal = SDL_CreateRenderer(GetGameWindow()->getElement(), -1,
 			SDL_RENDERER_ACCELERATED);
-	setBlendMode(SDL_BLENDMODE_BLEND);
-	setDrawColor(0, 0, 0, 0);
-	state = nullptr;
+	frames = 0;
+	bound = nullptr;
+	depth = 0;
+	scale = 1;
+	updateSize();
+
+	// initial state set directly as shadow copy is not yet valid
+	current = {{0, 0, 0, 0}, SDL_BLENDMODE_BLEND};
+	SDL_SetRenderDrawBlendMode(internal, current.blend_mode);
+	SDL_SetRenderDrawColor(internal, current.color.r, current.color.g, current.color.b,
+			current.color.a);
 }
 
 void Renderer::clear() {
+	TraceZone zone("Renderer::clear");
 	SDL_RenderClear(internal);
 }
 
 void Renderer::present() {
 	SDL_RenderPresent(internal);
+
+	frame_stats = stats;
+	total_stats.copies += stats.copies;
+	total_stats.texture_binds += stats.texture_binds;
+	total_stats.color_changes += stats.color_changes;
+	total_stats.blend_changes += stats.blend_changes;
+	total_stats.fills += stats.fills;
+	total_stats.fill_area += stats.fill_area;
+	total_stats.target_switches += stats.target_switches;
+	total_stats.redundant_changes += stats.redundant_changes;
+	stats = RenderStats();
+	frames++;
+	// first copy of next frame always binds
+	bound = nullptr;
 }
 
-void Renderer::save() {
-	// free previously saved state
-	clearState();
+void Renderer::setTarget(SDL_Texture* texture) {
+	SDL_SetRenderTarget(internal, texture);
+	stats.target_switches++;
+	bound = nullptr;
+}
 
-	// create new saved state
-	state = new RendererState();
-	SDL_GetRenderDrawColor(internal, &state->color.r, &state->color.g, &state->color.b,
-			&state->color.a);
-	SDL_GetRenderDrawBlendMode(internal, &state->blend_mode);
+void Renderer::save() {
+	if (depth < STATE_DEPTH) {
+		saved[depth] = current;
+	} else {
+		logger.error("Renderer state stack overflow (max depth ", to_string(STATE_DEPTH), ")");
+	}
+	// still counted so that saves & restores stay paired
+	depth++;
 }
 
 void Renderer::restore() {
-	if (!state) {
+	if (depth == 0) {
 		return;
 	}
-	setBlendMode(state->blend_mode);
-	setDrawColor(state->color);
-
-	// free saved state
-	clearState();
+	depth--;
+	if (depth < STATE_DEPTH) {
+		setBlendMode(saved[depth].blend_mode);
+		setDrawColor(saved[depth].color);
+	}
 }
 
 void Renderer::drawRect(SDL_Rect rect) {
@@ -63,6 +95,8 @@ void Renderer::drawRect(int32_t x, int32_t y, int32_t width, int32_t height) {
 
 void Renderer::fillRect(SDL_Rect rect) {
 	SDL_RenderFillRect(internal, &rect);
+	stats.fills++;
+	stats.fill_area += (uint64_t) max(rect.w, 0) * max(rect.h, 0);
 }
 
 void Renderer::fillRect(int32_t x, int32_t y, int32_t width, int32_t height) {
@@ -76,6 +110,11 @@ void Renderer::drawTexture(SDL_Texture* texture, SDL_Rect s_rect, SDL_Rect t_rec
 		return;
 	}
 	SDL_RenderCopyEx(internal, texture, &s_rect, &t_rect, 0, nullptr, flags);
+	stats.copies++;
+	if (texture != bound) {
+		stats.texture_binds++;
+		bound = texture;
+	}
 }
 
 void Renderer::drawImage(Image* img, uint32_t sx, uint32_t sy, uint32_t s_width,
@@ -113,47 +152,37 @@ void Renderer::drawImage(Image* img, uint32_t x, uint32_t y, SDL_RendererFlip fl
 }
 
 void Renderer::setScale(uint16_t scale) {
-	SDL_RenderSetScale(internal, scale, scale);
-}
-
-uint16_t Renderer::getScale() {
-	float scaleX;
-	SDL_RenderGetScale(internal, &scaleX, NULL);
-	return (uint16_t) scaleX;
-}
-
-uint32_t Renderer::getWidth() {
-	int32_t w;
-	SDL_GetWindowSize(SDL_RenderGetWindow(internal), &w, NULL);
-	return (uint32_t) w;
-}
-
-uint32_t Renderer::getHeight() {
-	int32_t h;
-	SDL_GetWindowSize(SDL_RenderGetWindow(internal), NULL, &h);
-	return (uint32_t) h;
+	// zero scale would divide internal size by zero
+	this->scale = max<uint16_t>(scale, 1);
+	SDL_RenderSetScale(internal, this->scale, this->scale);
 }
 
-uint32_t Renderer::getInternalWidth() {
-	return getWidth() / getScale();
-}
-
-uint32_t Renderer::getInternalHeight() {
-	return getHeight() / getScale();
+void Renderer::updateSize() {
+	int32_t w, h;
+	SDL_GetWindowSize(SDL_RenderGetWindow(internal), &w, &h);
+	width = (uint32_t) w;
+	height = (uint32_t) h;
 }
 
 void Renderer::setBlendMode(SDL_BlendMode blend_mode) {
+	if (blend_mode == current.blend_mode) {
+		stats.redundant_changes++;
+		return;
+	}
 	SDL_SetRenderDrawBlendMode(internal, blend_mode);
+	current.blend_mode = blend_mode;
+	stats.blend_changes++;
 }
 
 void Renderer::setDrawColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+	SDL_Color& color = current.color;
+	if (r == color.r && g == color.g && b == color.b && a == color.a) {
+		stats.redundant_changes++;
+		return;
+	}
 	SDL_SetRenderDrawColor(internal, r, g, b, a);
-}
-
-SDL_Color Renderer::getDrawColor() {
-	SDL_Color color;
-	SDL_GetRenderDrawColor(internal, &color.r, &color.g, &color.b, &color.a);
-	return color;
+	color = {r, g, b, a};
+	stats.color_changes++;
 }
 
 void Renderer::setDrawColor(SDL_Color color) {
@@ -164,6 +193,46 @@ SDL_Texture* Renderer::textureFromSurface(SDL_Surface* surface) {
 	return SDL_CreateTextureFromSurface(internal, surface);
 }
 
+SDL_Texture* Renderer::createStreamingTexture(int32_t width, int32_t height) {
+	SDL_Texture* texture = SDL_CreateTexture(internal, SDL_PIXELFORMAT_ARGB8888,
+			SDL_TEXTUREACCESS_STREAMING, width, height);
+	if (texture != nullptr) {
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	}
+	return texture;
+}
+
+SDL_Texture* Renderer::createTargetTexture(int32_t width, int32_t height) {
+	SDL_Texture* texture = SDL_CreateTexture(internal, SDL_PIXELFORMAT_RGBA32,
+			SDL_TEXTUREACCESS_TARGET, width, height);
+	if (texture != nullptr) {
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	}
+	return texture;
+}
+
 SDL_Texture* Renderer::textureFromPath(string path) {
 	return IMG_LoadTexture(internal, path.c_str());
 }
+
+string Renderer::getSummary() {
+	char text[64];
+	snprintf(text, sizeof(text), "DRAW:%llu TEX:%llu ST:%llu FILL:%lluK RT:%llu",
+			(unsigned long long) frame_stats.copies, (unsigned long long) frame_stats.texture_binds,
+			(unsigned long long) (frame_stats.color_changes + frame_stats.blend_changes),
+			(unsigned long long) frame_stats.fill_area / 1000,
+			(unsigned long long) frame_stats.target_switches);
+	return text;
+}
+
+void Renderer::writeJson(ostream& out) {
+	double count = frames > 0 ? frames : 1;
+	out << "{\"frames\":" << frames << ",\"copies\":" << total_stats.copies / count
+			<< ",\"texture_binds\":" << total_stats.texture_binds / count
+			<< ",\"color_changes\":" << total_stats.color_changes / count
+			<< ",\"blend_changes\":" << total_stats.blend_changes / count
+			<< ",\"fills\":" << total_stats.fills / count
+			<< ",\"fill_area\":" << total_stats.fill_area / count
+			<< ",\"target_switches\":" << total_stats.target_switches / count
+			<< ",\"redundant_changes\":" << total_stats.redundant_changes / count << "}" << endl;
+}
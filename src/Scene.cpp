@@ -5,25 +5,78 @@
  */
 
 #include <algorithm> // std::find, std::max, std::min
+#include <span>
+#include <utility> // std::swap
 
+#include "AllocStats.hpp"
+#include "FrameProfiler.hpp"
 #include "Scene.hpp"
 #include "SingletonRepo.hpp"
+#include "Trace.hpp"
 #include "enum/MomentumDir.hpp"
+#include "reso.hpp"
+#include "store/SceneStore.hpp"
 
 using namespace std;
 
 
-Logger Scene::logger = Logger::getLogger("Scene");
+Logger& Scene::logger = Logger::getLogger("Scene");
 
-void Scene::setLayerCollision(LayerDefinition ldef) {
-	collision = ldef;
+/**
+ * Retrieves profiler stage of a tile layer drawn behind objects.
+ */
+static FrameProfiler::Stage _layerStage(SceneLayer::Id id) {
+	if (id == SceneLayer::TERRAIN) {
+		return FrameProfiler::TERRAIN;
+	} else if (id == SceneLayer::COLLISION) {
+		return FrameProfiler::COLLISION;
+	}
+	return FrameProfiler::BACKGROUND;
+}
+
+bool Scene::dependsOn(const string& path) {
+	return find(dependencies.begin(), dependencies.end(), path) != dependencies.end();
+}
+
+void Scene::swapMap(Scene& other) {
+	std::swap(width, other.width);
+	std::swap(height, other.height);
+	std::swap(tile_width, other.tile_width);
+	std::swap(tile_height, other.tile_height);
+	std::swap(collision_map, other.collision_map);
+	std::swap(tilesets, other.tilesets);
+	std::swap(tileset_users, other.tileset_users);
+	std::swap(s_background, other.s_background);
+	std::swap(s_background2, other.s_background2);
+	std::swap(weather, other.weather);
+	for (uint8_t id = 0; id < SceneLayer::COUNT; id++) {
+		std::swap(layers[id], other.layers[id]);
+	}
+	std::swap(mapped_data, other.mapped_data);
+	std::swap(chunk_source, other.chunk_source);
+	std::swap(chunks, other.chunks);
+	std::swap(stream_radius, other.stream_radius);
+	std::swap(prefetch_steps, other.prefetch_steps);
+	std::swap(music, other.music);
+	std::swap(dependencies, other.dependencies);
+}
+
+void Scene::setLayerCollision(TileLayer layer, const uint8_t* bits) {
+	layers[SceneLayer::COLLISION] = std::move(layer);
+
+	uint32_t cols = (width + tile_width - 1) / tile_width;
+	uint32_t rows = (height + tile_height - 1) / tile_height;
+	collision_map = vector<vector<uint8_t>>(cols, vector<uint8_t>(rows, 0));
 
 	uint32_t offset_x = 0, offset_y = 0;
-	for (TileDefinition tdef: collision) {
+	size_t idx = 0;
+	for (const TileDefinition& tdef: layers[SceneLayer::COLLISION].getTiles()) {
 		// global IDs start at 1, not 0
-		if (tdef.first > 0) {
+		bool solid = bits != nullptr ? (bits[idx / 8] >> (idx % 8)) & 1 : tdef.first > 0;
+		if (solid) {
 			setCollisionPoint(offset_x, offset_y);
 		}
+		idx++;
 
 		offset_x++;
 		if (offset_x * tile_width >= width) {
@@ -33,7 +86,49 @@ void Scene::setLayerCollision(LayerDefinition ldef) {
 	}
 }
 
+SceneMemory Scene::getMemoryBreakdown() {
+	SceneMemory memory;
+	for (Tileset* ts: tilesets) {
+		memory.textures += ts->getByteSize();
+	}
+	for (ParallaxImage* img: {s_background, s_background2, weather}) {
+		if (img != nullptr) {
+			memory.textures += img->getByteSize();
+		}
+	}
+	for (const TileLayer& layer: layers) {
+		// NOTE: layers referencing mapped scene data don't hold heap memory
+		memory.tile_layers += layer.getByteSize();
+	}
+	for (const vector<uint8_t>& row: collision_map) {
+		memory.collision += row.capacity();
+	}
+	for (const auto& [key, chunk]: chunks) {
+		for (const TileLayer& layer: chunk.layers) {
+			memory.tile_layers += layer.getByteSize();
+		}
+		memory.collision += chunk.collision.capacity();
+	}
+	if (chunk_source) {
+		memory.tile_layers += chunk_source->getByteSize();
+	}
+	for (Object* obj: objects) {
+		memory.properties += obj->getByteSize();
+	}
+	memory.objects = objects.size();
+	if (player != nullptr) {
+		memory.properties += player->getByteSize();
+		memory.objects++;
+	}
+	return memory;
+}
+
 void Scene::logic() {
+	if (chunk_source) {
+		updateChunks();
+	}
+
+	NoAllocScope check("Scene::logic");
 	if (player) {
 		player->logic();
 	}
@@ -43,63 +138,267 @@ void Scene::logic() {
 }
 
 void Scene::render(Renderer* ctx) {
-	if (s_background2) {
-		s_background2->render(ctx, offset_x, offset_y);
-	}
-	if (s_background) {
-		s_background->render(ctx, offset_x, offset_y);
+	TraceZone zone("Scene::render");
+	NoAllocScope check("Scene::render");
+	{
+		FrameScope scope(FrameProfiler::PARALLAX);
+		if (s_background2) {
+			s_background2->render(ctx, offset_x, offset_y);
+		}
+		if (s_background) {
+			s_background->render(ctx, offset_x, offset_y);
+		}
 	}
 
 	// TODO: build layers as single image instead of drawing each tile individually
-	renderTileLayer(ctx, background);
-	renderTileLayer(ctx, terrain);
-	renderTileLayer(ctx, collision);
+	for (SceneLayer::Id id: {SceneLayer::BACKGROUND, SceneLayer::TERRAIN, SceneLayer::COLLISION}) {
+		FrameScope scope(_layerStage(id));
+		if (chunk_source) {
+			renderChunks(ctx, id);
+		} else {
+			renderTileLayer(ctx, layers[id]);
+		}
+	}
 
 	// TODO: render other layers behind objects
 
-	for (Object* obj: this->objects) {
-		obj->render(ctx);
-	}
-	// player instance not in object list
-	if (player != nullptr) {
-		player->render(ctx);
+	{
+		FrameScope scope(FrameProfiler::OBJECTS);
+		for (Object* obj: this->objects) {
+			obj->render(ctx);
+		}
+		// player instance not in object list
+		if (player != nullptr) {
+			player->render(ctx);
+		}
 	}
 
-	renderTileLayer(ctx, foreground);
+	{
+		FrameScope scope(FrameProfiler::FOREGROUND);
+		if (chunk_source) {
+			renderChunks(ctx, SceneLayer::FOREGROUND);
+		} else {
+			renderTileLayer(ctx, layers[SceneLayer::FOREGROUND]);
+		}
+	}
 
 	if (weather) {
+		FrameScope scope(FrameProfiler::WEATHER);
 		weather->render(ctx, offset_x, offset_y);
 	}
 }
 
-void Scene::renderTileLayer(Renderer* ctx, LayerDefinition ldef) {
-	int32_t g_offset_x = 0, g_offset_y = 0;
-	for (TileDefinition tdef: ldef) {
-		Tileset* tileset = nullptr;
-		// find tileset with matching GID
-		for (Tileset* t: tilesets) {
-			if (tdef.first >= t->getFirstGID() && tdef.first <= t->getLastGID()) {
-				tileset = t;
+void Scene::renderTileLayer(Renderer* ctx, const TileLayer& layer) {
+	span<const TileDefinition> tiles = layer.getTiles();
+	if (tiles.empty()) {
+		return;
+	}
+
+	// only tiles within view are drawn
+	const int32_t cols = (width + tile_width - 1) / tile_width;
+	const int32_t rows = (tiles.size() + cols - 1) / cols;
+	const int32_t first_col = max<int32_t>(offset_x / (int32_t) tile_width, 0);
+	const int32_t last_col = min<int32_t>((offset_x + NATIVE_RES.first) / (int32_t) tile_width, cols - 1);
+	const int32_t first_row = max<int32_t>(offset_y / (int32_t) tile_height, 0);
+	const int32_t last_row = min<int32_t>((offset_y + NATIVE_RES.second) / (int32_t) tile_height, rows - 1);
+
+	for (int32_t row = first_row; row <= last_row; row++) {
+		for (int32_t col = first_col; col <= last_col; col++) {
+			size_t idx = row * cols + col;
+			if (idx >= tiles.size()) {
 				break;
 			}
+			drawTile(ctx, tiles[idx].first, col * tile_width - offset_x, row * tile_height - offset_y);
 		}
+	}
+}
 
-		if (tileset != nullptr) {
-			uint32_t tile_index = tdef.first - tileset->getFirstGID();
-			uint32_t cols = tileset->getWidth() / tile_width;
-			uint32_t index_x = tile_index % cols;
-			uint32_t index_y = tile_index / cols;
+void Scene::renderChunks(Renderer* ctx, SceneLayer::Id layer) {
+	const int32_t cols = chunk_source->getChunkWidth();
+	const int32_t cw = cols * tile_width;
+	const int32_t ch = chunk_source->getChunkHeight() * tile_height;
+	const int32_t min_cx = SceneChunks::floorDiv(offset_x, cw);
+	const int32_t max_cx = SceneChunks::floorDiv(offset_x + NATIVE_RES.first - 1, cw);
+	const int32_t min_cy = SceneChunks::floorDiv(offset_y, ch);
+	const int32_t max_cy = SceneChunks::floorDiv(offset_y + NATIVE_RES.second - 1, ch);
 
-			ctx->drawImage(tileset, index_x*tile_width, index_y*tile_height, tile_width, tile_height,
-					g_offset_x - offset_x, g_offset_y - offset_y);
+	for (int32_t cy = min_cy; cy <= max_cy; cy++) {
+		for (int32_t cx = min_cx; cx <= max_cx; cx++) {
+			// chunks are loaded during logic step
+			SceneChunk* chunk = getChunk(cx, cy, false);
+			if (chunk == nullptr) {
+				continue;
+			}
+			span<const TileDefinition> tiles = chunk->layers[layer].getTiles();
+			for (size_t idx = 0; idx < tiles.size(); idx++) {
+				int32_t x = cx * cw + (idx % cols) * tile_width;
+				int32_t y = cy * ch + (idx / cols) * tile_height;
+				drawTile(ctx, tiles[idx].first, x - offset_x, y - offset_y);
+			}
 		}
+	}
+}
+
+void Scene::drawTile(Renderer* ctx, uint32_t gid, int32_t x, int32_t y) {
+	// global IDs start at 1, not 0
+	if (gid == 0) {
+		return;
+	}
 
-		g_offset_x += tile_width;
-		if (g_offset_x >= width) {
-			g_offset_y += tile_height;
-			g_offset_x = 0;
+	// find tileset with matching GID
+	for (Tileset* tileset: tilesets) {
+		if (!tileset->matches(gid)) {
+			continue;
 		}
+		if (!tileset->ready()) {
+			// streamed tileset not loaded
+			return;
+		}
+
+		uint32_t tile_index = gid - tileset->getFirstGID();
+		uint32_t cols = tileset->getWidth() / tile_width;
+		uint32_t index_x = tile_index % cols;
+		uint32_t index_y = tile_index / cols;
+
+		ctx->drawImage(tileset, index_x*tile_width, index_y*tile_height, tile_width, tile_height, x, y);
+		return;
+	}
+}
+
+void Scene::updateChunks() {
+	const int32_t cw = chunk_source->getChunkWidth() * tile_width;
+	const int32_t ch = chunk_source->getChunkHeight() * tile_height;
+	const int32_t radius = stream_radius;
+
+	// chunks within view & stream radius
+	int32_t min_cx = SceneChunks::floorDiv(offset_x, cw) - radius;
+	int32_t max_cx = SceneChunks::floorDiv(offset_x + NATIVE_RES.first - 1, cw) + radius;
+	int32_t min_cy = SceneChunks::floorDiv(offset_y, ch) - radius;
+	int32_t max_cy = SceneChunks::floorDiv(offset_y + NATIVE_RES.second - 1, ch) + radius;
+
+	// extend range in direction of player movement
+	if (player != nullptr) {
+		SDL_Rect rect = player->getRect();
+		int32_t ahead_x = (rect.x - player_prev.x) * (int32_t) prefetch_steps;
+		int32_t ahead_y = (rect.y - player_prev.y) * (int32_t) prefetch_steps;
+		if (ahead_x > 0) {
+			max_cx += (ahead_x + cw - 1) / cw;
+		} else if (ahead_x < 0) {
+			min_cx -= (cw - ahead_x - 1) / cw;
+		}
+		if (ahead_y > 0) {
+			max_cy += (ahead_y + ch - 1) / ch;
+		} else if (ahead_y < 0) {
+			min_cy -= (ch - ahead_y - 1) / ch;
+		}
+		player_prev = {rect.x, rect.y};
+	}
+
+	// evict chunks out of range keeping a margin of 1 chunk so that moving back & forth across
+	// a chunk border doesn't reload data repeatedly
+	bool changed = false;
+	for (auto iter = chunks.begin(); iter != chunks.end();) {
+		int32_t cx = (int32_t) (iter->first >> 32);
+		int32_t cy = (int32_t) (iter->first & 0xffffffff);
+		if (cx < min_cx - 1 || cx > max_cx + 1 || cy < min_cy - 1 || cy > max_cy + 1) {
+			releaseChunk(iter->second);
+			iter = chunks.erase(iter);
+			changed = true;
+		} else {
+			iter++;
+		}
+	}
+
+	size_t count = chunks.size();
+	for (int32_t cy = min_cy; cy <= max_cy; cy++) {
+		for (int32_t cx = min_cx; cx <= max_cx; cx++) {
+			getChunk(cx, cy, true);
+		}
+	}
+
+	if (changed || chunks.size() != count) {
+		SceneStore::updateUsage(this);
+	}
+}
+
+SceneChunk* Scene::getChunk(int32_t cx, int32_t cy, bool load) {
+	uint64_t key = SceneChunks::getKey(cx, cy);
+	auto iter = chunks.find(key);
+	if (iter != chunks.end()) {
+		return &iter->second;
+	}
+	if (!load || !chunk_source) {
+		return nullptr;
+	}
+
+	// NOTE: chunks without data are kept as well so source isn't queried again every step
+	SceneChunk& chunk = chunks[key];
+	if (!chunk_source->loadChunk(cx, cy, chunk)) {
+		return &chunk;
+	}
+
+	span<const TileDefinition> c_tiles = chunk.layers[SceneLayer::COLLISION].getTiles();
+	chunk.collision.resize(c_tiles.size());
+	for (size_t idx = 0; idx < c_tiles.size(); idx++) {
+		chunk.collision[idx] = c_tiles[idx].first > 0;
+	}
+
+	// load textures of tilesets used in chunk
+	uint32_t ts_prev = tilesets.size();
+	for (const TileLayer& layer: chunk.layers) {
+		for (const TileDefinition& tdef: layer.getTiles()) {
+			if (tdef.first == 0 || (ts_prev < tilesets.size() && tilesets[ts_prev]->matches(tdef.first))) {
+				continue;
+			}
+			for (uint32_t ts_idx = 0; ts_idx < tilesets.size(); ts_idx++) {
+				if (tilesets[ts_idx]->matches(tdef.first)) {
+					if (find(chunk.tilesets.begin(), chunk.tilesets.end(), ts_idx) == chunk.tilesets.end()) {
+						chunk.tilesets.push_back(ts_idx);
+					}
+					ts_prev = ts_idx;
+					break;
+				}
+			}
+		}
+	}
+	for (uint32_t ts_idx: chunk.tilesets) {
+		if (tileset_users[ts_idx]++ == 0 && !tilesets[ts_idx]->load()) {
+			logger.error("Failed to load tileset for chunk ", to_string(cx), ",", to_string(cy));
+		}
+	}
+
+	return &chunk;
+}
+
+void Scene::releaseChunk(SceneChunk& chunk) {
+	for (uint32_t ts_idx: chunk.tilesets) {
+		if (--tileset_users[ts_idx] == 0) {
+			tilesets[ts_idx]->unload();
+		}
+	}
+	chunk.tilesets.clear();
+}
+
+bool Scene::isCollision(int32_t x, int32_t y) {
+	if (!chunk_source) {
+		if (x < 0 || y < 0 || x >= (int32_t) collision_map.size() || y >= (int32_t) collision_map[x].size()) {
+			return false;
+		}
+		return collision_map[x][y];
+	}
+
+	const int32_t cols = chunk_source->getChunkWidth();
+	const int32_t rows = chunk_source->getChunkHeight();
+	int32_t cx = SceneChunks::floorDiv(x, cols), cy = SceneChunks::floorDiv(y, rows);
+	// chunks are only loaded by streaming, objects outside of streamed area are held in place
+	SceneChunk* chunk = getChunk(cx, cy, false);
+	if (chunk == nullptr) {
+		return true;
+	}
+	if (chunk->collision.empty()) {
+		return false;
 	}
+	return chunk->collision[(y - cy * rows) * cols + (x - cx * cols)];
 }
 
 
@@ -123,6 +422,8 @@ void Scene::removeObject(Object* obj) {
 void Scene::addPlayer(Player* player) {
 	player->setId(next_object_id);
 	this->player = player;
+	SDL_Rect rect = player->getRect();
+	player_prev = {rect.x, rect.y};
 	// increment for next object to be added
 	next_object_id++;
 	player->onAdded(this);
@@ -150,7 +451,7 @@ bool Scene::collidesGround(SDL_Rect rect) {
 	int32_t pos_y = small_rect.y + small_rect.h;
 	// check entire width of entity
 	for (int32_t pos_x = small_rect.x; pos_x < small_rect.x + small_rect.w; pos_x++) {
-		if (collision_map[pos_x][pos_y]) {
+		if (isCollision(pos_x, pos_y)) {
 			return true;
 		}
 	}
@@ -185,7 +486,7 @@ bool Scene::collidesWall(uint8_t dir, SDL_Rect rect) {
 	for (int32_t pos_y = small_rect.y; pos_y < small_rect.y + small_rect.h; pos_y++) {
 		// FIXME: should be looking at neighbor tile
 		// int32_t x = use_left ? pos_x - 1 : pos_x + 1;
-		if (collision_map[pos_x][pos_y]) {
+		if (isCollision(pos_x, pos_y)) {
 			return true;
 		}
 	}
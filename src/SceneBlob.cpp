@@ -0,0 +1,415 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <algorithm> // std::sort
+#include <cstring> // std::memchr, std::memcmp, std::memcpy
+#include <filesystem>
+#include <fstream>
+#include <type_traits> // std::is_standard_layout_v
+#include <unordered_map>
+#include <vector>
+
+#include <tmxlite/ImageLayer.hpp>
+#include <tmxlite/Map.hpp>
+#include <tmxlite/Property.hpp>
+#include <tmxlite/TileLayer.hpp>
+
+#include "Filesystem.hpp"
+#include "MappedFile.hpp"
+#include "SceneBlob.hpp"
+#include "SceneChunk.hpp"
+
+using namespace std;
+
+
+// tile arrays are referenced in place so must match layout written by compiler
+static_assert(sizeof(TileDefinition) == 8 && is_standard_layout_v<TileDefinition>,
+		"unsupported TileDefinition layout");
+
+
+/**
+ * Helper for building blob contents.
+ */
+class BlobWriter {
+private:
+	vector<uint8_t> strings;
+	unordered_map<string, uint32_t> string_index;
+
+public:
+	vector<uint8_t> data;
+
+	/** Appends raw bytes & returns their offset. */
+	uint64_t append(const void* src, size_t len) {
+		uint64_t offset = data.size();
+		const uint8_t* bytes = static_cast<const uint8_t*>(src);
+		data.insert(data.end(), bytes, bytes + len);
+		return offset;
+	}
+
+	/** Appends array of records & returns offset of first. */
+	template<typename T>
+	uint64_t append(const vector<T>& records) {
+		align();
+		return append(records.data(), records.size() * sizeof(T));
+	}
+
+	/** Appends a tile in `TileDefinition` layout with zeroed padding. */
+	void appendTile(uint32_t gid, uint8_t flip_flags) {
+		uint8_t tdef[sizeof(TileDefinition)] = {};
+		memcpy(tdef, &gid, sizeof(uint32_t));
+		tdef[sizeof(uint32_t)] = flip_flags;
+		append(tdef, sizeof(tdef));
+	}
+
+	/** Pads data to 8 byte boundary. */
+	void align() {
+		while (data.size() % 8 != 0) {
+			data.push_back(0);
+		}
+	}
+
+	/** Adds a string to string table & returns its offset. */
+	uint32_t intern(const string& str) {
+		auto iter = string_index.find(str);
+		if (iter != string_index.end()) {
+			return iter->second;
+		}
+		uint32_t offset = static_cast<uint32_t>(strings.size());
+		strings.insert(strings.end(), str.begin(), str.end());
+		strings.push_back('\0');
+		string_index[str] = offset;
+		return offset;
+	}
+
+	/** Appends string table & returns its offset. */
+	uint64_t appendStrings() {
+		align();
+		return append(strings.data(), strings.size());
+	}
+
+	size_t getStringsSize() { return strings.size(); }
+};
+
+
+string SceneBlob::getBlobPath(const string& tmx_path) {
+	return tmx_path + "b";
+}
+
+bool SceneBlob::compile(const string& tmx_path, const string& blob_path, uint32_t chunk_size,
+		string& error) {
+	tmx::Map map;
+	if (!map.load(tmx_path)) {
+		error = "failed to parse map";
+		return false;
+	}
+	if (chunk_size == 0 && map.isInfinite()) {
+		chunk_size = SceneChunks::DEFAULT_SIZE;
+	}
+
+	error_code ec;
+	int64_t mtime = Filesystem::getMTime(tmx_path, ec);
+	uint64_t fsize = filesystem::file_size(tmx_path, ec);
+	if (ec) {
+		error = ec.message();
+		return false;
+	}
+
+	filesystem::path map_dir = filesystem::path(tmx_path).parent_path();
+	if (map_dir.empty()) {
+		map_dir = ".";
+	}
+
+	BlobWriter writer;
+	Header header = {};
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.byte_order = ENDIAN_MARKER;
+	header.source_mtime = mtime;
+	header.source_size = fsize;
+	tmx::FloatRect bounds = map.getBounds();
+	header.width = static_cast<uint32_t>(bounds.width);
+	header.height = static_cast<uint32_t>(bounds.height);
+	header.tile_width = map.getTileSize().x;
+	header.tile_height = map.getTileSize().y;
+	header.chunk_width = chunk_size;
+	header.chunk_height = chunk_size;
+
+	// image paths are stored relative to map so that data directory can be relocated
+	auto relPath = [&](const string& path) -> uint32_t {
+		string rel = filesystem::relative(path, map_dir, ec).generic_string();
+		return writer.intern(rel.empty() ? path : rel);
+	};
+
+	vector<TilesetRecord> tilesets;
+	for (const tmx::Tileset& ts: map.getTilesets()) {
+		tilesets.push_back({ts.getFirstGID(), ts.getLastGID(), relPath(ts.getImagePath()), 0});
+	}
+
+	vector<ImageLayerRecord> image_layers;
+	vector<TileLayerRecord> tile_layers;
+	vector<const vector<tmx::TileLayer::Tile>*> tile_data;
+	vector<ChunkedLayer> chunked_data;
+	vector<uint8_t> collision;
+	for (auto& layer_ptr: map.getLayers()) {
+		const tmx::Layer& layer = *layer_ptr;
+		if (!layer.getVisible()) {
+			continue;
+		}
+
+		if (layer.getType() == tmx::Layer::Type::Image) {
+			const tmx::ImageLayer& i_layer = layer.getLayerAs<tmx::ImageLayer>();
+			if (i_layer.getImagePath().empty()) {
+				continue;
+			}
+			ImageLayerRecord record = {writer.intern(layer.getName()), relPath(i_layer.getImagePath()),
+					1.0f, 0};
+			for (const tmx::Property& prop: i_layer.getProperties()) {
+				if (prop.getName() == "scroll_rate" && prop.getType() == tmx::Property::Type::Float) {
+					record.scroll_rate = prop.getFloatValue();
+					break;
+				}
+			}
+			image_layers.push_back(record);
+		} else if (layer.getType() == tmx::Layer::Type::Tile) {
+			const tmx::TileLayer& t_layer = layer.getLayerAs<tmx::TileLayer>();
+			const vector<tmx::TileLayer::Tile>& tiles = t_layer.getTiles();
+			if (chunk_size > 0) {
+				ChunkedLayer chunks;
+				auto addTiles = [&](const vector<tmx::TileLayer::Tile>& src, int32_t x, int32_t y,
+						uint32_t width) {
+					LayerDefinition ldef;
+					ldef.reserve(src.size());
+					for (const tmx::TileLayer::Tile& tile: src) {
+						ldef.push_back(TileDefinition(tile.ID, tile.flipFlags));
+					}
+					SceneChunks::split(chunks, ldef, x, y, width, chunk_size, chunk_size);
+				};
+				if (map.isInfinite()) {
+					for (const tmx::TileLayer::Chunk& chunk: t_layer.getChunks()) {
+						addTiles(chunk.tiles, chunk.position.x, chunk.position.y, chunk.size.x);
+					}
+				} else {
+					addTiles(tiles, 0, 0, map.getTileCount().x);
+				}
+				tile_layers.push_back({writer.intern(layer.getName()), 0, 0});
+				chunked_data.push_back(move(chunks));
+				continue;
+			}
+
+			tile_layers.push_back({writer.intern(layer.getName()), static_cast<uint32_t>(tiles.size()), 0});
+			tile_data.push_back(&tiles);
+
+			if (layer.getName() == "collision") {
+				collision.assign((tiles.size() + 7) / 8, 0);
+				for (size_t idx = 0; idx < tiles.size(); idx++) {
+					// global IDs start at 1, not 0
+					if (tiles[idx].ID > 0) {
+						collision[idx / 8] |= 1 << (idx % 8);
+					}
+				}
+			}
+		}
+	}
+
+	vector<PropertyRecord> properties;
+	for (const tmx::Property& prop: map.getProperties()) {
+		PropertyRecord record = {};
+		record.name = writer.intern(prop.getName());
+		record.str_value = NO_STRING;
+		switch (prop.getType()) {
+			case tmx::Property::Type::String:
+				record.type = PropertyType::STRING;
+				record.str_value = writer.intern(prop.getStringValue());
+				break;
+			case tmx::Property::Type::Boolean:
+				record.type = PropertyType::BOOLEAN;
+				record.i_value = prop.getBoolValue() ? 1 : 0;
+				break;
+			case tmx::Property::Type::Int:
+				record.type = PropertyType::INT;
+				record.i_value = prop.getIntValue();
+				break;
+			case tmx::Property::Type::Float:
+				record.type = PropertyType::FLOAT;
+				record.f_value = prop.getFloatValue();
+				break;
+			default:
+				// unsupported property type
+				continue;
+		}
+		properties.push_back(record);
+	}
+
+	// header is written last once offsets are known
+	writer.append(&header, sizeof(Header));
+	header.tileset_count = static_cast<uint32_t>(tilesets.size());
+	header.tilesets_offset = writer.append(tilesets);
+	header.image_layer_count = static_cast<uint32_t>(image_layers.size());
+	header.image_layers_offset = writer.append(image_layers);
+	header.tile_layer_count = static_cast<uint32_t>(tile_layers.size());
+	header.property_count = static_cast<uint32_t>(properties.size());
+	header.properties_offset = writer.append(properties);
+
+	for (size_t idx = 0; idx < tile_data.size(); idx++) {
+		writer.align();
+		tile_layers[idx].tiles_offset = writer.data.size();
+		for (const tmx::TileLayer::Tile& tile: *tile_data[idx]) {
+			writer.appendTile(tile.ID, tile.flipFlags);
+		}
+	}
+	vector<ChunkRecord> chunks;
+	for (size_t idx = 0; idx < chunked_data.size(); idx++) {
+		for (const auto& [key, ldef]: chunked_data[idx]) {
+			ChunkRecord record = {};
+			record.x = static_cast<int32_t>(key >> 32);
+			record.y = static_cast<int32_t>(key & 0xffffffff);
+			record.layer = static_cast<uint32_t>(idx);
+			chunks.push_back(record);
+		}
+	}
+	// order by position so that chunks near each other share pages
+	sort(chunks.begin(), chunks.end(), [](const ChunkRecord& a, const ChunkRecord& b) {
+		if (a.y != b.y) return a.y < b.y;
+		if (a.x != b.x) return a.x < b.x;
+		return a.layer < b.layer;
+	});
+	for (ChunkRecord& record: chunks) {
+		writer.align();
+		record.tiles_offset = writer.data.size();
+		const LayerDefinition& ldef = chunked_data[record.layer].at(SceneChunks::getKey(record.x, record.y));
+		for (const TileDefinition& tile: ldef) {
+			writer.appendTile(tile.first, tile.second);
+		}
+	}
+
+	header.tile_layers_offset = writer.append(tile_layers);
+	header.chunk_count = static_cast<uint32_t>(chunks.size());
+	header.chunks_offset = writer.append(chunks);
+
+	header.collision_offset = writer.append(collision);
+	header.collision_size = collision.size();
+	header.strings_size = writer.getStringsSize();
+	header.strings_offset = writer.appendStrings();
+	memcpy(writer.data.data(), &header, sizeof(Header));
+
+	// write to temporary file first so readers never see partial blob
+	string tmp_path = blob_path + ".tmp";
+	ofstream fout(tmp_path, ios::binary | ios::trunc);
+	if (!fout.is_open()) {
+		error = "cannot open output file";
+		return false;
+	}
+	fout.write(reinterpret_cast<const char*>(writer.data.data()), writer.data.size());
+	fout.close();
+	if (!fout) {
+		error = "failed to write output file";
+		filesystem::remove(tmp_path, ec);
+		return false;
+	}
+	filesystem::rename(tmp_path, blob_path, ec);
+	if (ec) {
+		error = ec.message();
+		return false;
+	}
+	return true;
+}
+
+bool SceneBlob::Reader::open(const string& blob_path, const string& tmx_path, string& error) {
+	shared_ptr<MappedFile> file = make_shared<MappedFile>();
+	if (!file->open(blob_path)) {
+		header = nullptr;
+		error = "cannot map file";
+		return false;
+	}
+	const uint8_t* file_data = file->getData();
+	size_t file_size = file->getSize();
+	if (!open(file, file_data, file_size, error)) {
+		return false;
+	}
+
+	// source map changed since blob was compiled
+	error_code ec;
+	int64_t mtime = Filesystem::getMTime(tmx_path, ec);
+	uint64_t fsize = filesystem::file_size(tmx_path, ec);
+	if (!ec && isStale(mtime, fsize)) {
+		header = nullptr;
+		error = "stale";
+		return false;
+	}
+	return true;
+}
+
+bool SceneBlob::Reader::open(shared_ptr<const void> owner, const uint8_t* data, size_t size,
+		string& error) {
+	header = nullptr;
+	this->owner = owner;
+	this->data = data;
+	this->size = size;
+
+	if (size < sizeof(Header)) {
+		error = "truncated header";
+		return false;
+	}
+	if (reinterpret_cast<uintptr_t>(data) % alignof(Header) != 0) {
+		error = "misaligned data";
+		return false;
+	}
+	const Header* h = reinterpret_cast<const Header*>(data);
+	if (memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0) {
+		error = "not a scene blob";
+		return false;
+	}
+	if (h->version != VERSION || h->byte_order != ENDIAN_MARKER) {
+		error = "incompatible format version";
+		return false;
+	}
+
+	auto inBounds = [size](uint64_t offset, uint64_t len) {
+		return offset <= size && len <= size - offset;
+	};
+	if (!inBounds(h->tilesets_offset, h->tileset_count * sizeof(TilesetRecord))
+			|| !inBounds(h->image_layers_offset, h->image_layer_count * sizeof(ImageLayerRecord))
+			|| !inBounds(h->tile_layers_offset, h->tile_layer_count * sizeof(TileLayerRecord))
+			|| !inBounds(h->properties_offset, h->property_count * sizeof(PropertyRecord))
+			|| !inBounds(h->collision_offset, h->collision_size)
+			|| !inBounds(h->strings_offset, h->strings_size)
+			|| !inBounds(h->chunks_offset, h->chunk_count * sizeof(ChunkRecord))) {
+		error = "corrupt section offsets";
+		return false;
+	}
+
+	header = h;
+	for (const TileLayerRecord& layer: getTileLayers()) {
+		if (layer.tiles_offset % alignof(TileDefinition) != 0
+				|| !inBounds(layer.tiles_offset, layer.tile_count * sizeof(TileDefinition))) {
+			header = nullptr;
+			error = "corrupt tile layer";
+			return false;
+		}
+	}
+	uint64_t chunk_bytes = (uint64_t) h->chunk_width * h->chunk_height * sizeof(TileDefinition);
+	for (const ChunkRecord& chunk: getChunks()) {
+		if (chunk.layer >= h->tile_layer_count || chunk.tiles_offset % alignof(TileDefinition) != 0
+				|| !inBounds(chunk.tiles_offset, chunk_bytes)) {
+			header = nullptr;
+			error = "corrupt chunk";
+			return false;
+		}
+	}
+	return true;
+}
+
+string SceneBlob::Reader::getString(uint32_t offset) const {
+	if (offset == NO_STRING || offset >= header->strings_size) {
+		return "";
+	}
+	const char* str = reinterpret_cast<const char*>(data + header->strings_offset + offset);
+	const void* end = memchr(str, '\0', header->strings_size - offset);
+	if (end == nullptr) {
+		return "";
+	}
+	return string(str, static_cast<const char*>(end) - str);
+}
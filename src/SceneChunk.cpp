@@ -0,0 +1,48 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include "SceneChunk.hpp"
+
+using namespace std;
+
+
+void SceneChunks::split(ChunkedLayer& layer, span<const TileDefinition> tiles, int32_t x, int32_t y,
+		uint32_t width, uint32_t chunk_width, uint32_t chunk_height) {
+	if (width == 0) {
+		return;
+	}
+	const int32_t cw = chunk_width, ch = chunk_height;
+	for (size_t idx = 0; idx < tiles.size(); idx++) {
+		// global IDs start at 1, not 0
+		if (tiles[idx].first == 0) {
+			continue;
+		}
+		int32_t tx = x + (int32_t) (idx % width);
+		int32_t ty = y + (int32_t) (idx / width);
+		int32_t cx = floorDiv(tx, cw), cy = floorDiv(ty, ch);
+
+		LayerDefinition& chunk = layer[getKey(cx, cy)];
+		if (chunk.empty()) {
+			chunk.resize(chunk_width * chunk_height, TileDefinition(0, 0));
+		}
+		chunk[(ty - cy * ch) * cw + (tx - cx * cw)] = tiles[idx];
+	}
+}
+
+SceneLayer::Id SceneChunks::getLayerId(const string& name) {
+	if (name == "background") {
+		return SceneLayer::BACKGROUND;
+	} else if (name == "terrain") {
+		return SceneLayer::TERRAIN;
+	} else if (name == "objects") {
+		return SceneLayer::OBJECTS;
+	} else if (name == "collision") {
+		return SceneLayer::COLLISION;
+	} else if (name == "foreground") {
+		return SceneLayer::FOREGROUND;
+	}
+	return SceneLayer::COUNT;
+}
@@ -0,0 +1,120 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <vector>
+
+#include <SDL2/SDL_mixer.h>
+
+#include "Logger.hpp"
+#include "SoundPlayer.hpp"
+
+using namespace std;
+
+
+namespace SoundPlayer {
+	static Logger& logger = Logger::getLogger("SoundPlayer");
+
+	/** Sound assigned to a channel. */
+	struct Voice {
+		SoundId sound = AudioStore::NO_SOUND;
+		uint8_t priority = 0;
+		/** Order in which voice was started. */
+		uint64_t started = 0;
+	};
+
+	/** Voices indexed by channel. */
+	static vector<Voice> voices;
+	/** Frame in which each sound was most recently triggered indexed by sound identifier. */
+	static vector<uint64_t> triggered;
+	/** Current frame (0 means never triggered). */
+	static uint64_t frame = 1;
+	/** Number of voices started. */
+	static uint64_t started = 0;
+};
+
+void SoundPlayer::init(uint8_t channels) {
+	int32_t allocated = Mix_AllocateChannels(channels);
+	if (allocated < channels) {
+		logger.warn("Only ", to_string(allocated), " of ", to_string(channels),
+				" sound channels allocated");
+	}
+	SoundPlayer::voices.assign(allocated, Voice());
+}
+
+void SoundPlayer::shutdown() {
+	Mix_HaltChannel(-1);
+	SoundPlayer::voices.clear();
+	SoundPlayer::triggered.clear();
+}
+
+int32_t SoundPlayer::play(SoundId id) {
+	const SoundEffect* sound = AudioStore::getSound(id);
+	if (sound == nullptr) {
+		return -1;
+	}
+
+	if (id < SoundPlayer::triggered.size()) {
+		if (SoundPlayer::triggered[id] == SoundPlayer::frame) {
+			// already started this frame
+			return -1;
+		}
+		SoundPlayer::triggered[id] = SoundPlayer::frame;
+	}
+
+	int32_t free_channel = -1;
+	// oldest instance of same sound
+	int32_t oldest_same = -1;
+	uint32_t same_count = 0;
+	// oldest voice with lowest priority
+	int32_t lowest = -1;
+	for (int32_t ch = 0; ch < (int32_t) SoundPlayer::voices.size(); ch++) {
+		if (Mix_Playing(ch) == 0) {
+			if (free_channel < 0) {
+				free_channel = ch;
+			}
+			continue;
+		}
+		const Voice& voice = SoundPlayer::voices[ch];
+		if (voice.sound == id) {
+			same_count++;
+			if (oldest_same < 0 || voice.started < SoundPlayer::voices[oldest_same].started) {
+				oldest_same = ch;
+			}
+		}
+		if (lowest < 0 || voice.priority < SoundPlayer::voices[lowest].priority
+				|| (voice.priority == SoundPlayer::voices[lowest].priority
+				&& voice.started < SoundPlayer::voices[lowest].started)) {
+			lowest = ch;
+		}
+	}
+
+	int32_t channel;
+	if (same_count >= sound->max_voices) {
+		channel = oldest_same;
+	} else if (free_channel >= 0) {
+		channel = free_channel;
+	} else if (lowest >= 0 && SoundPlayer::voices[lowest].priority <= sound->priority) {
+		channel = lowest;
+	} else {
+		return -1;
+	}
+
+	// sound playing on channel is halted
+	channel = Mix_PlayChannel(channel, sound->chunk, 0);
+	if (channel < 0) {
+		return -1;
+	}
+	SoundPlayer::voices[channel] = {id, sound->priority, ++SoundPlayer::started};
+	return channel;
+}
+
+void SoundPlayer::update() {
+	SoundPlayer::frame++;
+	// sized once sounds are loaded so that playing doesn't allocate
+	if (SoundPlayer::triggered.size() != AudioStore::getSoundCount()) {
+		SoundPlayer::triggered.assign(AudioStore::getSoundCount(), 0);
+	}
+}
@@ -4,10 +4,23 @@
  * See: LICENSE.txt
  */
 
+#include <utility> // std::swap
+
 #include "Sprite.hpp"
 
+using namespace std;
+
 
-Logger Sprite::logger = Logger::getLogger("Sprite");
+Logger& Sprite::logger = Logger::getLogger("Sprite");
+
+void Sprite::swap(Sprite& other) {
+	std::swap(texture, other.texture);
+	std::swap(width, other.width);
+	std::swap(height, other.height);
+	std::swap(tile_width, other.tile_width);
+	std::swap(tile_height, other.tile_height);
+	std::swap(tile_index, other.tile_index);
+}
 
 void Sprite::render(Renderer* ctx, uint32_t x, uint32_t y, SDL_RendererFlip flags) {
 	if (!ready()) {
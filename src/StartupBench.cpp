@@ -0,0 +1,230 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <algorithm> // std::sort
+#include <cstdlib> // std::system
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h> // _getpid
+#else
+#include <unistd.h> // getpid
+#endif
+
+#include "DataLoader.hpp"
+#include "GameLoop.hpp"
+#include "Logger.hpp"
+#include "Path.hpp"
+#include "SingletonRepo.hpp"
+#include "StartupBench.hpp"
+#include "StartupMetrics.hpp"
+
+using namespace std;
+
+
+namespace StartupBench {
+	static Logger& logger = Logger::getLogger("StartupBench");
+
+	/** Samples collected for a phase over all runs of a kind. */
+	struct PhaseSamples {
+		string name;
+		vector<uint64_t> times;
+		uint64_t bytes = 0;
+		uint32_t count = 0;
+	};
+
+	/** Samples collected for a kind of run (cold or warm). */
+	struct RunSamples {
+		/** Phases in order first seen. */
+		vector<PhaseSamples> phases;
+		unordered_map<string, size_t> index;
+	};
+
+	/**
+	 * Launches engine in a child process for a single run.
+	 *
+	 * @param output
+	 *   File child writes measurements to.
+	 * @param data_path
+	 *   Game data path (empty for default).
+	 * @return
+	 *   `true` if child exited successfully.
+	 */
+	static bool launch(const string& output, const string& data_path);
+
+	/**
+	 * Adds measurements written by a child process.
+	 *
+	 * @param samples
+	 *   Samples to add to.
+	 * @param output
+	 *   File child wrote measurements to.
+	 * @return
+	 *   `true` if file was read.
+	 */
+	static bool collect(RunSamples& samples, const string& output);
+
+	/**
+	 * Calculates median of samples.
+	 */
+	static uint64_t median(vector<uint64_t> values);
+
+	/**
+	 * Writes JSON object for a kind of run.
+	 */
+	static void writeJson(ostream& out, const RunSamples& samples);
+};
+
+bool StartupBench::launch(const string& output, const string& data_path) {
+	string cmd = "\"" + Path::getExecutable() + "\" --bench-run \"" + output + "\"";
+	if (!data_path.empty()) {
+		cmd += " --data \"" + data_path + "\"";
+	}
+#ifdef _WIN32
+	// cmd.exe strips outer quotes of entire command
+	cmd = "\"" + cmd + " >NUL 2>&1\"";
+#else
+	cmd += " >/dev/null 2>&1";
+#endif
+	return system(cmd.c_str()) == 0;
+}
+
+bool StartupBench::collect(RunSamples& samples, const string& output) {
+	ifstream fin(output);
+	if (!fin.is_open()) {
+		return false;
+	}
+
+	string line;
+	while (getline(fin, line)) {
+		istringstream fields(line);
+		string name;
+		uint64_t time = 0, bytes = 0;
+		uint32_t count = 0;
+		if (!getline(fields, name, '\t') || !(fields >> time >> bytes >> count)) {
+			continue;
+		}
+
+		auto iter = samples.index.find(name);
+		if (iter == samples.index.end()) {
+			iter = samples.index.emplace(name, samples.phases.size()).first;
+			samples.phases.push_back({name});
+		}
+		PhaseSamples& phase = samples.phases[iter->second];
+		phase.times.push_back(time);
+		// same data is loaded each run
+		phase.bytes = bytes;
+		phase.count = count;
+	}
+	return true;
+}
+
+uint64_t StartupBench::median(vector<uint64_t> values) {
+	if (values.empty()) {
+		return 0;
+	}
+	sort(values.begin(), values.end());
+	size_t mid = values.size() / 2;
+	if (values.size() % 2 == 0) {
+		return (values[mid - 1] + values[mid]) / 2;
+	}
+	return values[mid];
+}
+
+void StartupBench::writeJson(ostream& out, const RunSamples& samples) {
+	out << "{";
+	// milestones are written as object members
+	for (const char* milestone: {"ttff", "tti"}) {
+		auto iter = samples.index.find(milestone);
+		uint64_t value = 0;
+		if (iter != samples.index.end()) {
+			value = StartupBench::median(samples.phases[iter->second].times);
+		}
+		out << "\"" << milestone << "_us\":" << value << ",";
+	}
+	out << "\"phases\":[";
+	bool first = true;
+	for (const PhaseSamples& phase: samples.phases) {
+		if (phase.name == "ttff" || phase.name == "tti") {
+			continue;
+		}
+		if (!first) {
+			out << ",";
+		}
+		first = false;
+		out << "{\"name\":\"" << phase.name << "\",\"median_us\":" << StartupBench::median(phase.times)
+				<< ",\"bytes\":" << phase.bytes << ",\"count\":" << phase.count << "}";
+	}
+	out << "]}";
+}
+
+int StartupBench::run(uint32_t runs, string data_path) {
+	if (runs == 0) {
+		logger.error("Benchmark requires at least 1 run");
+		return 1;
+	}
+
+#ifdef _WIN32
+	int pid = _getpid();
+#else
+	int pid = getpid();
+#endif
+	// unique per process so that concurrent benchmarks don't overwrite each other's results
+	string output = (filesystem::temp_directory_path() / ("rre-startup-bench-" + to_string(pid)
+			+ ".tsv")).string();
+	string cache_dir = Path::rabs("cache");
+
+	RunSamples cold, warm;
+	for (uint32_t idx = 0; idx < runs; idx++) {
+		logger.info("Startup run ", to_string(idx + 1), "/", to_string(runs), " ...");
+
+		error_code ec;
+		filesystem::remove_all(cache_dir, ec);
+		if (ec) {
+			logger.warn("Failed to clear cache (", ec.message(), "): ", cache_dir);
+		}
+
+		if (!StartupBench::launch(output, data_path) || !StartupBench::collect(cold, output)) {
+			logger.error("Cold startup run failed");
+			return 1;
+		}
+		if (!StartupBench::launch(output, data_path) || !StartupBench::collect(warm, output)) {
+			logger.error("Warm startup run failed");
+			return 1;
+		}
+	}
+	filesystem::remove(output);
+
+	cout << "{\"runs\":" << runs << ",\"cold\":";
+	StartupBench::writeJson(cout, cold);
+	cout << ",\"warm\":";
+	StartupBench::writeJson(cout, warm);
+	cout << "}" << endl;
+	return 0;
+}
+
+int StartupBench::runChild(string output) {
+	// first frame
+	GameLoop::setMode(GameMode::INTRO);
+	GetViewport()->render();
+	StartupMetrics::markFirstFrame();
+
+	// entering scene mode requires all queued data
+	GameLoop::setMode(GameMode::SCENE);
+	GetViewport()->render();
+	if (!DataLoader::ready()) {
+		logger.error("Game data not loaded");
+		return 1;
+	}
+	StartupMetrics::markInteractive();
+
+	return StartupMetrics::writePhases(output) ? 0 : 1;
+}
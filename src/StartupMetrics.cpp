@@ -0,0 +1,109 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include "config.h"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include "Logger.hpp"
+#include "StartupMetrics.hpp"
+
+using namespace std;
+
+
+namespace StartupMetrics {
+	static Logger& logger = Logger::getLogger("StartupMetrics");
+
+	static chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	static uint64_t first_frame = 0;
+	static uint64_t interactive = 0;
+
+	static vector<StartupPhase> phases;
+	/** Phase indexes by name. */
+	static unordered_map<string, size_t> phase_index;
+
+	/**
+	 * Formats microseconds as milliseconds with fraction.
+	 */
+	static string _formatMs(uint64_t us) {
+		string frac = to_string(us % 1000);
+		return to_string(us / 1000) + "." + string(3 - frac.length(), '0') + frac + "ms";
+	}
+};
+
+void StartupMetrics::begin() {
+	StartupMetrics::start = chrono::steady_clock::now();
+	StartupMetrics::first_frame = 0;
+	StartupMetrics::interactive = 0;
+}
+
+uint64_t StartupMetrics::elapsed() {
+	return chrono::duration_cast<chrono::microseconds>(
+			chrono::steady_clock::now() - StartupMetrics::start).count();
+}
+
+void StartupMetrics::markFirstFrame() {
+	if (StartupMetrics::first_frame != 0) {
+		return;
+	}
+	StartupMetrics::first_frame = StartupMetrics::elapsed();
+	logger.info("Time to first frame: ", _formatMs(StartupMetrics::first_frame));
+}
+
+void StartupMetrics::markInteractive() {
+	if (StartupMetrics::interactive != 0) {
+		return;
+	}
+	StartupMetrics::interactive = StartupMetrics::elapsed();
+	logger.info("Time to interactive: ", _formatMs(StartupMetrics::interactive));
+
+	for (const StartupPhase& phase: StartupMetrics::phases) {
+		LOG_DEBUG(logger, "  ", phase.name, ": ", _formatMs(phase.time), " (",
+				to_string(phase.count), "x, ", to_string(phase.bytes), " bytes)");
+	}
+}
+
+uint64_t StartupMetrics::getTimeToFirstFrame() {
+	return StartupMetrics::first_frame;
+}
+
+uint64_t StartupMetrics::getTimeToInteractive() {
+	return StartupMetrics::interactive;
+}
+
+void StartupMetrics::record(const char* name, uint64_t time, uint64_t bytes) {
+	auto iter = StartupMetrics::phase_index.find(name);
+	if (iter == StartupMetrics::phase_index.end()) {
+		StartupMetrics::phase_index[name] = StartupMetrics::phases.size();
+		StartupMetrics::phases.push_back({name, time, bytes, 1});
+		return;
+	}
+	StartupPhase& phase = StartupMetrics::phases[iter->second];
+	phase.time += time;
+	phase.bytes += bytes;
+	phase.count++;
+}
+
+const vector<StartupPhase>& StartupMetrics::getPhases() {
+	return StartupMetrics::phases;
+}
+
+bool StartupMetrics::writePhases(const string& path) {
+	ofstream fout(path, ios::trunc);
+	if (!fout.is_open()) {
+		logger.error("Failed to write startup phases: ", path);
+		return false;
+	}
+	fout << "ttff\t" << StartupMetrics::first_frame << "\t0\t1\n";
+	fout << "tti\t" << StartupMetrics::interactive << "\t0\t1\n";
+	for (const StartupPhase& phase: StartupMetrics::phases) {
+		fout << phase.name << "\t" << phase.time << "\t" << phase.bytes << "\t" << phase.count << "\n";
+	}
+	return fout.good();
+}
@@ -12,7 +12,7 @@
 using namespace std;
 
 
-static Logger logger = Logger::getLogger("StrUtil");
+static Logger& logger = Logger::getLogger("StrUtil");
 
 string StrUtil::trim(string st) {
 	std::size_t f = st.find_first_not_of(" \t\n\r\f\v");
@@ -40,7 +40,7 @@ string StrUtil::toUpper(string st) {
 	return u_value;
 }
 
-ParseResult StrUtil::parseShort(int16_t& s, string st) {
+ParseResult StrUtil::parseShort(int16_t& s, const string& st) {
 	ParseResult res;
 	try {
 		s = static_cast<int16_t>(stoi(st));
@@ -52,7 +52,7 @@ ParseResult StrUtil::parseShort(int16_t& s, string st) {
 	return res;
 }
 
-ParseResult StrUtil::parseUShort(uint16_t& s, string st) {
+ParseResult StrUtil::parseUShort(uint16_t& s, const string& st) {
 	ParseResult res;
 	try {
 		s = static_cast<uint16_t>(stoul(st));
@@ -64,7 +64,7 @@ ParseResult StrUtil::parseUShort(uint16_t& s, string st) {
 	return res;
 }
 
-ParseResult StrUtil::parseInt(int32_t& i, string st) {
+ParseResult StrUtil::parseInt(int32_t& i, const string& st) {
 	ParseResult res;
 	try {
 		i = stoi(st);
@@ -76,7 +76,7 @@ ParseResult StrUtil::parseInt(int32_t& i, string st) {
 	return res;
 }
 
-ParseResult StrUtil::parseUInt(uint32_t& i, string st) {
+ParseResult StrUtil::parseUInt(uint32_t& i, const string& st) {
 	ParseResult res;
 	try {
 		i = static_cast<uint32_t>(stoul(st));
@@ -88,7 +88,7 @@ ParseResult StrUtil::parseUInt(uint32_t& i, string st) {
 	return res;
 }
 
-ParseResult StrUtil::parseLong(int64_t& l, string st) {
+ParseResult StrUtil::parseLong(int64_t& l, const string& st) {
 	ParseResult res;
 	try {
 		l = stoll(st);
@@ -100,7 +100,7 @@ ParseResult StrUtil::parseLong(int64_t& l, string st) {
 	return res;
 }
 
-ParseResult StrUtil::parseULong(uint64_t& l, string st) {
+ParseResult StrUtil::parseULong(uint64_t& l, const string& st) {
 	ParseResult res;
 	try {
 		l = stoull(st);
@@ -112,7 +112,7 @@ ParseResult StrUtil::parseULong(uint64_t& l, string st) {
 	return res;
 }
 
-ParseResult StrUtil::parseFloat(float& f, string st) {
+ParseResult StrUtil::parseFloat(float& f, const string& st) {
 	ParseResult res;
 	try {
 		f = stof(st);
@@ -124,7 +124,7 @@ ParseResult StrUtil::parseFloat(float& f, string st) {
 	return res;
 }
 
-ParseResult StrUtil::parseDouble(double& d, string st) {
+ParseResult StrUtil::parseDouble(double& d, const string& st) {
 	ParseResult res;
 	try {
 		d = stod(st);
@@ -136,7 +136,7 @@ ParseResult StrUtil::parseDouble(double& d, string st) {
 	return res;
 }
 
-ParseResult StrUtil::parseBool(bool& b, string st) {
+ParseResult StrUtil::parseBool(bool& b, const string& st) {
 	ParseResult res;
 	string temp = StrUtil::toLower(StrUtil::trim(st));
 	bool t = temp.compare("true") == 0;
@@ -5,20 +5,38 @@
  * See: LICENSE.txt
  */
 
+#include <unordered_map>
+
 #include <SDL2/SDL_error.h>
 #include <SDL2/SDL_image.h>
+#include <SDL2/SDL_pixels.h>
 #include <SDL2/SDL_rwops.h>
 #include <SDL2/SDL_surface.h>
 
 #include "Logger.hpp"
-#include "Path.hpp"
 #include "SingletonRepo.hpp"
+#include "StartupMetrics.hpp"
 #include "TextureLoader.hpp"
+#include "Vfs.hpp"
 
 using namespace std;
 
 
-static Logger logger = Logger::getLogger("TextureLoader");
+static Logger& logger = Logger::getLogger("TextureLoader");
+
+/** Estimated sizes of loaded textures that have not been destroyed. */
+static unordered_map<SDL_Texture*, size_t> _loaded;
+/** Total of `_loaded` sizes. */
+static uint64_t _loaded_bytes = 0;
+
+/**
+ * Adds a texture to loaded texture usage.
+ */
+static void _track(SDL_Texture* texture) {
+	size_t bytes = TextureLoader::getByteSize(texture);
+	_loaded[texture] = bytes;
+	_loaded_bytes += bytes;
+}
 
 SDL_Texture* TextureLoader::absLoad(string apath) {
 	// TODO: cache loaded textures
@@ -28,23 +46,37 @@ SDL_Texture* TextureLoader::absLoad(string apath) {
 		logger.error("Failed to load texture: ", IMG_GetError());
 	} else {
 		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+		_track(texture);
 	}
 
 	return texture;
 }
 
 SDL_Texture* TextureLoader::load(string rdpath) {
-	// absolute path to image data file (only PNG supported)
-	string apath = Path::rabs(Path::join("data", rdpath));
-	if (!apath.ends_with(".png")) {
-		apath += ".png";
+	// only PNG supported
+	if (!rdpath.ends_with(".png")) {
+		rdpath += ".png";
+	}
+
+	// decoded directly from mapped file or archive memory
+	VfsFile file = Vfs::read(rdpath);
+	if (!file.ready()) {
+		logger.error("Failed to load texture, file not found: ", rdpath);
+		return nullptr;
 	}
 
-	return TextureLoader::absLoad(apath);
+	SDL_Texture* texture = TextureLoader::loadFM(file.data, file.size);
+	if (texture != nullptr) {
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	}
+	return texture;
 }
 
 SDL_Texture* TextureLoader::loadFM(const uint8_t data[], const uint32_t data_size) {
-	SDL_RWops* rw = SDL_RWFromMem((uint8_t*) data, data_size);
+	StartupScope scope("texture.decode");
+	scope.addBytes(data_size);
+
+	SDL_RWops* rw = SDL_RWFromConstMem(data, data_size);
 	if (rw == nullptr) {
 		logger.error("Failed to load texture from memory: ", SDL_GetError());
 		return nullptr;
@@ -62,6 +94,38 @@ SDL_Texture* TextureLoader::loadFM(const uint8_t data[], const uint32_t data_siz
 		logger.error("Failed to load texture from memory: ", SDL_GetError());
 		return nullptr;
 	}
+	_track(texture);
 
 	return texture;
 }
+
+void TextureLoader::destroy(SDL_Texture* texture) {
+	if (texture == nullptr) {
+		return;
+	}
+	auto iter = _loaded.find(texture);
+	if (iter != _loaded.end()) {
+		_loaded_bytes -= iter->second;
+		_loaded.erase(iter);
+	}
+	SDL_DestroyTexture(texture);
+}
+
+size_t TextureLoader::getByteSize(SDL_Texture* texture) {
+	if (texture == nullptr) {
+		return 0;
+	}
+	uint32_t format;
+	int32_t width, height;
+	SDL_QueryTexture(texture, &format, NULL, &width, &height);
+	size_t bpp = SDL_BYTESPERPIXEL(format);
+	if (bpp == 0 || SDL_ISPIXELFORMAT_FOURCC(format)) {
+		// unknown or planar format, assume 32-bit RGBA
+		bpp = 4;
+	}
+	return (size_t) width * height * bpp;
+}
+
+MemoryUsage TextureLoader::getMemoryUsage() {
+	return {_loaded_bytes, (uint32_t) _loaded.size()};
+}
@@ -4,10 +4,45 @@
  * See: LICENSE.txt
  */
 
+#include "TextureLoader.hpp"
 #include "Tileset.hpp"
 
+using namespace std;
+
 
 Tileset::Tileset(SDL_Texture* texture, uint16_t first_gid, uint16_t last_gid): Image(texture) {
 	this->first_gid = first_gid;
 	this->last_gid = last_gid;
 }
+
+Tileset::Tileset(string path, uint32_t first_gid, uint32_t last_gid) {
+	this->first_gid = first_gid;
+	this->last_gid = last_gid;
+	this->path = path;
+}
+
+bool Tileset::load() {
+	if (texture != nullptr) {
+		return true;
+	}
+	if (path.empty()) {
+		return false;
+	}
+	SDL_Texture* loaded = TextureLoader::load(path);
+	if (loaded == nullptr) {
+		return false;
+	}
+	setTexture(loaded);
+	return true;
+}
+
+void Tileset::unload() {
+	// tilesets without a path cannot be reloaded
+	if (path.empty() || texture == nullptr) {
+		return;
+	}
+	TextureLoader::destroy(texture);
+	texture = nullptr;
+	width = 0;
+	height = 0;
+}
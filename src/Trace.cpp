@@ -0,0 +1,283 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <algorithm> // std::max
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include "Logger.hpp"
+#include "Path.hpp"
+#include "Trace.hpp"
+
+using namespace std;
+
+
+namespace Trace {
+	static Logger& logger = Logger::getLogger("Trace");
+
+	/** Recorded zone. Fields are atomic so that zones can be read while owner thread records. */
+	struct Zone {
+		atomic<const char*> name;
+		atomic<uint64_t> start;
+		atomic<uint64_t> end;
+#if HAVE_ALLOC_TRACKING
+		atomic<uint64_t> allocs;
+		atomic<uint64_t> alloc_bytes;
+#endif
+	};
+
+	/** Ring buffer written only by owning thread. */
+	struct Buffer {
+		/** Number of zones writing has started for. */
+		atomic<uint64_t> writing{0};
+		/** Number of zones written. */
+		atomic<uint64_t> head{0};
+		array<Zone, CAPACITY> zones;
+		atomic<const char*> thread_name{nullptr};
+		/** Thread ID in trace output. */
+		uint32_t tid;
+	};
+
+	/** Zone copied from a buffer for output. */
+	struct Record {
+		const char* name;
+		uint64_t start;
+		uint64_t end;
+		AllocCount allocs;
+	};
+
+	/**
+	 * Buffer of a thread, returned for reuse when thread exits.
+	 */
+	struct Owner {
+		Buffer* buffer = nullptr;
+		~Owner();
+	};
+
+	static thread_local Owner owner;
+
+	/** Guards buffer lists. */
+	static mutex buffers_mtx;
+
+	static atomic<uint32_t> budget{0};
+	static atomic<uint32_t> window{DEFAULT_WINDOW};
+	static atomic<bool> dump_requested{false};
+	static string output_dir;
+	static uint32_t dump_count = 0;
+	/** End of previous frame. */
+	static uint64_t prev_frame = 0;
+	/** Time of previous automatic dump. */
+	static uint64_t prev_dump = 0;
+
+	/**
+	 * Retrieves all buffers ever created.
+	 *
+	 * Buffers are never freed as dumps may be reading them.
+	 */
+	static vector<Buffer*>& getBuffers() {
+		static vector<Buffer*> buffers;
+		return buffers;
+	}
+
+	/**
+	 * Retrieves buffers of exited threads available for reuse.
+	 */
+	static vector<Buffer*>& getReleased() {
+		static vector<Buffer*> released;
+		return released;
+	}
+
+	/**
+	 * Retrieves buffer of calling thread, assigning one on first use.
+	 */
+	static Buffer* getBuffer();
+
+	/**
+	 * Writes nanoseconds as microseconds with fraction.
+	 */
+	static void _writeMicros(ostream& out, uint64_t ns) {
+		uint32_t frac = ns % 1000;
+		out << ns / 1000 << "." << (frac < 100 ? (frac < 10 ? "00" : "0") : "") << frac;
+	}
+};
+
+Trace::Owner::~Owner() {
+	if (this->buffer == nullptr) {
+		return;
+	}
+	lock_guard<mutex> lock(Trace::buffers_mtx);
+	Trace::getReleased().push_back(this->buffer);
+	this->buffer = nullptr;
+}
+
+Trace::Buffer* Trace::getBuffer() {
+	if (Trace::owner.buffer != nullptr) {
+		return Trace::owner.buffer;
+	}
+
+	lock_guard<mutex> lock(Trace::buffers_mtx);
+	vector<Buffer*>& released = Trace::getReleased();
+	Buffer* buffer;
+	if (!released.empty()) {
+		// zones of previous thread remain until overwritten
+		buffer = released.back();
+		released.pop_back();
+		buffer->thread_name.store(nullptr, memory_order_relaxed);
+	} else {
+		buffer = new Buffer();
+		Trace::getBuffers().push_back(buffer);
+		buffer->tid = Trace::getBuffers().size();
+	}
+	Trace::owner.buffer = buffer;
+	return buffer;
+}
+
+uint64_t Trace::now() {
+	return chrono::duration_cast<chrono::nanoseconds>(
+			chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::record(const char* name, uint64_t start, uint64_t end, const AllocCount& allocs) {
+	Buffer* buffer = Trace::getBuffer();
+	uint64_t idx = buffer->head.load(memory_order_relaxed);
+	// readers discard slot once writing starts
+	buffer->writing.store(idx + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	Zone& zone = buffer->zones[idx % CAPACITY];
+	zone.name.store(name, memory_order_relaxed);
+	zone.start.store(start, memory_order_relaxed);
+	zone.end.store(end, memory_order_relaxed);
+#if HAVE_ALLOC_TRACKING
+	zone.allocs.store(allocs.count, memory_order_relaxed);
+	zone.alloc_bytes.store(allocs.bytes, memory_order_relaxed);
+#endif
+	buffer->head.store(idx + 1, memory_order_release);
+}
+
+void Trace::setThreadName(const char* name) {
+	Trace::getBuffer()->thread_name.store(name, memory_order_relaxed);
+}
+
+void Trace::setBudget(uint32_t ms) {
+	Trace::budget.store(ms, memory_order_relaxed);
+}
+
+void Trace::setWindow(uint32_t seconds) {
+	Trace::window.store(seconds, memory_order_relaxed);
+}
+
+void Trace::setOutputDir(const string& dir) {
+	Trace::output_dir = dir;
+}
+
+void Trace::requestDump() {
+	Trace::dump_requested.store(true, memory_order_relaxed);
+}
+
+void Trace::endFrame() {
+	uint64_t time = Trace::now();
+	uint64_t frame_time = Trace::prev_frame != 0 ? time - Trace::prev_frame : 0;
+	Trace::prev_frame = time;
+
+	if (Trace::dump_requested.exchange(false, memory_order_relaxed)) {
+		Trace::dump("request");
+	} else {
+		uint64_t limit = (uint64_t) Trace::budget.load(memory_order_relaxed) * 1000000;
+		uint64_t span = (uint64_t) Trace::window.load(memory_order_relaxed) * 1000000000;
+		if (limit == 0 || frame_time <= limit
+				|| (Trace::prev_dump != 0 && time - Trace::prev_dump < span)) {
+			return;
+		}
+		Trace::prev_dump = time;
+		Trace::dump("hitch " + to_string(frame_time / 1000000) + "ms");
+	}
+	// time spent writing is not counted as a frame
+	Trace::prev_frame = Trace::now();
+}
+
+void Trace::writeJson(ostream& out, const string& reason) {
+	uint64_t time = Trace::now();
+	uint64_t span = (uint64_t) Trace::window.load(memory_order_relaxed) * 1000000000;
+	uint64_t cutoff = time > span ? time - span : 0;
+
+	vector<Buffer*> buffers;
+	{
+		lock_guard<mutex> lock(Trace::buffers_mtx);
+		buffers = Trace::getBuffers();
+	}
+
+	out << "{\"traceEvents\":[";
+	bool first = true;
+	vector<Record> records;
+	for (Buffer* buffer: buffers) {
+		uint64_t head = buffer->head.load(memory_order_acquire);
+		uint64_t begin = head > CAPACITY ? head - CAPACITY : 0;
+		records.clear();
+		for (uint64_t idx = begin; idx < head; idx++) {
+			const Zone& zone = buffer->zones[idx % CAPACITY];
+			Record record = {zone.name.load(memory_order_relaxed),
+					zone.start.load(memory_order_relaxed), zone.end.load(memory_order_relaxed), {}};
+#if HAVE_ALLOC_TRACKING
+			record.allocs = {zone.allocs.load(memory_order_relaxed),
+					zone.alloc_bytes.load(memory_order_relaxed)};
+#endif
+			records.push_back(record);
+		}
+		atomic_thread_fence(memory_order_acquire);
+		// zones overwritten while copying are discarded
+		uint64_t writing = buffer->writing.load(memory_order_relaxed);
+		uint64_t valid = writing > CAPACITY ? writing - CAPACITY : 0;
+
+		const char* thread_name = buffer->thread_name.load(memory_order_relaxed);
+		out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+				<< buffer->tid << ",\"args\":{\"name\":\"";
+		if (thread_name != nullptr) {
+			out << thread_name;
+		} else {
+			out << "thread " << buffer->tid;
+		}
+		out << "\"}}";
+		first = false;
+
+		for (uint64_t idx = max(begin, valid); idx < head; idx++) {
+			const Record& record = records[idx - begin];
+			if (record.start < cutoff) {
+				continue;
+			}
+			out << ",\n{\"name\":\"" << record.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+					<< buffer->tid << ",\"ts\":";
+			_writeMicros(out, record.start - cutoff);
+			out << ",\"dur\":";
+			_writeMicros(out, record.end - record.start);
+			if (record.allocs.count > 0) {
+				out << ",\"args\":{\"allocs\":" << record.allocs.count << ",\"alloc_bytes\":"
+						<< record.allocs.bytes << "}";
+			}
+			out << "}";
+		}
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"reason\":\"" << reason << "\"}}\n";
+}
+
+string Trace::dump(const string& reason) {
+	string dir = Trace::output_dir.empty() ? Path::dir_root : Trace::output_dir;
+	string path = Path::join(dir, "trace-" + to_string(chrono::duration_cast<chrono::seconds>(
+			chrono::system_clock::now().time_since_epoch()).count()) + "-"
+			+ to_string(Trace::dump_count++) + ".json");
+	ofstream fout(path, ios::trunc);
+	if (!fout.is_open()) {
+		logger.error("Cannot write trace: ", path);
+		return "";
+	}
+	Trace::writeJson(fout, reason);
+	fout.close();
+	logger.info("Trace written (", reason, "): ", path);
+	return path;
+}
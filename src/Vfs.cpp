@@ -0,0 +1,312 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ */
+
+#include <algorithm> // std::lower_bound, std::replace, std::sort
+#include <cstring> // std::memcmp
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <system_error> // std::error_code
+
+#include "Archive.hpp"
+#include "Filesystem.hpp"
+#include "Logger.hpp"
+#include "Lz4.hpp"
+#include "MappedFile.hpp"
+#include "Path.hpp"
+#include "Vfs.hpp"
+
+using namespace std;
+
+
+namespace Vfs {
+	/** Absolute path to mounted data. */
+	string mount_path;
+
+	/** Mapped archive (null if loose data directory is mounted). */
+	shared_ptr<MappedFile> archive;
+	/** Archive index sorted by name. */
+	span<const Archive::Entry> entries;
+	/** Archive name table. */
+	const char* names = nullptr;
+
+	/**
+	 * Retrieves name of an archive entry.
+	 */
+	string_view getName(const Archive::Entry& entry);
+
+	/**
+	 * Finds an archive entry.
+	 *
+	 * @param vpath
+	 *   Normalized virtual path.
+	 * @return
+	 *   Entry or `null` if not found.
+	 */
+	const Archive::Entry* find(const string& vpath);
+
+	/**
+	 * Maps & validates an archive.
+	 *
+	 * @param path
+	 *   Absolute path to archive.
+	 */
+	bool mountArchive(string path);
+};
+
+static Logger& logger = Logger::getLogger("Vfs");
+
+// data for empty files as they cannot be mapped
+static const uint8_t empty_data[1] = {};
+
+
+string_view Vfs::getName(const Archive::Entry& entry) {
+	return string_view(Vfs::names + entry.name, entry.name_length);
+}
+
+const Archive::Entry* Vfs::find(const string& vpath) {
+	auto iter = lower_bound(Vfs::entries.begin(), Vfs::entries.end(), vpath,
+			[](const Archive::Entry& entry, const string& name) {
+				return Vfs::getName(entry) < name;
+			});
+	if (iter == Vfs::entries.end() || Vfs::getName(*iter) != vpath) {
+		return nullptr;
+	}
+	return &(*iter);
+}
+
+bool Vfs::mountArchive(string path) {
+	shared_ptr<MappedFile> file = make_shared<MappedFile>();
+	if (!file->open(path)) {
+		logger.error("Cannot map data archive: ", path);
+		return false;
+	}
+
+	const uint8_t* data = file->getData();
+	size_t size = file->getSize();
+	const Archive::Header* header = reinterpret_cast<const Archive::Header*>(data);
+	if (size < sizeof(Archive::Header) || memcmp(header->magic, Archive::MAGIC, sizeof(Archive::MAGIC)) != 0
+			|| header->version != Archive::VERSION || header->byte_order != Archive::ENDIAN_MARKER) {
+		logger.error("Incompatible data archive: ", path);
+		return false;
+	}
+
+	auto inBounds = [size](uint64_t offset, uint64_t len) {
+		return offset <= size && len <= size - offset;
+	};
+	if (!inBounds(header->entries_offset, (uint64_t) header->entry_count * sizeof(Archive::Entry))
+			|| header->entries_offset % alignof(Archive::Entry) != 0
+			|| !inBounds(header->names_offset, header->names_size)) {
+		logger.error("Corrupt data archive index: ", path);
+		return false;
+	}
+	span<const Archive::Entry> index(
+			reinterpret_cast<const Archive::Entry*>(data + header->entries_offset), header->entry_count);
+	for (const Archive::Entry& entry: index) {
+		if ((uint64_t) entry.name + entry.name_length > header->names_size
+				|| !inBounds(entry.offset, entry.size)) {
+			logger.error("Corrupt data archive entry: ", path);
+			return false;
+		}
+	}
+
+	Vfs::archive = file;
+	Vfs::entries = index;
+	Vfs::names = reinterpret_cast<const char*>(data + header->names_offset);
+	return true;
+}
+
+bool Vfs::mount() {
+	string archive_path = Path::rabs("data.pak");
+	error_code ec;
+	if (filesystem::is_regular_file(archive_path, ec)) {
+		return Vfs::mount(archive_path);
+	}
+	return Vfs::mount(Path::rabs("data"));
+}
+
+bool Vfs::mount(string path) {
+	Vfs::unmount();
+
+	error_code ec;
+	if (filesystem::is_directory(path, ec)) {
+		Vfs::mount_path = path;
+	} else if (Vfs::mountArchive(path)) {
+		Vfs::mount_path = path;
+	} else {
+		return false;
+	}
+
+	logger.info("Mounted game data: ", path);
+	return true;
+}
+
+void Vfs::unmount() {
+	// files already read hold their own reference to archive
+	Vfs::archive = nullptr;
+	Vfs::entries = {};
+	Vfs::names = nullptr;
+	Vfs::mount_path = "";
+}
+
+bool Vfs::isArchive() {
+	return Vfs::archive != nullptr;
+}
+
+string Vfs::getMountPath() {
+	return Vfs::mount_path;
+}
+
+string Vfs::normalize(string path) {
+	replace(path.begin(), path.end(), '\\', '/');
+	if (!Vfs::isArchive() && !Vfs::mount_path.empty()) {
+		string root = Vfs::mount_path;
+		replace(root.begin(), root.end(), '\\', '/');
+		if (path.starts_with(root + "/")) {
+			path = path.substr(root.length() + 1);
+		}
+	}
+
+	vector<string> nodes;
+	size_t start = 0;
+	while (start <= path.length()) {
+		size_t end = path.find('/', start);
+		if (end == string::npos) {
+			end = path.length();
+		}
+		string n = path.substr(start, end - start);
+		if (n == "..") {
+			if (!nodes.empty()) {
+				nodes.pop_back();
+			}
+		} else if (!n.empty() && n != ".") {
+			nodes.push_back(n);
+		}
+		start = end + 1;
+	}
+
+	string vpath;
+	for (const string& n: nodes) {
+		if (!vpath.empty()) {
+			vpath += "/";
+		}
+		vpath += n;
+	}
+	return vpath;
+}
+
+bool Vfs::exists(string vpath) {
+	VfsStat st;
+	return Vfs::stat(vpath, st);
+}
+
+bool Vfs::stat(string vpath, VfsStat& st) {
+	vpath = Vfs::normalize(vpath);
+	if (Vfs::isArchive()) {
+		const Archive::Entry* entry = Vfs::find(vpath);
+		if (entry == nullptr) {
+			return false;
+		}
+		st.size = entry->raw_size;
+		st.mtime = entry->mtime;
+		return true;
+	}
+
+	string path = Path::join(Vfs::mount_path, vpath);
+	error_code ec;
+	if (!filesystem::is_regular_file(path, ec)) {
+		return false;
+	}
+	st.size = filesystem::file_size(path, ec);
+	st.mtime = Filesystem::getMTime(path, ec);
+	return !ec;
+}
+
+VfsFile Vfs::read(string vpath) {
+	vpath = Vfs::normalize(vpath);
+	VfsFile file;
+
+	if (Vfs::isArchive()) {
+		const Archive::Entry* entry = Vfs::find(vpath);
+		if (entry == nullptr) {
+			return file;
+		}
+		const uint8_t* stored = Vfs::archive->getData() + entry->offset;
+		if (entry->raw_size == 0) {
+			file.data = empty_data;
+		} else if ((entry->flags & Archive::LZ4) == 0) {
+			// referenced in place
+			file.owner = Vfs::archive;
+			file.data = stored;
+			file.size = entry->size;
+		} else {
+			shared_ptr<vector<uint8_t>> buffer = make_shared<vector<uint8_t>>(entry->raw_size);
+			if (!Lz4::decompress(stored, entry->size, buffer->data(), buffer->size())) {
+				logger.error("Corrupt archive entry: ", vpath);
+				return file;
+			}
+			file.owner = buffer;
+			file.data = buffer->data();
+			file.size = buffer->size();
+		}
+		return file;
+	}
+
+	string path = Path::join(Vfs::mount_path, vpath);
+	shared_ptr<MappedFile> mapped = make_shared<MappedFile>();
+	if (mapped->open(path)) {
+		file.owner = mapped;
+		file.data = mapped->getData();
+		file.size = mapped->getSize();
+	} else {
+		error_code ec;
+		if (filesystem::is_regular_file(path, ec) && filesystem::file_size(path, ec) == 0) {
+			file.data = empty_data;
+		}
+	}
+	return file;
+}
+
+vector<string> Vfs::list(string vdir, string suffix) {
+	vdir = Vfs::normalize(vdir);
+	string prefix = vdir.empty() ? "" : vdir + "/";
+	vector<string> paths;
+
+	if (Vfs::isArchive()) {
+		// entries under directory are contiguous in sorted index
+		auto iter = lower_bound(Vfs::entries.begin(), Vfs::entries.end(), prefix,
+				[](const Archive::Entry& entry, const string& name) {
+					return Vfs::getName(entry) < name;
+				});
+		for (; iter != Vfs::entries.end(); iter++) {
+			string_view name = Vfs::getName(*iter);
+			if (!name.starts_with(prefix)) {
+				break;
+			}
+			if (name.ends_with(suffix)) {
+				paths.push_back(string(name));
+			}
+		}
+		return paths;
+	}
+
+	string dir = Path::join(Vfs::mount_path, vdir);
+	error_code ec;
+	if (!filesystem::is_directory(dir, ec)) {
+		return paths;
+	}
+	for (filesystem::directory_entry item: Filesystem::listDir(dir, true)) {
+		if (!item.is_regular_file()) {
+			continue;
+		}
+		string rel = filesystem::relative(item.path(), dir).generic_string();
+		if (rel.ends_with(suffix)) {
+			paths.push_back(prefix + rel);
+		}
+	}
+	sort(paths.begin(), paths.end());
+	return paths;
+}
@@ -11,18 +11,40 @@
 
 #include <SDL2/SDL_timer.h>
 
+#include "AllocStats.hpp"
+#include "AudioStats.hpp"
+#include "DataLoader.hpp"
+#include "FrameProfiler.hpp"
 #include "GameConfig.hpp"
 #include "GameLoop.hpp"
+#include "InputLatency.hpp"
+#include "MemoryStats.hpp"
 #include "SingletonRepo.hpp"
 #include "TextureLoader.hpp"
+#include "Trace.hpp"
 #include "Viewport.hpp"
 #include "reso.hpp"
 #include "store/FontMapStore.hpp"
+#include "store/SceneStore.hpp"
 
 using namespace std;
 
 
-Logger Viewport::logger = Logger::getLogger("Viewport");
+// DEBUG: placeholder scene entered from title screen
+static const string _start_scene = "map1";
+
+/**
+ * Deletes text sprites & clears list.
+ */
+static void _freeSprites(vector<Sprite*>& sprites) {
+	for (Sprite* sprite: sprites) {
+		delete sprite;
+	}
+	sprites.clear();
+}
+
+
+Logger& Viewport::logger = Logger::getLogger("Viewport");
 
 // initialize singleton instance
 unique_ptr<Viewport> Viewport::instance = nullptr;
@@ -39,6 +61,11 @@ Viewport::Viewport() {
 	this->mode = GameMode::NONE;
 	this->background = nullptr;
 	this->fps_sprite = nullptr;
+	this->audio_sprite = nullptr;
+	this->latency_sprite = nullptr;
+	this->render_sprite = nullptr;
+	this->profiler_time = 0;
+	this->memory_time = 0;
 	this->movie = nullptr;
 
 	resetFade();
@@ -46,17 +73,33 @@ Viewport::Viewport() {
 
 void Viewport::shutdown() {
 	this->unsetBackground();
-	SDL_DestroyTexture(this->background);
+	TextureLoader::destroy(this->background);
 	delete this->font_map;
 	delete this->fps_sprite;
+	delete this->audio_sprite;
+	delete this->latency_sprite;
+	delete this->render_sprite;
+	_freeSprites(this->profiler_sprites);
+	_freeSprites(this->memory_sprites);
 	delete this->movie;
 	this->movie = nullptr;
 }
 
 void Viewport::setCurrentFPS(uint32_t fps) {
 	this->current_fps = fps;
+	delete this->fps_sprite;
 	this->fps_sprite = FontMapStore::buildTextSprite(this->font_map, "FPS: "
 			+ to_string(this->current_fps));
+	// mixer measurements are refreshed at same rate
+	delete this->audio_sprite;
+	this->audio_sprite = FontMapStore::buildTextSprite(this->font_map, AudioStats::getSummary());
+	delete this->latency_sprite;
+	this->latency_sprite = FontMapStore::buildTextSprite(this->font_map,
+			InputLatency::getSummary());
+	// read before building sprites, which are counted in next frame
+	string render_summary = renderer->getSummary();
+	delete this->render_sprite;
+	this->render_sprite = FontMapStore::buildTextSprite(this->font_map, render_summary);
 }
 
 void Viewport::setScale(uint16_t scale) {
@@ -65,7 +108,7 @@ void Viewport::setScale(uint16_t scale) {
 
 void Viewport::unsetBackground() {
 	if (this->background != nullptr) {
-		SDL_DestroyTexture(this->background);
+		TextureLoader::destroy(this->background);
 		this->background = nullptr;
 	}
 }
@@ -86,6 +129,13 @@ void Viewport::setRenderMode(GameMode::Mode mode) {
 	GetGameWindow()->stopMusic();
 	this->clearText();
 	this->unsetBackground();
+	// data still queued for loading is required now
+	if (mode == GameMode::TITLE) {
+		DataLoader::finish(DataLoader::TITLE);
+	} else if (mode == GameMode::SCENE) {
+		DataLoader::finish(DataLoader::SCENE);
+	}
+
 	if (mode == GameMode::TITLE) {
 		GetGameVisuals()->setScene("");
 		this->setBackground(GameConfig::getBackground("title"));
@@ -93,9 +143,14 @@ void Viewport::setRenderMode(GameMode::Mode mode) {
 
 		// DEBUG: placeholder of example for adding text to title screen
 		this->addText("press enter");
+
+		// load data of first scene while title is displayed
+		DataLoader::queue(DataLoader::SCENE, "scene", [] {
+			return SceneStore::preload(_start_scene);
+		});
 	} else if (mode == GameMode::SCENE) {
 		// DEBUG: placeholder example
-		GetGameVisuals()->setScene("map1");
+		GetGameVisuals()->setScene(_start_scene);
 		// this->addText("Sorry, nothing to do");
 		// this->addText("here yet. :(");
 	} else if (mode == GameMode::INTRO) {
@@ -110,7 +165,7 @@ void Viewport::setRenderMode(GameMode::Mode mode) {
 		if (this->movie == nullptr) {
 			this->logger.warn("No intro movie set");
 		} else {
-			this->logger.debug("Intro movie set");
+			LOG_DEBUG(this->logger, "Intro movie set");
 		}
 #endif
 	}
@@ -129,7 +184,10 @@ void Viewport::setFadeOut(uint64_t start_time, uint32_t ms) {
 }
 
 void Viewport::render() {
+	TraceZone zone("Viewport::render");
 	render_time = SDL_GetTicks64();
+	// frame reflects input applied by logic steps so far
+	InputLatency::markRendered();
 	renderer->setDrawColor(0, 0, 0, 0);
 	renderer->clear();
 	// TODO: create Scene class that handles drawing tiles
@@ -145,9 +203,20 @@ void Viewport::render() {
 			this->movie->render(renderer);
 		}
 	}
-	this->drawText();
-	handleFade();
-	renderer->present();
+	{
+		FrameScope scope(FrameProfiler::HUD);
+		this->drawText();
+	}
+	{
+		FrameScope scope(FrameProfiler::FADE);
+		handleFade();
+	}
+	{
+		FrameScope scope(FrameProfiler::PRESENT);
+		renderer->present();
+	}
+	InputLatency::markPresented(SDL_GetTicks64());
+	FrameProfiler::endFrame();
 }
 
 void Viewport::drawScene() {
@@ -192,6 +261,8 @@ void Viewport::drawText() {
 #if RRE_DEBUGGING
 	this->drawFPS();
 #endif
+	this->drawProfiler();
+	this->drawMemory();
 }
 
 void Viewport::addText(string text) {
@@ -206,12 +277,134 @@ void Viewport::clearText() {
 }
 
 void Viewport::drawFPS() {
-#if RRE_DEBUGGING
-	cout << "FPS: " << this->current_fps << "                \r";
-#endif
 	if (this->fps_sprite != nullptr) {
 		renderer->drawImage(this->fps_sprite, 0, 0);
 	}
+	uint32_t y = this->fps_sprite != nullptr ? this->fps_sprite->getHeight() + 1 : 0;
+	if (this->audio_sprite != nullptr) {
+		renderer->drawImage(this->audio_sprite, 0, y);
+		y += this->audio_sprite->getHeight() + 1;
+	}
+	if (this->latency_sprite != nullptr) {
+		renderer->drawImage(this->latency_sprite, 0, y);
+		y += this->latency_sprite->getHeight() + 1;
+	}
+	if (this->render_sprite != nullptr) {
+		renderer->drawImage(this->render_sprite, 0, y);
+	}
+}
+
+/** Height of frame profiler graph in pixels (1 pixel per millisecond). */
+static const uint32_t _graph_height = 48;
+
+/** Profiler stage groups drawn as graph bar segments. */
+static const struct {
+	const char* label;
+	FrameProfiler::Stage first;
+	FrameProfiler::Stage last;
+	SDL_Color color;
+} _graph_groups[] = {
+	{"EVT", FrameProfiler::EVENTS, FrameProfiler::EVENTS, {64, 128, 255, 192}},
+	// input & scene logic are nested within step
+	{"STEP", FrameProfiler::STEP, FrameProfiler::STEP, {64, 224, 64, 192}},
+	{"DRAW", FrameProfiler::PARALLAX, FrameProfiler::WEATHER, {255, 224, 64, 192}},
+	{"HUD", FrameProfiler::HUD, FrameProfiler::FADE, {224, 96, 255, 192}},
+	{"PRES", FrameProfiler::PRESENT, FrameProfiler::PRESENT, {255, 64, 64, 192}}
+};
+
+/**
+ * Formats microseconds as milliseconds with one decimal.
+ */
+static string _formatMs(uint32_t us) {
+	return to_string(us / 1000) + "." + to_string((us % 1000) / 100);
+}
+
+void Viewport::drawProfiler() {
+	if (!FrameProfiler::graphVisible()) {
+		return;
+	}
+
+	// statistics are rebuilt twice per second
+	if (this->profiler_sprites.empty() || render_time - this->profiler_time >= 500) {
+		_freeSprites(this->profiler_sprites);
+		this->profiler_time = render_time;
+		FrameProfiler::StageStats stats = FrameProfiler::getFrameStats();
+		this->profiler_sprites.push_back(FontMapStore::buildTextSprite(this->font_map, "FRAME "
+				+ _formatMs(stats.avg) + " P95 " + _formatMs(stats.p95) + " MAX " + _formatMs(stats.max)));
+		for (const auto& group: _graph_groups) {
+			uint32_t avg = 0, p95 = 0;
+			for (uint8_t stage = group.first; stage <= group.last; stage++) {
+				stats = FrameProfiler::getStats((FrameProfiler::Stage) stage);
+				avg += stats.avg;
+				p95 += stats.p95;
+			}
+			this->profiler_sprites.push_back(FontMapStore::buildTextSprite(this->font_map,
+					string(group.label) + " " + _formatMs(avg) + " P95 " + _formatMs(p95)));
+		}
+#if HAVE_ALLOC_TRACKING
+		AllocCount allocs = AllocStats::getFrame();
+		this->profiler_sprites.push_back(FontMapStore::buildTextSprite(this->font_map, "ALLOC "
+				+ to_string(allocs.count) + " " + to_string(allocs.bytes) + "B"));
+#endif
+	}
+
+	uint32_t bottom = NATIVE_RES.second;
+	uint32_t y = bottom - _graph_height;
+	for (auto iter = this->profiler_sprites.rbegin(); iter != this->profiler_sprites.rend(); iter++) {
+		if (*iter == nullptr) {
+			continue;
+		}
+		y -= (*iter)->getHeight() + 1;
+		renderer->drawImage(*iter, 0, y);
+	}
+
+	renderer->save();
+	renderer->setDrawColor(0, 0, 0, 128);
+	renderer->fillRect(0, bottom - _graph_height, FrameProfiler::HISTORY * 2, _graph_height);
+	// most recent frame on right
+	for (uint32_t age = 0; age < FrameProfiler::HISTORY; age++) {
+		int32_t x = (FrameProfiler::HISTORY - 1 - age) * 2;
+		uint32_t top = bottom;
+		for (const auto& group: _graph_groups) {
+			uint32_t time = 0;
+			for (uint8_t stage = group.first; stage <= group.last; stage++) {
+				time += FrameProfiler::getTime((FrameProfiler::Stage) stage, age);
+			}
+			uint32_t height = min(time / 1000, top - (bottom - _graph_height));
+			if (height == 0) {
+				continue;
+			}
+			top -= height;
+			renderer->setDrawColor(group.color);
+			renderer->fillRect(x, top, 2, height);
+		}
+	}
+	renderer->restore();
+}
+
+void Viewport::drawMemory() {
+	if (!MemoryStats::pageVisible()) {
+		return;
+	}
+
+	// stores are measured once per second
+	if (this->memory_sprites.empty() || render_time - this->memory_time >= 1000) {
+		_freeSprites(this->memory_sprites);
+		this->memory_time = render_time;
+		for (const string& line: MemoryStats::getSummary()) {
+			this->memory_sprites.push_back(FontMapStore::buildTextSprite(this->font_map, line));
+		}
+	}
+
+	// aligned to right edge
+	uint32_t y = 0;
+	for (Sprite* sprite: this->memory_sprites) {
+		if (sprite == nullptr) {
+			continue;
+		}
+		renderer->drawImage(sprite, NATIVE_RES.first - sprite->getWidth(), y);
+		y += sprite->getHeight() + 1;
+	}
 }
 
 void Viewport::handleFade() {
@@ -15,11 +15,10 @@
 #include "factory/EntityFactory.hpp"
 #include "store/SpriteStore.hpp"
 
-using namespace pugi;
 using namespace std;
 
 
-static Logger _logger = Logger::getLogger("EntityFactory");
+static Logger& _logger = Logger::getLogger("EntityFactory");
 
 static void _onConfigError(string title, string msg) {
 	if (!title.empty()) {
@@ -35,11 +34,11 @@ static void _onConfigError(string msg) {
 	_onConfigError("", msg);
 }
 
-EntityTemplate EntityFactory::build(xml_node el) {
+EntityTemplate EntityFactory::build(ConfigNode el) {
 	EntityTemplate entity = EntityTemplate();
 
 	shared_ptr<Sprite> sprite = nullptr;
-	xml_attribute attr_sprite = el.attribute("sprite");
+	ConfigAttribute attr_sprite = el.attribute("sprite");
 	if (attr_sprite.empty()) {
 		_logger.warn("Entity sprite not configured");
 	} else {
@@ -48,11 +47,11 @@ EntityTemplate EntityFactory::build(xml_node el) {
 	entity.setSprite(sprite);
 
 	uint32_t width = 0, height = 0;
-	xml_attribute attr_width = el.attribute("width");
+	ConfigAttribute attr_width = el.attribute("width");
 	if (!attr_width.empty()) {
 		StrUtil::parseUInt(width, attr_width.value());
 	}
-	xml_attribute attr_height = el.attribute("height");
+	ConfigAttribute attr_height = el.attribute("height");
 	if (!attr_height.empty()) {
 		StrUtil::parseUInt(height, attr_height.value());
 	}
@@ -60,16 +59,16 @@ EntityTemplate EntityFactory::build(xml_node el) {
 	entity.set("height", height);
 
 	float momentum = 0;
-	xml_node el_momentum = el.child("momentum");
-	if (el_momentum.type() != node_null) {
-		StrUtil::parseFloat(momentum, el_momentum.text().get());
+	ConfigNode el_momentum = el.child("momentum");
+	if (!el_momentum.empty()) {
+		StrUtil::parseFloat(momentum, el_momentum.text());
 	}
 	entity.set("base_momentum", momentum);
 
-	xml_node el_gravity = el.child("gravity");
-	if (el_gravity.type() != node_null) {
+	ConfigNode el_gravity = el.child("gravity");
+	if (!el_gravity.empty()) {
 		float gravity = 1.0f;
-		StrUtil::parseFloat(gravity, el_gravity.text().get());
+		StrUtil::parseFloat(gravity, el_gravity.text());
 		entity.set("gravity", gravity);
 	}
 
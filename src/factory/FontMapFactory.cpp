@@ -12,15 +12,15 @@
 #include <unordered_map>
 #include <vector>
 
-#include <pugixml.hpp>
-
+#include "ConfigDocument.hpp"
 #include "Dialog.hpp"
-#include "Filesystem.hpp"
 #include "FontMap.hpp"
 #include "Logger.hpp"
 #include "Path.hpp"
 #include "StrUtil.hpp"
 #include "TextureLoader.hpp"
+#include "Trace.hpp"
+#include "Vfs.hpp"
 #include "builtin/conf/fonts.h"
 #if HAVE_BUILTIN_FONT_MAP
 #include "builtin/tileset/fontmap_png.h"
@@ -28,13 +28,12 @@
 #include "factory/FontMapFactory.hpp"
 #include "store/FontMapStore.hpp"
 
-using namespace pugi;
 using namespace std;
 
 
 namespace FontMapFactory {
 	/** Logger instance dedicated to namespace. */
-	Logger logger = Logger::getLogger("FontMapFactory");
+	Logger& logger = Logger::getLogger("FontMapFactory");
 
 	bool loaded = false;
 };
@@ -47,13 +46,13 @@ namespace FontMapFactory {
  * @return
  *   Mapping of indexed characters.
  */
-unordered_map<wchar_t, int32_t> _parseCharacters(xml_node el) {
+unordered_map<wchar_t, int32_t> _parseCharacters(ConfigNode el) {
 	unordered_map<wchar_t, int32_t> empty_map;
 	unordered_map<wchar_t, int32_t> char_map;
 
-	xml_node cel = el.child("char");
-	while (cel.type() != node_null) {
-		xml_attribute attr = cel.attribute("index");
+	ConfigNode cel = el.child("char");
+	while (!cel.empty()) {
+		ConfigAttribute attr = cel.attribute("index");
 		if (attr.empty()) {
 			string msg = "Missing attribute \"index\" in XML element \"char\"";
 			FontMapFactory::logger.error("XML Parsing Error: ", msg);
@@ -68,14 +67,14 @@ unordered_map<wchar_t, int32_t> _parseCharacters(xml_node el) {
 			FontMapFactory::logger.error("XML Parsing Error: ", msg);
 			Dialog::error("XML Parsing Error", msg);
 		}
-		const string value = cel.text().get();
+		const string value = cel.text();
 		for (int idx = 0; idx < value.length(); idx++) {
 			int index_offset = start_index + idx;
 			wchar_t c = value[idx];
 			char_map[c] = index_offset;
 		}
 
-		cel = cel.next_sibling("char");
+		cel = cel.nextSibling("char");
 	}
 
 	if (char_map.size() == 0) {
@@ -99,7 +98,7 @@ unordered_map<wchar_t, int32_t> _parseCharacters(xml_node el) {
  * @return
  *   `true` if parsing succeeded.
  */
-bool _parseFont(xml_node el, const uint8_t data[], const uint32_t data_size) {
+bool _parseFont(ConfigNode el, const uint8_t data[], const uint32_t data_size) {
 	vector<string> err;
 
 	string id = "";
@@ -107,7 +106,7 @@ bool _parseFont(xml_node el, const uint8_t data[], const uint32_t data_size) {
 	int32_t w = 0;
 	int32_t h = 0;
 
-	xml_attribute attr = el.attribute("id");
+	ConfigAttribute attr = el.attribute("id");
 	if (attr.empty()) {
 		err.push_back("Missing font attribute \"id\"");
 	} else {
@@ -177,28 +176,27 @@ bool _parseFont(xml_node el, const uint8_t data[], const uint32_t data_size) {
 
 
 bool FontMapFactory::loadBuiltin() {
-#if RRE_DEBUGGING
-	FontMapFactory::logger.debug("Loading built-in fonts config");
-#endif
+	LOG_DEBUG(FontMapFactory::logger, "Loading built-in fonts config");
 
-	xml_document doc;
-	if (doc.load_string(builtin_fonts_config.c_str()).status != status_ok) {
-		string msg = "Failed to load built-in fonts config";
+	ConfigDocument doc;
+	string error;
+	if (!doc.parse(builtin_fonts_config.data(), builtin_fonts_config.size(), error)) {
+		string msg = "Failed to load built-in fonts config (" + error + ")";
 		FontMapFactory::logger.error(msg);
 		Dialog::error(msg);
 		return false;
 	}
 
-	xml_node root = doc.child("fonts");
-	if (root.type() == node_null) {
+	ConfigNode root = doc.child("fonts");
+	if (root.empty()) {
 		string msg = "Root element \"fonts\" not found";
 		FontMapFactory::logger.error("XML Parsing Error: ", msg);
 		Dialog::error("XML Parsing Error", msg);
 		return false;
 	}
 
-	xml_node el = root.child("font");
-	if (el.type() == node_null) {
+	ConfigNode el = root.child("font");
+	if (el.empty()) {
 		string msg = "Built-in font not configured";
 		FontMapFactory::logger.error("XML Parsing Error: ", msg);
 		Dialog::error("XML Parsing Error", msg);
@@ -215,44 +213,44 @@ bool FontMapFactory::loadBuiltin() {
 
 
 bool FontMapFactory::loadConfig() {
+	TraceZone zone("FontMapFactory::loadConfig");
 	if (FontMapFactory::loaded) {
 		FontMapFactory::logger.warn("Cannot reload font maps");
 		return false;
 	}
 	FontMapFactory::loaded = true;
 
-	string conf_fonts = Path::join(Path::dir_root, "data/conf/fonts.xml");
-#if RRE_DEBUGGING
-	FontMapFactory::logger.debug("Loading external fonts config: \"", conf_fonts, "\"");
-#endif
-	if (!Filesystem::fexist(conf_fonts)) {
+	string conf_fonts = "conf/fonts.xml";
+	LOG_DEBUG(FontMapFactory::logger, "Loading external fonts config: \"", conf_fonts, "\"");
+	if (!Vfs::exists(conf_fonts)) {
 		FontMapFactory::logger.warn("Fonts config not found: \"", conf_fonts, "\"");
 		// don't close application
 		return true;
 	}
 
-	xml_document doc;
-	if (doc.load_file(conf_fonts.c_str()).status != status_ok) {
-		string msg = "Failed to load fonts config: \"" + conf_fonts + "\"";
+	ConfigDocument doc;
+	string error;
+	if (!doc.load(conf_fonts, error)) {
+		string msg = "Failed to load fonts config (" + error + "): \"" + conf_fonts + "\"";
 		FontMapFactory::logger.error(msg);
 		Dialog::error(msg);
 		return false;
 	}
 
-	xml_node root = doc.child("fonts");
-	if (root.type() == node_null) {
+	ConfigNode root = doc.child("fonts");
+	if (root.empty()) {
 		string msg = "Root element \"fonts\" not found: \"" + conf_fonts + "\"";
 		FontMapFactory::logger.error("XML Parsing Error: ", msg);
 		Dialog::error("XML Parsing Error", msg);
 		return false;
 	}
 
-	xml_node el = root.child("font");
-	while (el.type() != node_null) {
+	ConfigNode el = root.child("font");
+	while (!el.empty()) {
 		if (!_parseFont(el, nullptr, 0)) {
 			return false;
 		}
-		el = el.next_sibling("font");
+		el = el.nextSibling("font");
 	}
 
 	return true;
@@ -5,151 +5,183 @@
  */
 
 #include <cstdint> // uint*_t
+#include <unordered_map>
+#include <vector>
 
-#include <pugixml.hpp>
-
+#include "ConfigDocument.hpp"
 #include "Dialog.hpp"
-#include "Filesystem.hpp"
-#include "Image.hpp"
 #include "Logger.hpp"
 #include "Path.hpp"
 #include "StrUtil.hpp"
-#include "TextureLoader.hpp"
+#include "Trace.hpp"
+#include "Vfs.hpp"
 #include "factory/MovieFactory.hpp"
 
-using namespace pugi;
 using namespace std;
 
 
 namespace MovieFactory {
-	static Logger logger = Logger::getLogger("MovieFactory");
+	static Logger& logger = Logger::getLogger("MovieFactory");
+
+	/** Configured movie properties. */
+	struct MovieDefinition {
+		MovieFrameList frames;
+		vector<string> texts;
+		uint32_t fade_in = 0;
+		uint32_t fade_out = 0;
+	};
+
+	/** Movies indexed by ID. */
+	static unordered_map<string, MovieDefinition> movies;
+	/** Denotes configuration has been parsed. */
+	static bool indexed = false;
+
+	/**
+	 * Parses movies configuration into index.
+	 *
+	 * @return
+	 *   `true` if configuration was parsed.
+	 */
+	static bool index();
 };
 
-Movie* MovieFactory::getMovie(string id) {
-	string movies_conf = Path::rabs("data/conf/movies.xml");
-	if (!Filesystem::fexist(movies_conf)) {
+bool MovieFactory::index() {
+	TraceZone zone("MovieFactory::index");
+	string movies_conf = "conf/movies.xml";
+	if (!Vfs::exists(movies_conf)) {
 		string msg = "Movies configuration not found: " + movies_conf;
 		MovieFactory::logger.error(msg);
 		Dialog::error(msg);
-		return nullptr;
+		return false;
 	}
 
-	xml_document doc;
-	if (doc.load_file(movies_conf.c_str()).status != status_ok) {
-		string msg = "Failed to load movies configuration: " + movies_conf;
+	ConfigDocument doc;
+	string error;
+	if (!doc.load(movies_conf, error)) {
+		string msg = "Failed to load movies configuration (" + error + "): " + movies_conf;
 		MovieFactory::logger.error(msg);
 		Dialog::error(msg);
-		return nullptr;
+		return false;
 	}
 
-	xml_node root = doc.child("movies");
-	if (root.type() == node_null) {
+	ConfigNode root = doc.child("movies");
+	if (root.empty()) {
 		string msg = "Root element \"movies\" not found: " + movies_conf;
 		MovieFactory::logger.error("XML Parsing Error: ", msg);
 		Dialog::error("XML Parsing Error", msg);
-		return nullptr;
+		return false;
 	}
 
-	xml_node movie_el = root.child("movie");
-	while (movie_el.type() != node_null) {
-		xml_attribute id_attr = movie_el.attribute("id");
+	unordered_map<string, MovieDefinition> parsed;
+	ConfigNode movie_el = root.child("movie");
+	while (!movie_el.empty()) {
+		ConfigAttribute id_attr = movie_el.attribute("id");
 		if (id_attr.empty()) {
 			string msg = "Missing attribute \"id\" in movie tag: " + movies_conf;
 			MovieFactory::logger.error("XML Parsing Error: ", msg);
 			Dialog::error("XML Parsing Error", msg);
-			return nullptr;
+			return false;
 		}
-		if (id.compare(id_attr.value()) == 0) {
-			break;
+		string id = id_attr.value();
+		if (parsed.find(id) != parsed.end()) {
+			// first definition takes precedence
+			movie_el = movie_el.nextSibling("movie");
+			continue;
 		}
 
-		movie_el = movie_el.next_sibling("movie");
-	}
-
-	MovieFrameList frames;
-	//vector<pair<uint16_t, Sprite*>> text_sprites;
-	vector<string> texts;
-	uint32_t fade_in = 0;
-	uint32_t fade_out = 0;
-
-	if (movie_el.type() != node_null) {
-		xml_attribute attr_fade_in = movie_el.attribute("fade_in");
-		xml_attribute attr_fade_out = movie_el.attribute("fade_out");
+		MovieDefinition def;
+		ConfigAttribute attr_fade_in = movie_el.attribute("fade_in");
+		ConfigAttribute attr_fade_out = movie_el.attribute("fade_out");
 		if (!attr_fade_in.empty()) {
-			fade_in = attr_fade_in.as_uint();
+			def.fade_in = attr_fade_in.asUInt();
 		}
 		if (!attr_fade_out.empty()) {
-			fade_out = attr_fade_out.as_uint();
+			def.fade_out = attr_fade_out.asUInt();
 		}
 
-		xml_node frame_el = movie_el.child("frame");
-		while (frame_el.type() != node_null) {
-			xml_attribute ms_attr = frame_el.attribute("ms");
+		ConfigNode frame_el = movie_el.child("frame");
+		while (!frame_el.empty()) {
+			ConfigAttribute ms_attr = frame_el.attribute("ms");
 			if (ms_attr.empty()) {
 				string msg = "Frame tag without \"ms\" attribute: "
 						+ movies_conf;
 				MovieFactory::logger.error("XML Parsing Error: ", msg);
 				Dialog::error("XML Parsing Error", msg);
-				return nullptr;
+				return false;
 			}
 			uint32_t duration = 0;
 			StrUtil::parseUInt(duration, ms_attr.value());
-			string frame_id = frame_el.text().get();
-			Image* img = nullptr;
+			string frame_id = frame_el.text();
+			string img_path;
 			if (frame_id != "NULL") {
-				img = new Image(TextureLoader::load(Path::join("movie", frame_id)));
-				if (!img->ready()) {
+				// images are decoded during playback
+				img_path = Path::join("movie", frame_id);
+				if (!Vfs::exists(img_path + ".png")) {
 					string msg = "Failed to load movie frame image \"" + frame_id
 							+ "\": " + movies_conf;
 					MovieFactory::logger.error(msg);
 					Dialog::error(msg);
-					return nullptr;
+					return false;
 				}
 			}
-			frames.push_back({duration, img});
+			def.frames.push_back({img_path, duration});
 
-			frame_el = frame_el.next_sibling("frame");
+			frame_el = frame_el.nextSibling("frame");
 		}
 
-		xml_node text_el = movie_el.child("text");
-		while (text_el.type() != node_null) {
-			string text = text_el.text().get();
+		ConfigNode text_el = movie_el.child("text");
+		while (!text_el.empty()) {
+			string text = text_el.text();
 
 			// TODO: support delay & duration
 
-			xml_attribute delay_attr = text_el.attribute("delay");
+			ConfigAttribute delay_attr = text_el.attribute("delay");
 			// FIXME: should this be uint32_t?
 			uint16_t delay = 0;
 			StrUtil::parseUShort(delay, delay_attr.value());
 
-			xml_attribute duration_attr = text_el.attribute("duration");
+			ConfigAttribute duration_attr = text_el.attribute("duration");
 			// FIXME: should this be uint32_t?
 			uint16_t duration = 0;
 			StrUtil::parseUShort(duration, duration_attr.value());
 
-			texts.push_back(text);
+			def.texts.push_back(text);
 
-			text_el = text_el.next_sibling("text");
+			text_el = text_el.nextSibling("text");
 		}
+
+		parsed[id] = def;
+		movie_el = movie_el.nextSibling("movie");
+	}
+
+	MovieFactory::movies = parsed;
+	MovieFactory::indexed = true;
+	return true;
+}
+
+Movie* MovieFactory::getMovie(string id) {
+	if (!MovieFactory::indexed && !MovieFactory::index()) {
+		return nullptr;
 	}
 
-	if (frames.size() == 0) {
-		string msg = "Movie \"" + id + "\" has no frames configured: "
-				+ movies_conf;
+	auto it = MovieFactory::movies.find(id);
+	if (it == MovieFactory::movies.end() || it->second.frames.size() == 0) {
+		string msg = "Movie \"" + id + "\" has no frames configured: conf/movies.xml";
 		MovieFactory::logger.error(msg);
 		Dialog::error(msg);
 		return nullptr;
 	}
 
-	Movie* movie = new Movie(frames);
-	for (string t: texts) {
+	const MovieDefinition& def = it->second;
+	Movie* movie = new Movie(def.frames);
+	for (string t: def.texts) {
 		movie->addText(t);
 	}
-	if (fade_in > 0) {
-		movie->setFadeIn(fade_in);
+	if (def.fade_in > 0) {
+		movie->setFadeIn(def.fade_in);
 	}
-	if (fade_out > 0) {
-		movie->setFadeOut(fade_out);
+	if (def.fade_out > 0) {
+		movie->setFadeOut(def.fade_out);
 	}
 
 	return movie;
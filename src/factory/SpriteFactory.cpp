@@ -11,31 +11,33 @@
 #include "Animation.hpp"
 #include "AnimatedSprite.hpp"
 #include "Path.hpp"
+#include "StartupMetrics.hpp"
 #include "StrUtil.hpp"
 #include "TextureLoader.hpp"
 #include "factory/SpriteFactory.hpp"
 
 using namespace std;
-using namespace pugi;
 
 
-static Logger _logger = Logger::getLogger("SpriteFactory");
+static Logger& _logger = Logger::getLogger("SpriteFactory");
 
-shared_ptr<Sprite> SpriteFactory::build(xml_node el) {
-	xml_node el_filename = el.child("filename");
-	if (el_filename.type() == node_null) {
+shared_ptr<Sprite> SpriteFactory::build(ConfigNode el) {
+	StartupScope scope("sprite.build");
+
+	ConfigNode el_filename = el.child("filename");
+	if (el_filename.empty()) {
 		_logger.error("Filename not configured");
 		return nullptr;
 	}
 
 	uint32_t width = 0, height = 0;
-	xml_node el_size = el.child("size");
-	if (el_size.type() != node_null) {
-		xml_attribute attr_width = el_size.attribute("width");
+	ConfigNode el_size = el.child("size");
+	if (!el_size.empty()) {
+		ConfigAttribute attr_width = el_size.attribute("width");
 		if (!attr_width.empty()) {
 			StrUtil::parseUInt(width, attr_width.value());
 		}
-		xml_attribute attr_height = el_size.attribute("height");
+		ConfigAttribute attr_height = el_size.attribute("height");
 		if (!attr_height.empty()) {
 			StrUtil::parseUInt(height, attr_height.value());
 		}
@@ -47,12 +49,12 @@ shared_ptr<Sprite> SpriteFactory::build(xml_node el) {
 
 	string default_mode = "";
 	unordered_map<string, Animation> animation_modes;
-	xml_node el_animation = el.child("animation");
-	while (el_animation.type() != node_null) {
+	ConfigNode el_animation = el.child("animation");
+	while (!el_animation.empty()) {
 		string mode_name = "";
 		AnimationFrameSet current_frames;
 
-		xml_attribute attr_mode = el_animation.attribute("mode");
+		ConfigAttribute attr_mode = el_animation.attribute("mode");
 		if (!attr_mode.empty()) {
 			mode_name = attr_mode.value();
 		}
@@ -61,17 +63,17 @@ shared_ptr<Sprite> SpriteFactory::build(xml_node el) {
 			return nullptr;
 		}
 
-		xml_attribute attr_default = el_animation.attribute("default");
+		ConfigAttribute attr_default = el_animation.attribute("default");
 		bool is_default = false;
 		StrUtil::parseBool(is_default, attr_default.value());
 		if (mode_name.compare("") == 0 || (!attr_default.empty() && is_default)) {
 			default_mode = mode_name;
 		}
 
-		xml_node el_frame = el_animation.child("frame");
-		while (el_frame.type() != node_null) {
-			xml_attribute attr_index = el_frame.attribute("index");
-			xml_attribute attr_delay = el_frame.attribute("delay");
+		ConfigNode el_frame = el_animation.child("frame");
+		while (!el_frame.empty()) {
+			ConfigAttribute attr_index = el_frame.attribute("index");
+			ConfigAttribute attr_delay = el_frame.attribute("delay");
 			if (!attr_index.empty() && !attr_delay.empty()) {
 				uint32_t f_index = 0, f_delay = 0;
 				StrUtil::parseUInt(f_index, attr_index.value());
@@ -79,7 +81,7 @@ shared_ptr<Sprite> SpriteFactory::build(xml_node el) {
 				current_frames.push_back(AnimationFrame(f_index, f_delay));
 			}
 
-			el_frame = el_frame.next_sibling("frame");
+			el_frame = el_frame.nextSibling("frame");
 		}
 
 		if (current_frames.size() == 0) {
@@ -90,11 +92,11 @@ shared_ptr<Sprite> SpriteFactory::build(xml_node el) {
 		ani.setId(mode_name);
 		animation_modes[mode_name] = ani;
 
-		el_animation = el_animation.next_sibling("animation");
+		el_animation = el_animation.nextSibling("animation");
 	}
 
 	shared_ptr<Sprite> sprite_ptr;
-	SDL_Texture* texture = TextureLoader::load(Path::join("sprite", el_filename.text().get()));
+	SDL_Texture* texture = TextureLoader::load(Path::join("sprite", el_filename.text()));
 	if (animation_modes.size() > 0) {
 		// animated sprite
 		sprite_ptr = make_shared<AnimatedSprite>(texture, width, height);
@@ -104,7 +106,7 @@ shared_ptr<Sprite> SpriteFactory::build(xml_node el) {
 	} else {
 		// static sprite
 		uint32_t tile_index = 0;
-		xml_attribute attr_index = el_filename.attribute("index");
+		ConfigAttribute attr_index = el_filename.attribute("index");
 		if (!attr_index.empty()) {
 			StrUtil::parseUInt(tile_index, attr_index.value());
 		}
@@ -112,7 +114,7 @@ shared_ptr<Sprite> SpriteFactory::build(xml_node el) {
 	}
 
 	if (!sprite_ptr->ready()) {
-		xml_attribute attr_id = el.attribute("id");
+		ConfigAttribute attr_id = el.attribute("id");
 		if (!attr_id.empty()) {
 			_logger.warn("Built uninitialized sprite: ", attr_id.value());
 		} else {
@@ -11,20 +11,34 @@
 
 #include <cstdint> // uint*_t
 #include <cstdlib> // exit
+#include <filesystem>
 #include <iostream>
 #include <string>
 
 #include "cxxopts.hpp"
 
+#include "AllocStats.hpp"
+#include "AudioStats.hpp"
 #include "DataLoader.hpp"
+#include "FrameProfiler.hpp"
 #include "GameConfig.hpp"
 #include "GameLoop.hpp"
 #include "GameWindow.hpp"
+#include "HotReload.hpp"
+#include "InputLatency.hpp"
+#include "LogSink.hpp"
 #include "Logger.hpp"
+#include "MemoryStats.hpp"
+#include "MusicPlayer.hpp"
 #include "Path.hpp"
 #include "SingletonRepo.hpp"
+#include "StartupBench.hpp"
+#include "StartupMetrics.hpp"
 #include "StrUtil.hpp"
+#include "Trace.hpp"
+#include "Vfs.hpp"
 #include "reso.hpp"
+#include "store/SceneStore.hpp"
 
 using namespace std;
 
@@ -40,6 +54,9 @@ namespace RRE {
 };
 
 int main(int argc, char** argv) {
+	StartupMetrics::begin();
+	Trace::setThreadName("main");
+
 	// parse command line parameters
 	RRE::populateOptions();
 	cxxopts::ParseResult args;
@@ -60,26 +77,85 @@ int main(int argc, char** argv) {
 	if (args.count("verbose")) {
 		Logger::setVerbose();
 	}
+	if (args.count("log-rate")) {
+		LogSink::setRateLimit(args["log-rate"].as<uint32_t>());
+	}
+	if (args.count("no-log-file")) {
+		LogSink::setFileOutput(false);
+	}
+	if (args.count("log-overflow")) {
+		string policy = args["log-overflow"].as<string>();
+		if (policy == "sync") {
+			LogSink::setOverflow(LogSink::SYNC);
+		} else if (policy != "drop") {
+			RRE::exitWithError(1, "Unknown log overflow policy: " + policy, true);
+		}
+	}
+	// messages are written by background thread from here on
+	LogSink::start();
 
-	Logger logger = Logger::getLogger("main");
+	Logger& logger = Logger::getLogger("main");
 
-#if RRE_DEBUGGING
-	logger.debug("Compiled using C++ standard: ", to_string(__cplusplus));
-#endif
+	LOG_DEBUG(logger, "Compiled using C++ standard: ", to_string(__cplusplus));
+
+	// relative to working directory of caller
+	string data_path;
+	if (args.count("data")) {
+		data_path = filesystem::absolute(args["data"].as<string>()).string();
+	}
+	if (args.count("trace-dir")) {
+		Trace::setOutputDir(filesystem::absolute(args["trace-dir"].as<string>()).string());
+	}
+	if (args.count("trace-budget")) {
+		Trace::setBudget(args["trace-budget"].as<uint32_t>());
+	}
+	if (args.count("trace-window")) {
+		Trace::setWindow(args["trace-window"].as<uint32_t>());
+	}
+
+	if (args.count("bench-startup")) {
+		return StartupBench::run(args["bench-startup"].as<uint32_t>(), data_path);
+	}
 
 	// change to executable directory
 	Path::changeDir(Path::dir_root);
 
+	// mount game data (packed archive or loose data directory)
+	{
+		StartupScope scope("vfs.mount");
+		bool mounted = data_path.empty() ? Vfs::mount() : Vfs::mount(data_path);
+		if (!mounted) {
+			RRE::exitWithError(1, "Failed to mount game data", false);
+		}
+	}
+
 	// TODO: move SDL initialization to here so configuration can be loaded before window is displayed
 
 	GameWindow* win = GameWindow::get();
 
-	int result = GameConfig::load();
+	int result;
+	{
+		StartupScope scope("config");
+		result = GameConfig::load();
+	}
 	if (result != 0) {
 		// FIXME: need to create SDL window to show configuration errors
 		return result;
 	}
 
+	// command line overrides configured audio device parameters
+	AudioSpec audio_spec = GameConfig::getAudioSpec();
+	if (args.count("audio-rate")) {
+		audio_spec.rate = args["audio-rate"].as<uint32_t>();
+	}
+	if (args.count("audio-chunk")) {
+		audio_spec.chunk = args["audio-chunk"].as<uint16_t>();
+	}
+	if (args.count("audio-channels")) {
+		audio_spec.channels = args["audio-channels"].as<uint16_t>();
+	}
+	GameConfig::setAudioSpec(audio_spec);
+
 	win->setTitle(GameConfig::getTitle());
 
 	uint16_t scale = GameConfig::getScale();
@@ -88,11 +164,10 @@ int main(int argc, char** argv) {
 	int height = NATIVE_RES.second * scale;
 
 	GetGameLogic()->setStepDelay(GameConfig::getStepDelay());
+	SceneStore::setCacheBudget(GameConfig::getSceneCacheBudget());
 
-#if RRE_DEBUGGING
-	logger.debug("Game title: ", GameConfig::getTitle());
-	logger.debug("Window scale: ", to_string(GameConfig::getScale()));
-#endif
+	LOG_DEBUG(logger, "Game title: ", GameConfig::getTitle());
+	LOG_DEBUG(logger, "Window scale: ", to_string(GameConfig::getScale()));
 
 	result = win->init(width, height);
 	if (result != 0) {
@@ -104,16 +179,55 @@ int main(int argc, char** argv) {
 	}
 
 	// renderer must be constructed before texture data can be loaded
+	// NOTE: only data needed for first frame is loaded here, remainder is loaded by game loop
 	if (!DataLoader::load()) {
 		logger.error("Failed to load game data");
-#if RRE_DEBUGGING
 	} else {
-		logger.debug("Game data loaded");
+		LOG_DEBUG(logger, "Critical game data loaded");
+	}
+
+	if (args.count("bench-run")) {
+		result = StartupBench::runChild(args["bench-run"].as<string>());
+		MusicPlayer::shutdown();
+		return result;
+	}
+
+#if HAVE_HOT_RELOAD
+	if (args.count("watch")) {
+		HotReload::start();
+	}
 #endif
+
+	if (args.count("bench-input")) {
+		InputLatency::startInjection(args["bench-input"].as<uint32_t>());
+	}
+	if (args.count("frame-csv")) {
+		FrameProfiler::startCsv(args["frame-csv"].as<string>());
 	}
+#if HAVE_ALLOC_TRACKING
+	if (args.count("assert-no-alloc")) {
+		AllocStats::setStrict(true);
+	}
+#endif
 
 	GameLoop::start();
 
+	HotReload::stop();
+	FrameProfiler::stopCsv();
+	if (args.count("audio-stats")) {
+		AudioStats::writeJson(cout);
+	}
+	if (args.count("bench-input")) {
+		InputLatency::writeJson(cout);
+	}
+	if (args.count("render-stats")) {
+		GetRenderer()->writeJson(cout);
+	}
+	if (args.count("mem-report")) {
+		MemoryStats::writeReport(cout);
+	}
+	// worker thread must be joined before exit
+	MusicPlayer::shutdown();
 	return 0;
 }
 
@@ -129,7 +243,7 @@ void RRE::printUsage(bool header) {
 	cout << endl;
 		cout << "R&R Engine: 2D platform game engine" << endl;
 	}
-	cout << RRE::options.help() << endl;
+	cout << RRE::options.help({""}) << endl;
 }
 
 void RRE::printVersion() {
@@ -149,5 +263,40 @@ void RRE::populateOptions() {
 		("h,help", "Show this help information.")
 		("v,version", "Show version information")
 		("V,verbose", "Enable verbose logging.")
+		("d,data", "Game data directory or archive to use instead of default.", cxxopts::value<string>())
+		("bench-startup", "Measure cold & warm startup over N runs & print per-phase medians as JSON.",
+				cxxopts::value<uint32_t>()->implicit_value(to_string(StartupBench::DEFAULT_RUNS)), "N")
+		("audio-rate", "Audio output sample rate in Hz (overrides game.xml).", cxxopts::value<uint32_t>(), "HZ")
+		("audio-chunk", "Audio sample frames mixed per callback; lower values reduce latency & raise CPU use (overrides game.xml).",
+				cxxopts::value<uint16_t>(), "FRAMES")
+		("audio-channels", "Number of audio output channels (overrides game.xml).", cxxopts::value<uint16_t>(), "N")
+		("audio-stats", "Print mixer measurements as JSON on exit.")
+		("render-stats", "Print mean renderer work per frame as JSON on exit.")
+		("mem-report", "Print estimated memory held by stores & cached scenes as JSON on exit.")
+		("log-rate", "Max messages per second logged from a single source location (0 for unlimited).",
+				cxxopts::value<uint32_t>(), "N")
+		("no-log-file", "Only write log messages to console, not to debug.log.")
+		("log-overflow", "Handling of messages when log buffer is full: \"drop\" (default) or \"sync\" (write immediately, may stall game).",
+				cxxopts::value<string>(), "POLICY")
+		("bench-input", "Inject N synthetic key presses, then exit & print input-to-present latency as JSON.",
+				cxxopts::value<uint32_t>()->implicit_value(to_string(InputLatency::DEFAULT_SAMPLES)), "N")
+		("frame-csv", "Write per-frame stage timings (microseconds) to a CSV file.", cxxopts::value<string>(), "PATH")
+		("trace-budget", "Write recent trace zones to a file when a frame takes longer than MS milliseconds.",
+				cxxopts::value<uint32_t>(), "MS")
+		("trace-window", "Seconds of recent trace zones written to a trace file (default "
+				+ to_string(Trace::DEFAULT_WINDOW) + ").", cxxopts::value<uint32_t>(), "SEC")
+		("trace-dir", "Directory trace files are written to (default is executable directory).",
+				cxxopts::value<string>(), "DIR")
+#if HAVE_HOT_RELOAD
+		("w,watch", "Reload changed game data while running (development mode).")
+#endif
+#if HAVE_ALLOC_TRACKING
+		("assert-no-alloc", "Abort when a steady-state section allocates instead of logging an error.")
+#endif
+	;
+	// not shown in usage
+	RRE::options.add_options("internal")
+		// single benchmark run launched by `--bench-startup`
+		("bench-run", "", cxxopts::value<string>())
 	;
 }
@@ -6,52 +6,146 @@
 
 #include "config.h"
 
+#include <algorithm> // std::max, std::min
 #include <unordered_map>
+#include <vector>
 
-#include "Filesystem.hpp"
+#include <SDL2/SDL_rwops.h>
+
+#include "ConfigDocument.hpp"
 #include "Logger.hpp"
-#include "Path.hpp"
+#include "StrUtil.hpp"
+#include "Trace.hpp"
+#include "Vfs.hpp"
 #include "store/AudioStore.hpp"
 
 using namespace std;
 
 
 namespace AudioStore {
-	Logger logger = Logger::getLogger("AudioStore");
+	Logger& logger = Logger::getLogger("AudioStore");
 
 	bool loaded = false;
 
 	unordered_map<string, string> music_paths;
+
+	/** Decoded sound effects indexed by interned identifier. */
+	static vector<SoundEffect> sounds;
+	/** Interned identifiers indexed by sound name. */
+	static unordered_map<string, SoundId> sound_ids;
+
+	/**
+	 * Decodes sound effects from data/sfx directory.
+	 */
+	static void loadSounds();
+
+	/**
+	 * Applies priorities & instance limits configured in conf/sounds.xml.
+	 */
+	static void loadSoundConfig();
+}
+
+void AudioStore::loadSounds() {
+	string dir_sfx = "sfx";
+	vector<string> sfx_files = Vfs::list(dir_sfx);
+	for (const string& p: sfx_files) {
+		if (!p.ends_with(".oga") && !p.ends_with(".ogg") && !p.ends_with(".wav")) {
+			continue;
+		}
+		if (AudioStore::sounds.size() >= AudioStore::NO_SOUND) {
+			logger.warn("Too many sound effects, not loading: ", p);
+			continue;
+		}
+
+		int d_len = dir_sfx.length();
+		string id = p.substr(d_len + 1, p.length() - d_len - 5);
+		VfsFile file = Vfs::read(p);
+		Mix_Chunk* chunk = nullptr;
+		if (file.ready()) {
+			// decoded into chunk, file data is not kept
+			chunk = Mix_LoadWAV_RW(SDL_RWFromConstMem(file.data, file.size), 1);
+		}
+		if (chunk == nullptr) {
+			logger.warn("Failed to load sound effect (", Mix_GetError(), "): ", p);
+			continue;
+		}
+
+		AudioStore::sound_ids[id] = AudioStore::sounds.size();
+		AudioStore::sounds.push_back({chunk, AudioStore::DEFAULT_PRIORITY,
+				AudioStore::DEFAULT_VOICES});
+
+		LOG_DEBUG(AudioStore::logger, "Loaded sound effect with ID \"", id, "\" (", p, ", ",
+				to_string(chunk->alen), " bytes)");
+	}
+}
+
+void AudioStore::loadSoundConfig() {
+	string conf = "conf/sounds.xml";
+	if (!Vfs::exists(conf)) {
+		return;
+	}
+
+	ConfigDocument doc;
+	string error;
+	if (!doc.load(conf, error)) {
+		logger.warn("Failed to load sound configuration (", error, "): ", conf);
+		return;
+	}
+
+	ConfigNode el = doc.child("sounds").child("sound");
+	while (!el.empty()) {
+		string id = el.attribute("id").value();
+		auto iter = AudioStore::sound_ids.find(id);
+		if (iter == AudioStore::sound_ids.end()) {
+			logger.warn("Configured sound effect not found: ", id);
+			el = el.nextSibling("sound");
+			continue;
+		}
+
+		SoundEffect& sound = AudioStore::sounds[iter->second];
+		uint32_t value;
+		ConfigAttribute attr_priority = el.attribute("priority");
+		if (!attr_priority.empty() && StrUtil::parseUInt(value, attr_priority.value()).first == 0) {
+			sound.priority = min(value, (uint32_t) UINT8_MAX);
+		}
+		ConfigAttribute attr_voices = el.attribute("voices");
+		if (!attr_voices.empty() && StrUtil::parseUInt(value, attr_voices.value()).first == 0) {
+			sound.max_voices = max(min(value, (uint32_t) UINT8_MAX), (uint32_t) 1);
+		}
+		ConfigAttribute attr_volume = el.attribute("volume");
+		if (!attr_volume.empty() && StrUtil::parseUInt(value, attr_volume.value()).first == 0) {
+			Mix_VolumeChunk(sound.chunk, min(value, (uint32_t) MIX_MAX_VOLUME));
+		}
+
+		el = el.nextSibling("sound");
+	}
 }
 
 bool AudioStore::load() {
+	TraceZone zone("AudioStore::load");
 	if (AudioStore::loaded) {
 		AudioStore::logger.warn("Audio data already loaded");
 		return true;
 	}
 
-	string dir_music = Path::rabs("data/music");
-	if (!filesystem::is_directory(dir_music)) {
+	string dir_music = "music";
+	vector<string> music_files = Vfs::list(dir_music);
+	if (music_files.empty()) {
 		logger.warn("Music data directory not found: ", dir_music);
 	} else {
-		for (filesystem::directory_entry item: Filesystem::listDir(dir_music, true)) {
-			if (!item.is_regular_file()) {
-				continue;
-			}
-			string p = item.path().string();
-			if (p.ends_with(".oga") || string(p).ends_with(".ogg")) {
+		for (const string& p: music_files) {
+			if (p.ends_with(".oga") || p.ends_with(".ogg")) {
 				int d_len = dir_music.length();
 				string id = p.substr(d_len + 1, p.length() - d_len - 5); // @suppress("Invalid arguments")
 				AudioStore::music_paths[id] = p;
 
-#if RRE_DEBUGGING
-				AudioStore::logger.debug("Loaded music with ID \"", id, "\" (", p, ")");
-#endif
+				LOG_DEBUG(AudioStore::logger, "Loaded music with ID \"", id, "\" (", p, ")");
 			}
 		}
 	}
 
-	// TODO: load sound effects
+	AudioStore::loadSounds();
+	AudioStore::loadSoundConfig();
 
 	AudioStore::loaded = true;
 	return true;
@@ -64,3 +158,42 @@ string AudioStore::getMusicPath(const string id) {
 	AudioStore::logger.warn("Music with ID \"", id, "\" not loaded");
 	return "";
 }
+
+void AudioStore::unload() {
+	for (SoundEffect& sound: AudioStore::sounds) {
+		Mix_FreeChunk(sound.chunk);
+	}
+	AudioStore::sounds.clear();
+	AudioStore::sound_ids.clear();
+}
+
+SoundId AudioStore::getSoundId(const string& id) {
+	auto iter = AudioStore::sound_ids.find(id);
+	if (iter == AudioStore::sound_ids.end()) {
+		AudioStore::logger.warn("Sound effect with ID \"", id, "\" not loaded");
+		return AudioStore::NO_SOUND;
+	}
+	return iter->second;
+}
+
+const SoundEffect* AudioStore::getSound(SoundId id) {
+	if (id >= AudioStore::sounds.size()) {
+		return nullptr;
+	}
+	return &AudioStore::sounds[id];
+}
+
+uint16_t AudioStore::getSoundCount() {
+	return AudioStore::sounds.size();
+}
+
+MemoryUsage AudioStore::getMemoryUsage() {
+	MemoryUsage usage;
+	for (const SoundEffect& sound: AudioStore::sounds) {
+		if (sound.chunk != nullptr) {
+			usage.bytes += sound.chunk->alen;
+		}
+	}
+	usage.count = AudioStore::sounds.size();
+	return usage;
+}
@@ -4,24 +4,40 @@
  * See: LICENSE.txt
  */
 
-#include <unordered_map>
+#include "config.h"
 
-#include <pugixml.hpp>
+#include <cstdint> // uint64_t
+#include <memory> // std::make_unique, std::unique_ptr
+#include <unordered_map>
+#include <utility> // std::move
+#include <vector>
 
+#include "ConfigDocument.hpp"
 #include "Dialog.hpp"
-#include "Filesystem.hpp"
 #include "Logger.hpp"
-#include "Path.hpp"
+#include "Trace.hpp"
+#include "Vfs.hpp"
 #include "factory/EntityFactory.hpp"
 #include "store/EntityStore.hpp"
 #include "template/EntityTemplate.hpp"
 
-using namespace pugi;
 using namespace std;
 
 
-static Logger _logger = Logger::getLogger("EntityStore");
+static Logger& _logger = Logger::getLogger("EntityStore");
 
+/** Configuration of an entity that can be built on demand. */
+struct EntityEntry {
+	/** Configuration element (owned by `_doc`). */
+	ConfigNode node;
+	/** Hash of configuration element used to detect changes. */
+	uint64_t hash;
+};
+
+// parsed entity configuration referenced by index entries
+static unique_ptr<ConfigDocument> _doc;
+// configured entities indexed by ID
+static unordered_map<string, EntityEntry> _index;
 // base entities to make copies
 static unordered_map<string, EntityTemplate> _cache;
 
@@ -39,61 +55,152 @@ static void _onConfigError(string msg) {
 	_onConfigError("", msg);
 }
 
-bool EntityStore::load() {
-	string conf = Path::rabs("data/conf/entities.xml");
-	if (!Filesystem::fexist(conf)) {
+/**
+ * Retrieves a cached entity template, building it if necessary.
+ *
+ * Sprite of entity is loaded with template.
+ *
+ * @param id
+ *   Entity identifier.
+ * @return
+ *   Template or `null` if entity is not configured.
+ */
+static EntityTemplate* _materialize(string id) {
+	auto cached = _cache.find(id);
+	if (cached != _cache.end()) {
+		return &cached->second;
+	}
+	auto entry = _index.find(id);
+	if (entry == _index.end()) {
+		return nullptr;
+	}
+	return &(_cache[id] = EntityFactory::build(entry->second.node));
+}
+
+/**
+ * Parses entity configuration into index.
+ *
+ * Templates are built on first retrieval.
+ *
+ * @param reload
+ *   If `true`, cached templates with changed definitions are rebuilt.
+ * @return
+ *   `true` if loading succeeded without error.
+ */
+static bool _load(bool reload) {
+	string conf = "conf/entities.xml";
+	if (!Vfs::exists(conf)) {
 		_onConfigError("Configuration not found: " + conf);
 		// don't halt process
 		return true;
 	}
 
-	xml_document doc;
-	if (doc.load_file(conf.c_str()).status != status_ok) {
-		_onConfigError("Failed to load config: " + conf);
+	unique_ptr<ConfigDocument> doc = make_unique<ConfigDocument>();
+	string error;
+	if (!doc->load(conf, error)) {
+		_onConfigError("Failed to load config (" + error + "): " + conf);
 		return false;
 	}
 
-	xml_node root = doc.child("entities");
-	if (root.type() == node_null) {
+	ConfigNode root = doc->child("entities");
+	if (root.empty()) {
 		_onConfigError("XML Parsing Error", "Root element \"entities\" not found: " + conf);
 		return false;
 	}
 
-	xml_node el = root.child("entity");
-	while (el.type() != node_null) {
-		xml_attribute attr_id = el.attribute("id");
+	unordered_map<string, EntityEntry> index;
+	// cached templates that must be rebuilt
+	vector<string> changed;
+	ConfigNode el = root.child("entity");
+	while (!el.empty()) {
+		ConfigAttribute attr_id = el.attribute("id");
 		if (attr_id.empty()) {
 			_onConfigError("XML Parsing Error", "Entity without \"id\" attribute: " + conf);
 			return false;
 		}
-		_cache[attr_id.value()] = EntityFactory::build(el);
+		string id = attr_id.value();
+		uint64_t hash = el.hash();
+		if (reload && _cache.find(id) != _cache.end()) {
+			auto prev = _index.find(id);
+			if (prev == _index.end() || prev->second.hash != hash) {
+				changed.push_back(id);
+			}
+		}
+		index[id] = {el, hash};
+
+		el = el.nextSibling("entity");
+	}
+
+	// nodes of previous index reference previous document
+	_index = move(index);
+	_doc = move(doc);
+
+	for (const string& id: changed) {
+		_cache.erase(id);
+		_materialize(id);
+		// entities already in scenes keep their attributes
+		_logger.info("Reloaded entity: ", id);
+	}
 
-		el = el.next_sibling("entity");
+	if (!reload) {
+		LOG_DEBUG(_logger, "Indexed ", to_string(_index.size()), " entities");
 	}
 
 	return true;
 }
 
+bool EntityStore::load() {
+	return _load(false);
+}
+
+bool EntityStore::reload() {
+	return _load(true);
+}
+
+bool EntityStore::preload(const vector<string>& ids) {
+	TraceZone zone("EntityStore::preload");
+	bool result = true;
+	for (const string& id: ids) {
+		if (_materialize(id) == nullptr) {
+			_logger.warn("Entity not available for preload: ", id);
+			result = false;
+		}
+	}
+	return result;
+}
+
 Entity EntityStore::get(string id) {
-	if (_cache.find(id) == _cache.end()) {
+	EntityTemplate* entity = _materialize(id);
+	if (entity == nullptr) {
 		_logger.error("Entity \"", id, "\" not available");
 		return NullEntity;
 	}
-	return *_cache[id].build().get();
+	return *entity->build().get();
 }
 
 Character EntityStore::getCharacter(string id) {
-	if (_cache.find(id) == _cache.end()) {
+	EntityTemplate* entity = _materialize(id);
+	if (entity == nullptr) {
 		_logger.error("Character \"", id, "\" not available");
 		return *dynamic_cast<const Character*>(&NullEntity);
 	}
-	return *_cache[id].buildCharacter().get();
+	return *entity->buildCharacter().get();
 }
 
 Player EntityStore::getPlayer(string id) {
-	if (_cache.find(id) == _cache.end()) {
+	EntityTemplate* entity = _materialize(id);
+	if (entity == nullptr) {
 		_logger.error("Player \"", id, "\" not available");
 		return *dynamic_cast<const Player*>(&NullEntity);
 	}
-	return *_cache[id].buildPlayer().get();
+	return *entity->buildPlayer().get();
+}
+
+MemoryUsage EntityStore::getMemoryUsage() {
+	MemoryUsage usage;
+	for (const auto& [id, entity]: _cache) {
+		usage.bytes += entity.getByteSize();
+	}
+	usage.count = _cache.size();
+	return usage;
 }
@@ -28,8 +28,17 @@ FontMap* FontMapStore::get(string font_id) {
 	return nullptr;
 }
 
+MemoryUsage FontMapStore::getMemoryUsage() {
+	MemoryUsage usage;
+	for (const auto& [id, font_map]: fmap_cache) {
+		usage.bytes += font_map->getByteSize();
+	}
+	usage.count = fmap_cache.size();
+	return usage;
+}
+
 Sprite* FontMapStore::buildTextSprite(FontMap* font_map, string text) {
-	Logger logger = Logger::getLogger("FontMapStore");
+	Logger& logger = Logger::getLogger("FontMapStore");
 
 	// TODO: cache text sprites for redraw (probably in Viewport class)
 
@@ -51,20 +60,18 @@ Sprite* FontMapStore::buildTextSprite(FontMap* font_map, string text) {
 	// source image
 	SDL_Texture* s_texture = font_map->getTexture();
 
-	SDL_Renderer* renderer = SDL_GetRenderer(GetGameWindow()->getElement());
+	Renderer* renderer = GetRenderer();
 
-	SDL_Texture* t_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
-			SDL_TEXTUREACCESS_TARGET, full_width, c_height);
+	SDL_Texture* t_texture = renderer->createTargetTexture(full_width, c_height);
 	if (t_texture == nullptr) {
 		logger.error((string) "Cannot build text sprite: ", SDL_GetError());
 		return nullptr;
 	}
-	SDL_SetTextureBlendMode(t_texture, SDL_BLENDMODE_BLEND);
 
 	// set render target to background
-	SDL_SetRenderTarget(renderer, t_texture);
+	renderer->setTarget(t_texture);
 
-	SDL_RenderClear(renderer);
+	renderer->clear();
 
 	SDL_Rect t_rect;
 	t_rect.x = 0;
@@ -103,11 +110,11 @@ Sprite* FontMapStore::buildTextSprite(FontMap* font_map, string text) {
 
 		t_rect.x = idx * c_width;
 
-		SDL_RenderCopy(renderer, s_texture, &s_rect, &t_rect);
+		renderer->drawTexture(s_texture, s_rect, t_rect, SDL_FLIP_NONE);
 	}
 
 	// restore render target to screen
-	SDL_SetRenderTarget(renderer, nullptr);
+	renderer->setTarget(nullptr);
 
 	int t_width, t_height;
 	SDL_QueryTexture(t_texture, nullptr, nullptr, &t_width, &t_height);
@@ -6,8 +6,15 @@
 
 #include "config.h"
 
+#include <algorithm> // std::sort
 #include <cstdint> // *int*_t
+#include <filesystem>
+#include <list>
+#include <memory> // std::make_shared, std::make_unique, std::shared_ptr, std::unique_ptr
+#include <span>
 #include <unordered_map>
+#include <utility> // std::move
+#include <vector>
 
 #include <tmxlite/ImageLayer.hpp>
 #include <tmxlite/Map.hpp>
@@ -15,12 +22,17 @@
 #include <tmxlite/TileLayer.hpp>
 #include <tmxlite/Types.hpp>
 
-#include "Filesystem.hpp"
+#include "GameConfig.hpp"
 #include "LayerDefinition.hpp"
 #include "Logger.hpp"
 #include "Path.hpp"
+#include "SceneBlob.hpp"
+#include "SceneChunk.hpp"
+#include "StartupMetrics.hpp"
 #include "TextureLoader.hpp"
 #include "Tileset.hpp"
+#include "Trace.hpp"
+#include "Vfs.hpp"
 #include "store/SceneStore.hpp"
 
 using namespace std;
@@ -32,38 +44,271 @@ using namespace std;
 #include "store/EntityStore.hpp"
 
 
-static Logger logger = Logger::getLogger("SceneStore");
+static Logger& logger = Logger::getLogger("SceneStore");
+
+/** Cached scene with estimated memory usage. */
+struct SceneCacheEntry {
+	shared_ptr<Scene> scene;
+	size_t bytes;
+	/** Position in recently used list. */
+	list<string>::iterator lru_pos;
+};
+
+/**
+ * Chunk source for infinite TMX maps.
+ *
+ * NOTE: tile data of whole map is held in memory & counted against cache budget; compile map with
+ *       `rre-scenec` so that only chunks near view are paged in
+ */
+class TmxChunkSource: public ChunkSource {
+private:
+	ChunkedLayer layers[SceneLayer::COUNT];
+
+public:
+	/**
+	 * Adds tiles of a map layer.
+	 *
+	 * @param id
+	 *   Scene layer to add tiles to.
+	 * @param t_layer
+	 *   Infinite map tile layer.
+	 */
+	void addLayer(SceneLayer::Id id, const tmx::TileLayer& t_layer) {
+		for (const tmx::TileLayer::Chunk& t_chunk: t_layer.getChunks()) {
+			LayerDefinition ldef;
+			ldef.reserve(t_chunk.tiles.size());
+			for (const tmx::TileLayer::Tile& tile: t_chunk.tiles) {
+				ldef.push_back(TileDefinition(tile.ID, tile.flipFlags));
+			}
+			SceneChunks::split(layers[id], ldef, t_chunk.position.x, t_chunk.position.y,
+					t_chunk.size.x, SceneChunks::DEFAULT_SIZE, SceneChunks::DEFAULT_SIZE);
+		}
+	}
+
+	uint32_t getChunkWidth() override { return SceneChunks::DEFAULT_SIZE; }
+
+	uint32_t getChunkHeight() override { return SceneChunks::DEFAULT_SIZE; }
+
+	bool loadChunk(int32_t cx, int32_t cy, SceneChunk& chunk) override {
+		uint64_t key = SceneChunks::getKey(cx, cy);
+		bool found = false;
+		for (uint8_t id = 0; id < SceneLayer::COUNT; id++) {
+			auto iter = layers[id].find(key);
+			if (iter != layers[id].end()) {
+				// chunk references tiles held by source
+				chunk.layers[id] = TileLayer(span<const TileDefinition>(iter->second));
+				found = true;
+			}
+		}
+		return found;
+	}
+
+	size_t getByteSize() override {
+		size_t bytes = 0;
+		for (const ChunkedLayer& layer: layers) {
+			for (const auto& [key, ldef]: layer) {
+				bytes += ldef.capacity() * sizeof(TileDefinition);
+			}
+		}
+		return bytes;
+	}
+};
+
+/**
+ * Chunk source referencing tiles of a chunked scene blob in place.
+ */
+class BlobChunkSource: public ChunkSource {
+private:
+	SceneBlob::Reader blob;
+	/** Chunk record indexes by chunk position. */
+	unordered_map<uint64_t, vector<uint32_t>> index;
+	/** Scene layer of each blob tile layer. */
+	vector<SceneLayer::Id> layer_ids;
+
+public:
+	BlobChunkSource(const SceneBlob::Reader& blob): blob(blob) {
+		for (const SceneBlob::TileLayerRecord& t_layer: blob.getTileLayers()) {
+			string name = blob.getString(t_layer.name);
+			SceneLayer::Id id = SceneChunks::getLayerId(name);
+			if (id == SceneLayer::COUNT) {
+				logger.warn("Unknown tile layer \"", name, "\"");
+			}
+			layer_ids.push_back(id);
+		}
+		span<const SceneBlob::ChunkRecord> records = blob.getChunks();
+		for (uint32_t idx = 0; idx < records.size(); idx++) {
+			index[SceneChunks::getKey(records[idx].x, records[idx].y)].push_back(idx);
+		}
+	}
+
+	uint32_t getChunkWidth() override { return blob.getHeader().chunk_width; }
+
+	uint32_t getChunkHeight() override { return blob.getHeader().chunk_height; }
+
+	bool loadChunk(int32_t cx, int32_t cy, SceneChunk& chunk) override {
+		auto iter = index.find(SceneChunks::getKey(cx, cy));
+		if (iter == index.end()) {
+			return false;
+		}
+		for (uint32_t idx: iter->second) {
+			const SceneBlob::ChunkRecord& record = blob.getChunks()[idx];
+			SceneLayer::Id id = layer_ids[record.layer];
+			if (id != SceneLayer::COUNT) {
+				chunk.layers[id] = TileLayer(blob.getTiles(record));
+			}
+		}
+		return true;
+	}
+};
+
 
 namespace SceneStore {
 	bool loaded = false;
 
 	unordered_map<string, string> scene_paths;
 	// scene data cached in memory
-	unordered_map<string, Scene*> scenes;
+	unordered_map<string, SceneCacheEntry> scenes;
+	// cached scene IDs ordered by most recently used
+	list<string> scenes_lru;
+
+	// default budget of 32MB
+	size_t cache_budget = 32 * 1024 * 1024;
+	size_t cache_usage = 0;
+
+	// DEBUG: entities placed in every scene by `SceneStore::get`
+	const vector<string> scene_entities = {"player", "enemy", "flying_enemy"};
+
+	/**
+	 * Loads scene from precompiled blob.
+	 *
+	 * @param map_path
+	 *   Path to source TMX map.
+	 * @return
+	 *   Scene or `null` if blob is missing, stale or invalid.
+	 */
+	shared_ptr<Scene> loadBlob(string map_path);
+
+	/**
+	 * Loads scene from TMX map.
+	 *
+	 * @param map_path
+	 *   Path to TMX map.
+	 * @return
+	 *   Scene or `null` if map could not be parsed.
+	 */
+	shared_ptr<Scene> loadMap(string map_path);
+
+	/**
+	 * Loads scene from precompiled blob if up to date or from TMX map otherwise.
+	 *
+	 * @param map_path
+	 *   Path to TMX map.
+	 * @return
+	 *   Scene or `null` if map could not be loaded.
+	 */
+	shared_ptr<Scene> loadScene(string map_path);
+
+	/**
+	 * Enables streaming of a scene with configured stream radius & prefetch distance.
+	 *
+	 * @param scene
+	 *   Scene to be streamed.
+	 * @param source
+	 *   Source of chunk data.
+	 */
+	void setStreamed(Scene* scene, unique_ptr<ChunkSource> source);
 };
 
+void SceneStore::evict() {
+	auto iter = SceneStore::scenes_lru.end();
+	while (SceneStore::cache_usage > SceneStore::cache_budget
+			&& iter != SceneStore::scenes_lru.begin()) {
+		iter--;
+		SceneCacheEntry& entry = SceneStore::scenes[*iter];
+		if (entry.scene.use_count() > 1) {
+			// scene in use
+			continue;
+		}
+
+		LOG_DEBUG(logger, "Evicting scene \"", *iter, "\" from cache (", to_string(entry.bytes),
+				" bytes)");
+
+		SceneStore::cache_usage -= entry.bytes;
+		SceneStore::scenes.erase(*iter);
+		iter = SceneStore::scenes_lru.erase(iter);
+	}
+}
+
+void SceneStore::release(string id) {
+	auto iter = SceneStore::scenes.find(id);
+	if (iter == SceneStore::scenes.end()) {
+		return;
+	}
+	SceneStore::cache_usage -= iter->second.bytes;
+	SceneStore::scenes_lru.erase(iter->second.lru_pos);
+	SceneStore::scenes.erase(iter);
+}
+
+void SceneStore::updateUsage(const Scene* scene) {
+	for (auto& [id, entry]: SceneStore::scenes) {
+		if (entry.scene.get() != scene) {
+			continue;
+		}
+		SceneStore::cache_usage -= entry.bytes;
+		entry.bytes = entry.scene->getMemoryUsage();
+		SceneStore::cache_usage += entry.bytes;
+		SceneStore::evict();
+		return;
+	}
+}
+
+void SceneStore::clear() {
+	SceneStore::scenes.clear();
+	SceneStore::scenes_lru.clear();
+	SceneStore::cache_usage = 0;
+}
+
+void SceneStore::setCacheBudget(size_t bytes) {
+	SceneStore::cache_budget = bytes;
+	SceneStore::evict();
+}
+
+size_t SceneStore::getCacheBudget() {
+	return SceneStore::cache_budget;
+}
+
+size_t SceneStore::getCacheUsage() {
+	return SceneStore::cache_usage;
+}
+
+vector<pair<string, SceneMemory>> SceneStore::getMemoryBreakdown() {
+	vector<pair<string, SceneMemory>> breakdown;
+	for (auto& [id, entry]: SceneStore::scenes) {
+		breakdown.push_back({id, entry.scene->getMemoryBreakdown()});
+	}
+	sort(breakdown.begin(), breakdown.end(), [](const auto& a, const auto& b) {
+		return a.first < b.first;
+	});
+	return breakdown;
+}
+
 bool SceneStore::load() {
 	if (SceneStore::loaded) {
 		logger.warn("Scene paths already loaded");
 		return true;
 	}
 
-	string dir_scene = Path::rabs("data/scene");
-	if (!filesystem::is_directory(dir_scene)) {
+	string dir_scene = "scene";
+	vector<string> scene_files = Vfs::list(dir_scene, ".tmx");
+	if (scene_files.empty()) {
 		logger.warn("Scene data directory not found: ", dir_scene);
 	} else {
-		for (filesystem::directory_entry item: Filesystem::listDir(dir_scene, true)) {
-			string p = item.path().string();
-			if (!item.is_regular_file() || !p.ends_with(".tmx")) {
-				continue;
-			}
+		for (const string& p: scene_files) {
 			int d_len = dir_scene.length();
 			string id = p.substr(d_len + 1, p.length() - d_len - 5); // @suppress("Invalid arguments")
 			SceneStore::scene_paths[id] = p;
 
-#if RRE_DEBUGGING
-			logger.debug("Loaded scene path with ID \"", id, "\" (", p, ")");
-#endif
+			LOG_DEBUG(logger, "Loaded scene path with ID \"", id, "\" (", p, ")");
 		}
 	}
 
@@ -71,38 +316,219 @@ bool SceneStore::load() {
 	return true;
 }
 
-Scene* SceneStore::get(string id) {
-	// look in cache first
-	if (SceneStore::scenes.find(id) != SceneStore::scenes.end()) {
-		return SceneStore::scenes[id];
+bool SceneStore::reload(string id) {
+	auto cached = SceneStore::scenes.find(id);
+	if (cached == SceneStore::scenes.end()) {
+		// loaded from updated files when next requested
+		return true;
 	}
 
-	// get map file path
-	string map_path;
-	if (SceneStore::scene_paths.find(id) == SceneStore::scene_paths.end()) {
-		logger.warn("Scene not found: ", id);
+	shared_ptr<Scene> fresh = SceneStore::loadScene(SceneStore::scene_paths[id]);
+	if (fresh == nullptr) {
+		logger.error("Failed to reload scene, keeping previous data: ", id);
+		return false;
+	}
+
+	// replace map data of cached instance so that active scene is updated in place
+	SceneCacheEntry& entry = cached->second;
+	entry.scene->swapMap(*fresh.get());
+	SceneStore::cache_usage -= entry.bytes;
+	entry.bytes = entry.scene->getMemoryUsage();
+	SceneStore::cache_usage += entry.bytes;
+
+	logger.info("Reloaded scene \"", id, "\" (", to_string(entry.bytes), " bytes)");
+
+	SceneStore::evict();
+	return true;
+}
+
+uint32_t SceneStore::reloadDependents(string path) {
+	string dir_scene = "scene/";
+	if (path.starts_with(dir_scene) && path.ends_with(".tmx")) {
+		// register new maps
+		string id = path.substr(dir_scene.length(), path.length() - dir_scene.length() - 4);
+		if (SceneStore::scene_paths.find(id) == SceneStore::scene_paths.end()) {
+			SceneStore::scene_paths[id] = path;
+			logger.info("Added scene path with ID \"", id, "\" (", path, ")");
+		}
+	}
+
+	vector<string> dependents;
+	for (const auto& [id, entry]: SceneStore::scenes) {
+		if (entry.scene->dependsOn(path)) {
+			dependents.push_back(id);
+		}
+	}
+	for (const string& id: dependents) {
+		SceneStore::reload(id);
+	}
+	return dependents.size();
+}
+
+shared_ptr<Scene> SceneStore::loadScene(string map_path) {
+	// prefer precompiled blob when available & up to date
+	shared_ptr<Scene> scene = SceneStore::loadBlob(map_path);
+	if (scene == nullptr) {
+		scene = SceneStore::loadMap(map_path);
+		if (scene == nullptr) {
+			return nullptr;
+		}
+	}
+	scene->addDependency(map_path);
+	return scene;
+}
+
+void SceneStore::setStreamed(Scene* scene, unique_ptr<ChunkSource> source) {
+	scene->setChunkSource(move(source));
+	scene->setStreamRadius(GameConfig::getStreamRadius());
+	scene->setPrefetchSteps(GameConfig::getStreamPrefetch());
+}
+
+shared_ptr<Scene> SceneStore::loadBlob(string map_path) {
+	TraceZone zone("SceneStore::loadBlob");
+	string blob_path = SceneBlob::getBlobPath(map_path);
+	VfsFile blob_file = Vfs::read(blob_path);
+	if (!blob_file.ready()) {
+		return nullptr;
+	}
+
+	SceneBlob::Reader blob;
+	string error;
+	VfsStat map_stat;
+	if (!blob.open(blob_file.owner, blob_file.data, blob_file.size, error)) {
+		logger.warn("Cannot use precompiled scene (", error, "), falling back to map: ", blob_path);
 		return nullptr;
 	}
-	map_path = SceneStore::scene_paths[id];
+	if (Vfs::stat(map_path, map_stat) && blob.isStale(map_stat.mtime, map_stat.size)) {
+		logger.warn("Cannot use precompiled scene (stale), falling back to map: ", blob_path);
+		return nullptr;
+	}
+
+	LOG_DEBUG(logger, "Loading precompiled scene: ", blob_path);
+
+	string map_dir = filesystem::path(map_path).parent_path().generic_string();
+	const SceneBlob::Header& header = blob.getHeader();
+	shared_ptr<Scene> scene = make_shared<Scene>(header.width, header.height, header.tile_width,
+			header.tile_height);
+	// tile layers reference blob memory directly
+	scene->setMappedData(blob.getOwner());
+	scene->addDependency(blob_path);
+
+	for (const SceneBlob::TilesetRecord& ts: blob.getTilesets()) {
+		string image_path = Vfs::normalize(Path::join(map_dir, blob.getString(ts.image)));
+		scene->addDependency(image_path);
+		if (blob.isChunked()) {
+			// textures are loaded with chunks that use them
+			scene->addTileset(new Tileset(image_path, ts.first_gid, ts.last_gid));
+			continue;
+		}
+		SDL_Texture* texture = TextureLoader::load(image_path);
+		if (texture == nullptr) {
+			logger.error("Failed to load tileset: ", image_path);
+			continue;
+		}
+		scene->addTileset(new Tileset(texture, ts.first_gid, ts.last_gid));
+	}
+
+	for (const SceneBlob::ImageLayerRecord& i_layer: blob.getImageLayers()) {
+		string layerName = blob.getString(i_layer.name);
+		string texture_path = Vfs::normalize(Path::join(map_dir, blob.getString(i_layer.image)));
+		scene->addDependency(texture_path);
+		ParallaxImage* p_image = new ParallaxImage(TextureLoader::load(texture_path));
+		p_image->setScrollRate(i_layer.scroll_rate);
+
+		if (layerName == "s_background") {
+			scene->setLayerSBackground(p_image);
+		} else if (layerName == "s_background2") {
+			scene->setLayerSBackground2(p_image);
+		} else if (layerName == "weather") {
+			scene->setLayerWeather(p_image);
+		} else {
+			logger.warn("Unknown image layer \"", layerName, "\": ", blob_path);
+			delete p_image;
+		}
+	}
+
+	if (blob.isChunked()) {
+		SceneStore::setStreamed(scene.get(), make_unique<BlobChunkSource>(blob));
+	}
+
+	for (const SceneBlob::TileLayerRecord& t_layer: blob.getTileLayers()) {
+		if (blob.isChunked()) {
+			break;
+		}
+		string layerName = blob.getString(t_layer.name);
+		TileLayer layer(blob.getTiles(t_layer));
+
+		if (layerName == "background") {
+			scene->setLayerBackground(move(layer));
+		} else if (layerName == "terrain") {
+			scene->setLayerTerrain(move(layer));
+		} else if (layerName == "objects") {
+			scene->setLayerObjects(move(layer));
+		} else if (layerName == "collision") {
+			scene->setLayerCollision(move(layer), blob.getCollision());
+		} else if (layerName == "foreground") {
+			scene->setLayerForeground(move(layer));
+		} else {
+			logger.warn("Unknown tile layer \"", layerName, "\": ", blob_path);
+		}
+	}
+
+	for (const SceneBlob::PropertyRecord& prop: blob.getProperties()) {
+		if (prop.type == SceneBlob::PropertyType::STRING && blob.getString(prop.name) == "music") {
+			scene->setMusic(blob.getString(prop.str_value));
+			break;
+		}
+	}
+
+	return scene;
+}
 
+shared_ptr<Scene> SceneStore::loadMap(string map_path) {
+	TraceZone zone("SceneStore::loadMap");
 	tmx::Map map;
-	if (!map.load(map_path)) {
+	bool map_loaded = false;
+	if (Vfs::isArchive()) {
+		// resources referenced by map are resolved relative to a virtual root
+		VfsFile map_file = Vfs::read(map_path);
+		if (map_file.ready()) {
+			string map_data(reinterpret_cast<const char*>(map_file.data), map_file.size);
+			map_loaded = map.loadFromString(map_data, "/" + map_path);
+		}
+	} else {
+		// external tilesets can only be resolved from loose files
+		map_loaded = map.load(Path::join(Vfs::getMountPath(), map_path));
+	}
+	if (!map_loaded) {
 		logger.error("Failed to load scene map: ", map_path);
 		return nullptr;
 	}
 
 	tmx::FloatRect bounds = map.getBounds();
-	Scene* scene = new Scene(bounds.width, bounds.height, map.getTileSize().x, map.getTileSize().y);
+	shared_ptr<Scene> scene = make_shared<Scene>(bounds.width, bounds.height, map.getTileSize().x, map.getTileSize().y);
+
+	// infinite maps are streamed in chunks
+	TmxChunkSource* chunk_source = nullptr;
+	if (map.isInfinite()) {
+		chunk_source = new TmxChunkSource();
+		SceneStore::setStreamed(scene.get(), unique_ptr<ChunkSource>(chunk_source));
+	}
 
 	// parse tilesets
 	for (tmx::Tileset ts: map.getTilesets()) {
-		string image_path = Path::norm(ts.getImagePath());
+		string image_path = Vfs::normalize(ts.getImagePath());
+		scene->addDependency(image_path);
 
-#ifdef RRE_DEBUGGING
-		logger.debug("Loading tileset: ", ts.getName(), " (", image_path, ")");
-#endif
+		if (chunk_source != nullptr) {
+			// textures are loaded with chunks that use them
+			scene->addTileset(new Tileset(image_path, ts.getFirstGID(), ts.getLastGID()));
+			continue;
+		}
+
+		LOG_DEBUG(logger, "Loading tileset: ", ts.getName(), " (", image_path, ")");
 
-		SDL_Texture* texture = TextureLoader::absLoad(image_path);
+		SDL_Texture* texture = TextureLoader::load(image_path);
 		if (texture == nullptr) {
 			logger.error("Failed to load tileset: ", image_path);
 			continue;
@@ -132,7 +558,9 @@ Scene* SceneStore::get(string id) {
 				continue;
 			}
 
-			ParallaxImage* p_image = new ParallaxImage(TextureLoader::absLoad(texture_path));
+			texture_path = Vfs::normalize(texture_path);
+			scene->addDependency(texture_path);
+			ParallaxImage* p_image = new ParallaxImage(TextureLoader::load(texture_path));
 			for (tmx::Property prop: i_layer.getProperties()) {
 				if (prop.getName() == "scroll_rate" && prop.getType() == tmx::Property::Type::Float) {
 					p_image->setScrollRate(prop.getFloatValue());
@@ -151,7 +579,17 @@ Scene* SceneStore::get(string id) {
 				delete p_image;
 			}
 		} else if (layer.getType() == tmx::Layer::Type::Tile) {
-			tmx::TileLayer t_layer = dynamic_cast<const tmx::TileLayer&>(*layerPtr);
+			const tmx::TileLayer& t_layer = layer.getLayerAs<tmx::TileLayer>();
+
+			if (chunk_source != nullptr) {
+				SceneLayer::Id id = SceneChunks::getLayerId(layerName);
+				if (id == SceneLayer::COUNT) {
+					logger.warn("Unknown tile layer \"", layerName, "\": ", map_path);
+				} else {
+					chunk_source->addLayer(id, t_layer);
+				}
+				continue;
+			}
 
 			LayerDefinition ldef;
 			for (tmx::TileLayer::Tile tile: t_layer.getTiles()) {
@@ -159,15 +597,15 @@ Scene* SceneStore::get(string id) {
 			}
 
 			if (layerName == "background") {
-				scene->setLayerBackground(ldef);
+				scene->setLayerBackground(move(ldef));
 			} else if (layerName == "terrain") {
-				scene->setLayerTerrain(ldef);
+				scene->setLayerTerrain(move(ldef));
 			} else if (layerName == "objects") {
-				scene->setLayerObjects(ldef);
+				scene->setLayerObjects(move(ldef));
 			} else if (layerName == "collision") {
-				scene->setLayerCollision(ldef);
+				scene->setLayerCollision(move(ldef));
 			} else if (layerName == "foreground") {
-				scene->setLayerForeground(ldef);
+				scene->setLayerForeground(move(ldef));
 			} else {
 				logger.warn("Unknown tile layer \"", layerName, "\": ", map_path);
 			}
@@ -182,6 +620,43 @@ Scene* SceneStore::get(string id) {
 		}
 	}
 
+	return scene;
+}
+
+bool SceneStore::preload(string id) {
+	if (SceneStore::scene_paths.find(id) == SceneStore::scene_paths.end()) {
+		logger.warn("Scene not found: ", id);
+		return false;
+	}
+	bool result = EntityStore::preload(SceneStore::scene_entities);
+	// map & tileset textures are loaded with scene
+	return SceneStore::get(id) != nullptr && result;
+}
+
+shared_ptr<Scene> SceneStore::get(string id) {
+	// look in cache first
+	auto cached = SceneStore::scenes.find(id);
+	if (cached != SceneStore::scenes.end()) {
+		// mark as most recently used
+		SceneStore::scenes_lru.splice(SceneStore::scenes_lru.begin(), SceneStore::scenes_lru,
+				cached->second.lru_pos);
+		return cached->second.scene;
+	}
+
+	StartupScope scope("scene.get");
+
+	// get map file path
+	if (SceneStore::scene_paths.find(id) == SceneStore::scene_paths.end()) {
+		logger.warn("Scene not found: ", id);
+		return nullptr;
+	}
+	string map_path = SceneStore::scene_paths[id];
+
+	shared_ptr<Scene> scene = SceneStore::loadScene(map_path);
+	if (scene == nullptr) {
+		return nullptr;
+	}
+
 	// DEBUG: test drawing entity in scene
 	uint32_t center_x = NATIVE_RES.first / 2; // - (player->getRect().w / 2);
 	uint32_t center_y = NATIVE_RES.second / 2; // + (player->getRect().h / 2);
@@ -208,6 +683,15 @@ Scene* SceneStore::get(string id) {
 	}
 
 	// cache for subsequent retrieval
-	SceneStore::scenes[id] = scene;
+	size_t bytes = scene->getMemoryUsage();
+	scope.addBytes(bytes);
+	SceneStore::scenes_lru.push_front(id);
+	SceneStore::scenes[id] = {scene, bytes, SceneStore::scenes_lru.begin()};
+	SceneStore::cache_usage += bytes;
+
+	LOG_DEBUG(logger, "Cached scene \"", id, "\" (", to_string(bytes), " bytes, total ",
+			to_string(SceneStore::cache_usage), " bytes)");
+
+	SceneStore::evict();
 	return scene;
 }
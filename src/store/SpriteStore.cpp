@@ -4,94 +4,272 @@
  * See: LICENSE.txt
  */
 
+#include "config.h"
+
+#include <cstdint> // uint64_t
 #include <memory>
+#include <typeinfo>
 #include <unordered_map>
+#include <utility> // std::move
+#include <vector>
 
-#include <pugixml.hpp>
-
+#include "ConfigDocument.hpp"
 #include "Dialog.hpp"
-#include "Filesystem.hpp"
 #include "Logger.hpp"
 #include "Path.hpp"
+#include "TextureLoader.hpp"
+#include "Trace.hpp"
+#include "Vfs.hpp"
 #include "factory/SpriteFactory.hpp"
 #include "store/SpriteStore.hpp"
 
-using namespace pugi;
 using namespace std;
 
 
-static Logger _logger = Logger::getLogger("SpriteStore");
+static Logger& _logger = Logger::getLogger("SpriteStore");
 
-/** Holds loaded sprites in memory indexed by ID/path. */
+/** Configuration of a sprite that can be built on demand. */
+struct SpriteEntry {
+	/** Parsed configuration owning `node` (shared so entries kept on reload stay valid). */
+	shared_ptr<ConfigDocument> doc;
+	/** Configuration element. */
+	ConfigNode node;
+	/** Texture path relative to data directory. */
+	string texture;
+	/** Hash of configuration element used to detect changes. */
+	uint64_t hash;
+	/** Set if sprite could not be built, not retried until configuration is reloaded. */
+	bool failed = false;
+};
+
+/** Configured sprites indexed by ID. */
+static unordered_map<string, SpriteEntry> _index;
+/** Holds built sprites in memory indexed by ID. */
 static unordered_map<string, shared_ptr<Sprite>> _cache;
 
-static void _onConfigError(string title, string msg) {
+/**
+ * Reports a configuration error.
+ *
+ * @param reload
+ *   If `true`, error is only logged so that game isn't interrupted by hot reload.
+ */
+static void _onConfigError(bool reload, string title, string msg) {
 	if (!title.empty()) {
 		_logger.error(title, ": ", msg);
-		Dialog::error(title, msg);
+		if (!reload) {
+			Dialog::error(title, msg);
+		}
 	} else {
 		_logger.error(msg);
-		Dialog::error(msg);
+		if (!reload) {
+			Dialog::error(msg);
+		}
 	}
 }
 
-static void _onConfigError(string msg) {
-	_onConfigError("", msg);
+static void _onConfigError(bool reload, string msg) {
+	_onConfigError(reload, "", msg);
 }
 
-bool SpriteStore::load() {
-	string conf = Path::rabs("data/conf/sprites.xml");
-	if (!Filesystem::fexist(conf)) {
+/**
+ * Builds a configured sprite & adds it to cache.
+ *
+ * @param id
+ *   Sprite identifier.
+ * Called during gameplay so failure is logged without interrupting game.
+ *
+ * @return
+ *   Built sprite or `null` if sprite is not configured or could not be built.
+ */
+static shared_ptr<Sprite> _materialize(string id) {
+	auto entry = _index.find(id);
+	if (entry == _index.end() || entry->second.failed) {
+		return nullptr;
+	}
+
+	shared_ptr<Sprite> sprite_ptr = SpriteFactory::build(entry->second.node);
+	if (!sprite_ptr || !sprite_ptr->ready()) {
+		_logger.error("Failed to load sprite \"", id, "\": conf/sprites.xml");
+		// don't retry until configuration is reloaded
+		entry->second.failed = true;
+		return nullptr;
+	}
+
+	_cache[id] = sprite_ptr;
+	return sprite_ptr;
+}
+
+/**
+ * Parses sprite configuration into index.
+ *
+ * Sprites are built on first retrieval.
+ *
+ * @param reload
+ *   If `true`, cached sprites with changed definitions are rebuilt & updated in place & cached
+ *   sprites no longer configured are removed from cache. Errors are only logged & previous
+ *   configuration is kept for sprites that cannot be rebuilt.
+ * @return
+ *   `true` if loading succeeded without error.
+ */
+static bool _load(bool reload) {
+	TraceZone zone("SpriteStore::load");
+	string conf = "conf/sprites.xml";
+	if (!Vfs::exists(conf)) {
 		_logger.warn("Sprite configuration not found: ", conf);
 		// don't halt execution
 		return true;
 	}
 
-	xml_document doc;
-	if (doc.load_file(conf.c_str()).status != status_ok) {
-		_onConfigError("Failed to load sprite configuration: " + conf);
+	shared_ptr<ConfigDocument> doc = make_shared<ConfigDocument>();
+	string error;
+	if (!doc->load(conf, error)) {
+		_onConfigError(reload, "Failed to load sprite configuration (" + error + "): " + conf);
 		return false;
 	}
 
-	xml_node root = doc.child("sprites");
-	if (root.type() == node_null) {
-		_onConfigError("XML Parsing Error", "Root tag \"sprites\" not found: " + conf);
+	ConfigNode root = doc->child("sprites");
+	if (root.empty()) {
+		_onConfigError(reload, "XML Parsing Error", "Root tag \"sprites\" not found: " + conf);
 		return false;
 	}
 
-	xml_node el = root.child("sprite");
-	while(el.type() != node_null) {
-		xml_attribute attr_id = el.attribute("id");
+	unordered_map<string, SpriteEntry> index;
+	// cached sprites that must be rebuilt
+	vector<string> changed;
+	ConfigNode el = root.child("sprite");
+	while(!el.empty()) {
+		ConfigAttribute attr_id = el.attribute("id");
 		if (attr_id.empty()) {
-			_onConfigError("XML Parsing Error", "Sprite tag without \"id\" attribute: " + conf);
+			_onConfigError(reload, "XML Parsing Error",
+					"Sprite tag without \"id\" attribute: " + conf);
 			return false;
 		}
 		string id = attr_id.value();
-		shared_ptr<Sprite> sprite_ptr = SpriteFactory::build(el);
+		uint64_t hash = el.hash();
+		if (reload && _cache.find(id) != _cache.end()) {
+			auto prev = _index.find(id);
+			if (prev == _index.end() || prev->second.hash != hash) {
+				changed.push_back(id);
+			}
+		}
+		index[id] = {doc, el, Vfs::normalize(Path::join("sprite", el.child("filename").text())),
+				hash};
+
+		el = el.nextSibling("sprite");
+	}
+
+	bool result = true;
+	for (const string& id: changed) {
+		shared_ptr<Sprite> cached = _cache[id];
+		shared_ptr<Sprite> sprite_ptr = SpriteFactory::build(index[id].node);
 		if (!sprite_ptr || !sprite_ptr->ready()) {
-			_onConfigError("Failed to load sprite \"" + id + "\": " + conf);
-			return false;
+			_logger.error("Failed to reload sprite \"", id, "\", keeping previous data: ", conf);
+			// previous entry keeps its document referenced
+			auto prev = _index.find(id);
+			if (prev != _index.end()) {
+				index[id] = prev->second;
+			}
+			result = false;
+			continue;
 		}
-		// add to cache
-		_cache[id] = sprite_ptr;
 
-		el = el.next_sibling("sprite");
+		if (typeid(*cached.get()) == typeid(*sprite_ptr.get())) {
+			// update in place so that entities referencing sprite use new data
+			cached->swap(*sprite_ptr.get());
+		} else {
+			_logger.warn("Sprite \"", id, "\" changed type, only new references are updated");
+			_cache[id] = sprite_ptr;
+		}
+		_logger.info("Reloaded sprite: ", id);
 	}
 
-	return true;
+	if (reload) {
+		for (auto iter = _cache.begin(); iter != _cache.end();) {
+			if (index.find(iter->first) != index.end()) {
+				iter++;
+				continue;
+			}
+			// existing references keep sprite alive
+			_logger.info("Removed sprite no longer configured: ", iter->first);
+			iter = _cache.erase(iter);
+		}
+	}
+
+	_index = move(index);
+
+	if (!reload) {
+		LOG_DEBUG(_logger, "Indexed ", to_string(_index.size()), " sprites");
+	}
+
+	return result;
+}
+
+bool SpriteStore::load() {
+	return _load(false);
+}
+
+bool SpriteStore::reload() {
+	return _load(true);
+}
+
+bool SpriteStore::reloadTexture(string path) {
+	bool found = false;
+	// sprites not built yet load new image when built
+	for (const auto& [id, sprite]: _cache) {
+		auto entry = _index.find(id);
+		if (entry == _index.end()) {
+			continue;
+		}
+		const string& texture_path = entry->second.texture;
+		// sprite textures are configured without extension
+		if (texture_path != path && texture_path + ".png" != path) {
+			continue;
+		}
+		SDL_Texture* texture = TextureLoader::load(texture_path);
+		if (texture == nullptr) {
+			_logger.error("Failed to reload texture of sprite \"", id, "\": ", path);
+			continue;
+		}
+		sprite->replaceTexture(texture);
+		found = true;
+
+		_logger.info("Reloaded texture of sprite \"", id, "\": ", path);
+	}
+	return found;
 }
 
 shared_ptr<Sprite> SpriteStore::get(string id) {
-	shared_ptr<Sprite> sprite;
 	// check cache first
-	if (_cache.find(id) != _cache.end()) {
-		sprite = _cache[id];
-		if (!sprite->ready()) {
+	auto cached = _cache.find(id);
+	if (cached != _cache.end()) {
+		if (!cached->second->ready()) {
 			_logger.warn("Returning uninitialized sprite: ", id);
 		}
-	} else {
-		// if not cached an uninitialized sprite is returned
+		return cached->second;
+	}
+
+	auto entry = _index.find(id);
+	if (entry == _index.end()) {
+		// if not configured an uninitialized sprite is returned
 		_logger.warn("Sprite not available: ", id);
+		return nullptr;
+	}
+	if (entry->second.failed) {
+		// already reported
+		return nullptr;
+	}
+	return _materialize(id);
+}
+
+uint32_t SpriteStore::getLoadedCount() {
+	return _cache.size();
+}
+
+MemoryUsage SpriteStore::getMemoryUsage() {
+	MemoryUsage usage;
+	for (const auto& [id, sprite]: _cache) {
+		usage.bytes += sprite->getByteSize();
 	}
-	return sprite;
+	usage.count = _cache.size();
+	return usage;
 }
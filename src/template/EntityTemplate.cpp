@@ -11,7 +11,7 @@
 using namespace std;
 
 
-Logger EntityTemplate::logger = Logger::getLogger("EntityTemplate");
+Logger& EntityTemplate::logger = Logger::getLogger("EntityTemplate");
 
 EntityTemplate::EntityTemplate() {
 	sprite = nullptr;
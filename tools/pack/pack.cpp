@@ -0,0 +1,65 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ *
+ * Offline packer converting the game data directory to a single archive.
+ */
+
+#include "config.h"
+
+#include <iostream>
+#include <string>
+
+#include "cxxopts.hpp"
+
+#include "Archive.hpp"
+
+using namespace std;
+
+
+int main(int argc, char** argv) {
+	cxxopts::Options options("rre-pack", "R&R Engine data archive packer");
+	options.add_options()
+		("h,help", "Show this help information.")
+		("v,version", "Show version information")
+		("o,output", "Output archive.", cxxopts::value<string>()->default_value("data.pak"))
+		("n,no-compress", "Store all files uncompressed.")
+		("input", "Game data directory.", cxxopts::value<string>())
+	;
+	options.parse_positional({"input"});
+	options.positional_help("<data_dir>");
+
+	cxxopts::ParseResult args;
+	try {
+		args = options.parse(argc, argv);
+	} catch (cxxopts::exceptions::parsing& e) {
+		cerr << "ERROR: " << e.what() << endl;
+		return 1;
+	}
+
+	if (args.count("help")) {
+		cout << options.help() << endl;
+		return 0;
+	}
+	if (args.count("version")) {
+		cout << "rre-pack version " << RRE_VERSION << " (archive format " << Archive::VERSION << ")"
+				<< endl;
+		return 0;
+	}
+	if (!args.count("input")) {
+		cerr << "ERROR: no input directory" << endl;
+		cout << options.help() << endl;
+		return 1;
+	}
+
+	string input = args["input"].as<string>();
+	string output = args["output"].as<string>();
+	string error;
+	if (!Archive::pack(input, output, args.count("no-compress") == 0, error)) {
+		cerr << "ERROR: " << error << endl;
+		return 1;
+	}
+	cout << "packed: " << output << endl;
+	return 0;
+}
@@ -0,0 +1,111 @@
+/* Copyright © 2025 Jordan Irwin <antumdeluge@gmail.com>
+ *
+ * This work is licensed under the terms of the MIT license.
+ * See: LICENSE.txt
+ *
+ * Offline compiler converting TMX scene maps to precompiled binary blobs.
+ */
+
+#include "config.h"
+
+#include <cstdint> // uint32_t
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cxxopts.hpp"
+
+#include "SceneBlob.hpp"
+
+using namespace std;
+
+
+/**
+ * Compiles a single map.
+ *
+ * @param tmx_path
+ *   Path to source map.
+ * @param chunk_size
+ *   Chunk size in tiles or 0 to only chunk infinite maps.
+ * @param force
+ *   Compile even if existing blob is up to date.
+ * @return
+ *   `true` if blob is up to date after compiling.
+ */
+static bool compileMap(const string& tmx_path, uint32_t chunk_size, bool force) {
+	string blob_path = SceneBlob::getBlobPath(tmx_path);
+	string error;
+	if (!force && filesystem::is_regular_file(blob_path)) {
+		SceneBlob::Reader existing;
+		// blob must also match requested chunking
+		if (existing.open(blob_path, tmx_path, error)
+				&& (chunk_size == 0 || existing.getHeader().chunk_width == chunk_size)) {
+			cout << "up to date: " << blob_path << endl;
+			return true;
+		}
+	}
+
+	if (!SceneBlob::compile(tmx_path, blob_path, chunk_size, error)) {
+		cerr << "ERROR: " << tmx_path << ": " << error << endl;
+		return false;
+	}
+	cout << "compiled: " << blob_path << endl;
+	return true;
+}
+
+int main(int argc, char** argv) {
+	cxxopts::Options options("rre-scenec", "R&R Engine scene compiler");
+	options.add_options()
+		("h,help", "Show this help information.")
+		("v,version", "Show version information")
+		("f,force", "Recompile maps with up to date blobs.")
+		("c,chunk-size", "Split tile layers into chunks of this many tiles for streaming (infinite maps are always chunked).",
+				cxxopts::value<uint32_t>()->default_value("0"))
+		("input", "TMX map files or directories containing maps.", cxxopts::value<vector<string>>())
+	;
+	options.parse_positional({"input"});
+	options.positional_help("<map.tmx|dir>...");
+
+	cxxopts::ParseResult args;
+	try {
+		args = options.parse(argc, argv);
+	} catch (cxxopts::exceptions::parsing& e) {
+		cerr << "ERROR: " << e.what() << endl;
+		return 1;
+	}
+
+	if (args.count("help")) {
+		cout << options.help() << endl;
+		return 0;
+	}
+	if (args.count("version")) {
+		cout << "rre-scenec version " << RRE_VERSION << " (scene format " << SceneBlob::VERSION << ")"
+				<< endl;
+		return 0;
+	}
+	if (!args.count("input")) {
+		cerr << "ERROR: no input files" << endl;
+		cout << options.help() << endl;
+		return 1;
+	}
+
+	bool force = args.count("force") > 0;
+	uint32_t chunk_size = args["chunk-size"].as<uint32_t>();
+	int failed = 0;
+	for (const string& input: args["input"].as<vector<string>>()) {
+		if (filesystem::is_directory(input)) {
+			for (const filesystem::directory_entry& item:
+					filesystem::recursive_directory_iterator(input)) {
+				string p = item.path().string();
+				if (item.is_regular_file() && p.ends_with(".tmx") && !compileMap(p, chunk_size, force)) {
+					failed++;
+				}
+			}
+		} else if (!compileMap(input, chunk_size, force)) {
+			failed++;
+		}
+	}
+
+	return failed > 0 ? 1 : 0;
+}